@@ -22,7 +22,202 @@
 ui512D			SEGMENT			"CONST" ALIGN (64)					; Declare a data segment. Read only. Aligned 64.
 
 				MemConstants
+				ALIGN			64
+one512			QWORD			7 DUP (0), 1						; the value one, as 8 QWORDS (used to convert out of Montgomery form)
+zero512			QWORD			8 DUP (0)							; the value zero, as 8 QWORDS (saturating subtract fill)
+qrev			QWORD			7, 6, 5, 4, 3, 2, 1, 0				; VPERMQ indexes reversing qword order (little endian byte order for pack_u_n)
+cmp_truth		BYTE			2, 1, 3, 0, 5, 6, 4, 7				; cmp_u_n truth tables by predicate: bit 0 less, bit 1 equal, bit 2 greater
 
+				ALIGN			64
+;			ilog table for base 10, laid out as ilog_setup_u builds one: base, count, guesses by msb, then 10^0 .. 10^154
+ilog10_tab		QWORD			10, 155, 6 DUP (0)
+				WORD			0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 3, 4, 4
+				WORD			4, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9
+				WORD			9, 9, 10, 10, 10, 11, 11, 11, 12, 12, 12, 12, 13, 13, 13, 14
+				WORD			14, 14, 15, 15, 15, 15, 16, 16, 16, 17, 17, 17, 18, 18, 18, 18
+				WORD			19, 19, 19, 20, 20, 20, 21, 21, 21, 21, 22, 22, 22, 23, 23, 23
+				WORD			24, 24, 24, 24, 25, 25, 25, 26, 26, 26, 27, 27, 27, 27, 28, 28
+				WORD			28, 29, 29, 29, 30, 30, 30, 31, 31, 31, 31, 32, 32, 32, 33, 33
+				WORD			33, 34, 34, 34, 34, 35, 35, 35, 36, 36, 36, 37, 37, 37, 37, 38
+				WORD			38, 38, 39, 39, 39, 40, 40, 40, 40, 41, 41, 41, 42, 42, 42, 43
+				WORD			43, 43, 43, 44, 44, 44, 45, 45, 45, 46, 46, 46, 46, 47, 47, 47
+				WORD			48, 48, 48, 49, 49, 49, 49, 50, 50, 50, 51, 51, 51, 52, 52, 52
+				WORD			52, 53, 53, 53, 54, 54, 54, 55, 55, 55, 55, 56, 56, 56, 57, 57
+				WORD			57, 58, 58, 58, 59, 59, 59, 59, 60, 60, 60, 61, 61, 61, 62, 62
+				WORD			62, 62, 63, 63, 63, 64, 64, 64, 65, 65, 65, 65, 66, 66, 66, 67
+				WORD			67, 67, 68, 68, 68, 68, 69, 69, 69, 70, 70, 70, 71, 71, 71, 71
+				WORD			72, 72, 72, 73, 73, 73, 74, 74, 74, 74, 75, 75, 75, 76, 76, 76
+				WORD			77, 77, 77, 77, 78, 78, 78, 79, 79, 79, 80, 80, 80, 80, 81, 81
+				WORD			81, 82, 82, 82, 83, 83, 83, 83, 84, 84, 84, 85, 85, 85, 86, 86
+				WORD			86, 86, 87, 87, 87, 88, 88, 88, 89, 89, 89, 90, 90, 90, 90, 91
+				WORD			91, 91, 92, 92, 92, 93, 93, 93, 93, 94, 94, 94, 95, 95, 95, 96
+				WORD			96, 96, 96, 97, 97, 97, 98, 98, 98, 99, 99, 99, 99, 100, 100, 100
+				WORD			101, 101, 101, 102, 102, 102, 102, 103, 103, 103, 104, 104, 104, 105, 105, 105
+				WORD			105, 106, 106, 106, 107, 107, 107, 108, 108, 108, 108, 109, 109, 109, 110, 110
+				WORD			110, 111, 111, 111, 111, 112, 112, 112, 113, 113, 113, 114, 114, 114, 114, 115
+				WORD			115, 115, 116, 116, 116, 117, 117, 117, 118, 118, 118, 118, 119, 119, 119, 120
+				WORD			120, 120, 121, 121, 121, 121, 122, 122, 122, 123, 123, 123, 124, 124, 124, 124
+				WORD			125, 125, 125, 126, 126, 126, 127, 127, 127, 127, 128, 128, 128, 129, 129, 129
+				WORD			130, 130, 130, 130, 131, 131, 131, 132, 132, 132, 133, 133, 133, 133, 134, 134
+				WORD			134, 135, 135, 135, 136, 136, 136, 136, 137, 137, 137, 138, 138, 138, 139, 139
+				WORD			139, 139, 140, 140, 140, 141, 141, 141, 142, 142, 142, 142, 143, 143, 143, 144
+				WORD			144, 144, 145, 145, 145, 145, 146, 146, 146, 147, 147, 147, 148, 148, 148, 149
+				WORD			149, 149, 149, 150, 150, 150, 151, 151, 151, 152, 152, 152, 152, 153, 153, 153
+				QWORD			0, 0, 0, 0, 0, 0, 0, 1h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 0Ah
+				QWORD			0, 0, 0, 0, 0, 0, 0, 64h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 3E8h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 2710h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 186A0h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 0F4240h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 989680h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 5F5E100h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 3B9ACA00h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 2540BE400h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 174876E800h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 0E8D4A51000h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 9184E72A000h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 5AF3107A4000h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 38D7EA4C68000h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 2386F26FC10000h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 16345785D8A0000h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 0DE0B6B3A7640000h
+				QWORD			0, 0, 0, 0, 0, 0, 0, 8AC7230489E80000h
+				QWORD			0, 0, 0, 0, 0, 0, 5h, 6BC75E2D63100000h
+				QWORD			0, 0, 0, 0, 0, 0, 36h, 35C9ADC5DEA00000h
+				QWORD			0, 0, 0, 0, 0, 0, 21Eh, 19E0C9BAB2400000h
+				QWORD			0, 0, 0, 0, 0, 0, 152Dh, 2C7E14AF6800000h
+				QWORD			0, 0, 0, 0, 0, 0, 0D3C2h, 1BCECCEDA1000000h
+				QWORD			0, 0, 0, 0, 0, 0, 84595h, 161401484A000000h
+				QWORD			0, 0, 0, 0, 0, 0, 52B7D2h, 0DCC80CD2E4000000h
+				QWORD			0, 0, 0, 0, 0, 0, 33B2E3Ch, 9FD0803CE8000000h
+				QWORD			0, 0, 0, 0, 0, 0, 204FCE5Eh, 3E25026110000000h
+				QWORD			0, 0, 0, 0, 0, 0, 1431E0FAEh, 6D7217CAA0000000h
+				QWORD			0, 0, 0, 0, 0, 0, 0C9F2C9CD0h, 4674EDEA40000000h
+				QWORD			0, 0, 0, 0, 0, 0, 7E37BE2022h, 0C0914B2680000000h
+				QWORD			0, 0, 0, 0, 0, 0, 4EE2D6D415Bh, 85ACEF8100000000h
+				QWORD			0, 0, 0, 0, 0, 0, 314DC6448D93h, 38C15B0A00000000h
+				QWORD			0, 0, 0, 0, 0, 0, 1ED09BEAD87C0h, 378D8E6400000000h
+				QWORD			0, 0, 0, 0, 0, 0, 13426172C74D82h, 2B878FE800000000h
+				QWORD			0, 0, 0, 0, 0, 0, 0C097CE7BC90715h, 0B34B9F1000000000h
+				QWORD			0, 0, 0, 0, 0, 0, 785EE10D5DA46D9h, 0F436A000000000h
+				QWORD			0, 0, 0, 0, 0, 0, 4B3B4CA85A86C47Ah, 98A224000000000h
+				QWORD			0, 0, 0, 0, 0, 2h, 0F050FE938943ACC4h, 5F65568000000000h
+				QWORD			0, 0, 0, 0, 0, 1Dh, 6329F1C35CA4BFABh, 0B9F5610000000000h
+				QWORD			0, 0, 0, 0, 0, 125h, 0DFA371A19E6F7CB5h, 4395CA0000000000h
+				QWORD			0, 0, 0, 0, 0, 0B7Ah, 0BC627050305ADF14h, 0A3D9E40000000000h
+				QWORD			0, 0, 0, 0, 0, 72CBh, 5BD86321E38CB6CEh, 6682E80000000000h
+				QWORD			0, 0, 0, 0, 0, 47BF1h, 9673DF52E37F2410h, 11D100000000000h
+				QWORD			0, 0, 0, 0, 0, 2CD76Fh, 0E086B93CE2F768A0h, 0B22A00000000000h
+				QWORD			0, 0, 0, 0, 0, 1C06A5Eh, 0C5433C60DDAA1640h, 6F5A400000000000h
+				QWORD			0, 0, 0, 0, 0, 118427B3h, 0B4A05BC8A8A4DE84h, 5986800000000000h
+				QWORD			0, 0, 0, 0, 0, 0AF298D05h, 0E4395D69670B12Bh, 7F41000000000000h
+				QWORD			0, 0, 0, 0, 0, 6D79F8232h, 8EA3DA61E066EBB2h, 0F88A000000000000h
+				QWORD			0, 0, 0, 0, 0, 446C3B15F9h, 926687D2C40534FDh, 0B564000000000000h
+				QWORD			0, 0, 0, 0, 0, 2AC3A4EDBBFh, 0B8014E3BA83411E9h, 15E8000000000000h
+				QWORD			0, 0, 0, 0, 0, 1ABA4714957Dh, 300D0E549208B31Ah, 0DB10000000000000h
+				QWORD			0, 0, 0, 0, 0, 10B46C6CDD6E3h, 0E0828F4DB456FF0Ch, 8EA0000000000000h
+				QWORD			0, 0, 0, 0, 0, 0A70C3C40A64E6h, 0C51999090B65F67Dh, 9240000000000000h
+				QWORD			0, 0, 0, 0, 0, 6867A5A867F103h, 0B2FFFA5A71FBA0E7h, 0B680000000000000h
+				QWORD			0, 0, 0, 0, 0, 4140C78940F6A24h, 0FDFFC78873D4490Dh, 2100000000000000h
+				QWORD			0, 0, 0, 0, 0, 28C87CB5C89A2571h, 0EBFDCB54864ADA83h, 4A00000000000000h
+				QWORD			0, 0, 0, 0, 1h, 97D4DF19D6057673h, 37E9F14D3EEC8920h, 0E400000000000000h
+				QWORD			0, 0, 0, 0, 0Fh, 0EE50B7025C36A080h, 2F236D04753D5B48h, 0E800000000000000h
+				QWORD			0, 0, 0, 0, 9Fh, 4F2726179A224501h, 0D762422C946590D9h, 1000000000000000h
+				QWORD			0, 0, 0, 0, 639h, 17877CEC0556B212h, 69D695BDCBF7A87Ah, 0A000000000000000h
+				QWORD			0, 0, 0, 0, 3E3Ah, 0EB4AE1383562F4B8h, 2261D969F7AC94CAh, 4000000000000000h
+				QWORD			0, 0, 0, 0, 26E4Dh, 30ECCC3215DD8F31h, 57D27E23ACBDCFE6h, 8000000000000000h
+				QWORD			0, 0, 0, 0, 184F03h, 0E93FF9F4DAA797EDh, 6E38ED64BF6A1F01h, 0
+				QWORD			0, 0, 0, 0, 0F31627h, 1C7FC3908A8BEF46h, 4E3945EF7A25360Ah, 0
+				QWORD			0, 0, 0, 0, 97EDD87h, 1CFDA3A5697758BFh, 0E3CBB5AC5741C64h, 0
+				QWORD			0, 0, 0, 0, 5EF4A747h, 21E864761EA97776h, 8E5F518BB6891BE8h, 0
+				QWORD			0, 0, 0, 0, 3B58E88C7h, 5313EC9D329EAAA1h, 8FB92F75215B1710h, 0
+				QWORD			0, 0, 0, 0, 25179157C9h, 3EC73E23FA32AA4Fh, 9D3BDA934D8EE6A0h, 0
+				QWORD			0, 0, 0, 0, 172EBAD6DDCh, 73C86D67C5FAA71Ch, 245689C107950240h, 0
+				QWORD			0, 0, 0, 0, 0E7D34C64A9Ch, 85D4460DBBCA8719h, 6B61618A4BD21680h, 0
+				QWORD			0, 0, 0, 0, 90E40FBEEA1Dh, 3A4ABC8955E946FEh, 31CDCF66F634E100h, 0
+				QWORD			0, 0, 0, 0, 5A8E89D752524h, 46EB5D5D5B1CC5EDh, 0F20A1A059E10CA00h, 0
+				QWORD			0, 0, 0, 0, 3899162693736Ah, 0C531A5A58F1FBB4Bh, 746504382CA7E400h, 0
+				QWORD			0, 0, 0, 0, 235FADD81C2822Bh, 0B3F07877973D50F2h, 8BF22A31BE8EE800h, 0
+				QWORD			0, 0, 0, 0, 161BCCA7119915B5h, 764B4ABE8652979h, 7775A5F171951000h, 0
+				QWORD			0, 0, 0, 0, 0DD15FE86AFFAD912h, 49EF0EB713F39EBEh, 0AA987B6E6FD2A000h, 0
+				QWORD			0, 0, 0, 8h, 0A2DBF142DFCC7AB6h, 0E3569326C7843372h, 0A9F4D2505E3A4000h, 0
+				QWORD			0, 0, 0, 56h, 5C976C9CBDFCCB24h, 0E161BF83CB2A027Ah, 0A3903723AE468000h, 0
+				QWORD			0, 0, 0, 35Fh, 9DEA3E1F6BDFEF70h, 0CDD17B25EFA418CAh, 63A22764CEC10000h, 0
+				QWORD			0, 0, 0, 21BCh, 2B266D3A36BF5A68h, 0A2ECF7B5C68F7E7h, 0E45589F0138A0000h, 0
+				QWORD			0, 0, 0, 15159h, 0AF80444623798810h, 65D41AD19C19AF0Eh, 0EB576360C3640000h, 0
+				QWORD			0, 0, 0, 0D2D80h, 0DB02AABD62BF50A3h, 0FA490C301900D695h, 3169E1C7A1E80000h, 0
+				QWORD			0, 0, 0, 83C708h, 8E1AAB65DB792667h, 0C6DA79E0FA0861D3h, 0EE22D1CC53100000h, 0
+				QWORD			0, 0, 0, 525C655h, 8D0AB1FA92BB800Dh, 0C488C2C9C453D247h, 4D5C31FB3EA00000h, 0
+				QWORD			0, 0, 0, 3379BF57h, 826AF3C9BB530089h, 0AD579BE1AB4636C9h, 599F3D072400000h, 0
+				QWORD			0, 0, 0, 202C1796Bh, 182D85E1513E0560h, 0C56C16D0B0BE23DAh, 3803862476800000h, 0
+				QWORD			0, 0, 0, 141B8EBE2Eh, 0F1C73ACD2C6C35C7h, 0B638E426E76D6686h, 30233D6CA1000000h, 0
+				QWORD			0, 0, 0, 0C913936DD5h, 71C84C03BC3A19CDh, 1E38E9850A46013Dh, 0E160663E4A000000h, 0
+				QWORD			0, 0, 0, 7DAC3C24A56h, 71D2F8255A450203h, 2E391F3266BC0C6Ah, 0CDC3FE6EE4000000h, 0
+				QWORD			0, 0, 0, 4E8BA596E760h, 723DB17586B2141Fh, 0CE3B37F803587C2Ch, 9A7F054E8000000h, 0
+				QWORD			0, 0, 0, 3117477E509C4h, 7668EE9742F4C93Eh, 0E502FB02174D9B8h, 608F635110000000h, 0
+				QWORD			0, 0, 0, 1EAE8CAEF261ACh, 0A01951E89D8FDC6Ch, 8F21DCE14E908133h, 0C599E12AA0000000h, 0
+				QWORD			0, 0, 0, 132D17ED577D0BEh, 40FD3316279E9C3Dh, 9752A0CD11A50C05h, 0B802CBAA40000000h, 0
+				QWORD			0, 0, 0, 0BFC2EF456AE276Eh, 89E3FEDD8C321A67h, 0E93A4802B0727839h, 301BF4A680000000h, 0
+				QWORD			0, 0, 0, 77D9D58B62CD8A51h, 62E7F4A779F5080Fh, 1C46D01AE478B23Bh, 0E1178E8100000000h, 0
+				QWORD			0, 0, 4h, 0AE825771DC07672Dh, 0DD0F8E8AC3925097h, 1AC4210CECB6F656h, 0CAEB910A00000000h, 0
+				QWORD			0, 0, 2Eh, 0D1176A72984A07CAh, 0A29B916BA3B725E7h, 0BA94A813F259F63h, 0ED33AA6400000000h, 0
+				QWORD			0, 0, 1D4h, 2AEA2879F2E44DEAh, 5A13AE3465277B06h, 749CE90C777839E7h, 4404A7E800000000h, 0
+				QWORD			0, 0, 1249h, 0AD2594C37CEB0B27h, 84C4CE0BF38ACE40h, 8E211A7CAAB24308h, 0A82E8F1000000000h, 0
+				QWORD			0, 0, 0B6E0h, 0C377CFA2E12E6F8Bh, 2FB00C77836C0E85h, 8D4B08DEAAF69E56h, 91D196A000000000h, 0
+				QWORD			0, 0, 724C7h, 0A2AE1C5CCBD05B6Fh, 0DCE07CAB22389137h, 84EE58B2ADA22F61h, 0B22FE24000000000h, 0
+				QWORD			0, 0, 476FCCh, 5ACD1B9FF623925Eh, 0A0C4DEAF5635AC2Bh, 314F76FAC855D9D0h, 0F5DED68000000000h, 0
+				QWORD			0, 0, 2CA5DFBh, 8C03143F9D63B7B2h, 47B0B2D95E18B9AFh, 0ED1AA5CBD35A8229h, 9AB4610000000000h, 0
+				QWORD			0, 0, 1BE7ABD3h, 781ECA7C25E52CF6h, 0CCE6FC7DACF740DFh, 430A79F6418915A0h, 0B0BCA0000000000h, 0
+				QWORD			0, 0, 1170CB642h, 0B133E8D97AF3C1A4h, 105DCE8C1A888B8h, 9E68C39E8F5AD840h, 6E75E40000000000h, 0
+				QWORD			0, 0, 0AE67F1E9Ah, 0EC07187ECD859068h, 0A3AA11790955736h, 3017A431998C7284h, 509AE80000000000h, 0
+				QWORD			0, 0, 6D00F7320Dh, 3846F4F40737A410h, 664A4AEBA5D5681Dh, 0E0EC69EFFF7C792Bh, 260D100000000000h, 0
+				QWORD			0, 0, 44209A7F484h, 32C59188482C68A3h, 0FEE6ED347A56112Ah, 0C93C235FFADCBBAFh, 7C82A00000000000h, 0
+				QWORD			0, 0, 2A94608F8D29h, 0FBB7AF52D1BC1667h, 0F505440CC75CABABh, 0DC5961BFCC9F54DAh, 0DD1A400000000000h, 0
+				QWORD			0, 0, 1A9CBC59B83A3h, 0D52CD93C3158E00Fh, 9234A87FC99EB4B6h, 9B7DD17DFE39508Ch, 0A306800000000000h, 0
+				QWORD			0, 0, 10A1F5B8132466h, 53C07C59ED78C09Bh, 0B60E94FDE0330F22h, 12EA2EEBEE3D257Eh, 5E41000000000000h, 0
+				QWORD			0, 0, 0A6539930BF6BFFh, 4584DB8346B78615h, 1C91D1EAC1FE9754h, 0BD25D5374E6376EFh, 0AE8A000000000000h, 0
+				QWORD			0, 0, 67F43FBE77A37F8h, 0B7309320C32B3CD3h, 1DB2332B93F1E94Fh, 637A54290FE2A55Ch, 0D164000000000000h, 0
+				QWORD			0, 0, 40F8A7D70AC62FB7h, 27E5BF479FB0603Fh, 28F5FFB3C7731D19h, 0E2C7499A9EDA75A0h, 2DE8000000000000h, 0
+				QWORD			0, 2h, 89B68E666BBDDD27h, 8EF978CC3CE3C277h, 999BFD05CA7F2302h, 0DBC8E00A34889841h, 0CB10000000000000h, 0
+				QWORD			0, 19h, 61219000356AA38Bh, 95BEB7FA60E598ACh, 17E239E8F75E1Ch, 95D8C0660D55F291h, 0EEA0000000000000h, 0
+				QWORD			0, 0FDh, 0CB4FA002162A6373h, 0D9732FC7C8F7F6B8h, 0EED64319A9AD1Dh, 0DA7783FC855B79B3h, 5240000000000000h, 0
+				QWORD			0, 9E9h, 0F11C4014DDA7E286h, 7E7FDDCDD9AFA330h, 9545E9F00A0C32Ah, 88AB27DD3592C101h, 3680000000000000h, 0
+				QWORD			0, 6323h, 6B1A80D0A88ED940h, 0F0FEAA0A80DC5FE0h, 5D4BB23606479FA9h, 56AF8EA417BB8A0Ch, 2100000000000000h, 0
+				QWORD			0, 3DF62h, 2F09082695947C89h, 69F2A469089BBEC3h, 0A4F4F61C3ECC3C9Dh, 62DB9268ED536479h, 4A00000000000000h, 0
+				QWORD			0, 26B9D5h, 0D65A5181D7CCDD5Eh, 237A6C1A561573A4h, 71919D1A73FA5E25h, 0DC93B8194541ECBCh, 0E400000000000000h, 0
+				QWORD			0, 183425Ah, 5F872F126E00A5ADh, 62C839075CD6846Ch, 6FB0230887C7AD7Ah, 9DC530FCB4933F60h, 0E800000000000000h, 0
+				QWORD			0, 0F209787h, 0BB47D6B84C0678C5h, 0DBD23A49A0612C3Ch, 5CE15E554DCCC6CAh, 29B3E9DF0DC079C9h, 1000000000000000h, 0
+				QWORD			0, 9745EB4Dh, 50CE6332F840B7BAh, 963646E043CBBA5Bh, 0A0CDAF5509FFC3E5h, 0A10722B68984C1DAh, 0A000000000000000h, 0
+				QWORD			0, 5E8BB3105h, 280FDFFDB2872D49h, 0DE1EC4C2A5F54794h, 4808D95263FDA6F8h, 4A475B215F2F928Ah, 4000000000000000h, 0
+				QWORD			0, 3B174FEA33h, 909EBFE8F947C4E2h, 0AD33AF9A7B94CBCAh, 0D0587D37E7E885B2h, 0E6C98F4DB7DBB966h, 8000000000000000h, 0
+				QWORD			0, 24EE91F2603h, 0A6337F19BCCDB0DAh, 0C404DC08D3CFF5ECh, 2374E42F0F1538FDh, 3DF99092E953E01h, 0, 0
+				QWORD			0, 17151B377C24h, 7E02F7016008E88Bh, 0A8309858461F9B39h, 6290E9D696D439E2h, 26BBFA5BD1D46C0Ah, 0, 0
+				QWORD			0, 0E6D3102AD96Ch, 0EC1DA60DC0591574h, 91E5F372BD3C103Dh, 0D9A92261E44A42D5h, 8357C796324C3864h, 0, 0
+				QWORD			0, 9043EA1AC7E41h, 39287C89837AD68Dh, 0B2FB827B6458A26Ah, 809B57D2EAE69C57h, 216DCBDDF6FA33E8h, 0, 0
+				QWORD			0, 5A2A7250BCEE8Ch, 3B94DD5F22CC6188h, 0FDD318D1EB765829h, 6116E3D2D021B67h, 4E49F6ABA5C60710h, 0, 0
+				QWORD			0, 385A8772761517Ah, 53D0A5B75BFBCF59h, 0EA3EF833329F719Ah, 3CAE4E63C2151209h, 0EE3A2B479BC46A0h, 0, 0
+				QWORD			0, 233894A789CD2EC7h, 4626792997D61983h, 2675B1FFFA3A7006h, 5ECF0FE594D2B45Ah, 94E45B0CC15AC240h, 0, 0
+				QWORD			1h, 6035CE8B6203D3C8h, 0BD80BB9FEE5CFF1Fh, 8098F3FFC648603Fh, 0B4169EF7D03B0B89h, 0D0EB8E7F8D8B9680h, 0, 0
+				QWORD			0Dh, 0C21A1171D42645D7h, 6707543F4FA1F73Bh, 5F987FDBED3C27Dh, 8E235AE224E7362h, 293390FB8773E100h, 0, 0
+				QWORD			89h, 9504AE72497EBA6Ah, 6494A791C53A84Eh, 3BBF4FE9744598E2h, 58D618CD571081D5h, 9C03A9D34A86CA00h, 0, 0
+				QWORD			55Fh, 0D22ED076DEF34824h, 3EDCE8BB1B44930Eh, 55791F1E8AB7F8D7h, 785CF80566A51258h, 1824A240E943E400h, 0, 0
+				QWORD			35BEh, 35D424A4B580D16Ah, 74A1174F10ADBE8Fh, 56BB37316B2FB86Ah, 0B3A1B0360272B770h, 0F16E56891CA6E800h, 0, 0
+				QWORD			2196Eh, 1A496E6F17082E28h, 8E4AE916A6C97199h, 635027EE2FDD342Bh, 450E21C187B2A69h, 6E4F615B1E851000h, 0, 0
+				QWORD			14FE4Dh, 6DE5056E651CD95h, 8EED1AE283DE6FFDh, 0E1218F4DDEA409AEh, 2B28D518F4CFA81Eh, 4F19CD8F3132A000h, 0, 0
+				QWORD			0D1EF02h, 44AF2364FF3207D7h, 95430CD926B05FEAh, 0CB4F990AB26860CDh, 0AF9852F9901C912Fh, 17020797EBFA4000h, 0, 0
+				QWORD			8335616h, 0AED761F1F7F44E6Bh, 0D49E807B82E3BF2Bh, 0F11BFA6AF813C808h, 0DBF33DBFA11DABD6h, 0E6144BEF37C68000h, 0, 0
+				QWORD			52015CE2h, 0D469D373AF8B1036h, 4E3104D31CE577B7h, 6B17C82DB0C5D058h, 9780697C4B28B664h, 0FCCAF7582DC10000h, 0, 0
+				QWORD			3340DA0DCh, 4C224284DB6EA21Fh, 0DEA303F20F6AD2Ah, 2EEDD1C8E7BA2375h, 0EB041EDAEF971FF1h, 0DFEDA971C98A0000h, 0, 0
+				QWORD			200888489Ah, 0F956993092525536h, 8B25E27749A2C3A5h, 0D54A31D90D45629Bh, 2E29348D5BE73F72h, 0BF489E71DF640000h, 0, 0
+				QWORD			1405552D60Dh, 0BD61FBE5B7375421h, 6F7AD8A8E05BA47Ah, 54E5F27A84B5DA0Fh, 0CD9C0D8597087A7Bh, 78D63072B9E80000h, 0, 0
+				QWORD			0C83553C5C89h, 65D3D6F92829494Eh, 5ACC7698C3946CC7h, 50FB78C92F1A849Eh, 8188737E654C8D2h, 0B85DE47B43100000h, 0, 0
+				QWORD			7D21545B9D5Dh, 0FA4665BB919CDD0Fh, 8BFCA1F7A3CC3FC9h, 29D2B7DBD7092E2Ch, 50F5482EFF4FD83Bh, 33AAECD09EA00000h, 0, 0
+				QWORD			4E34D4B9425ABh, 0C6BFF953B020A29Bh, 77DE53AC65FA7DDBh, 0A23B2E96665BCDBBh, 2994D1D5F91E7250h, 4AD402632400000h, 0, 0
+				QWORD			30E104F3C978B5h, 0C37FBD44E1465A12h, 0AEAF44BBFBC8EA94h, 564FD1DFFF96094Fh, 9FD0325BBB307720h, 2EC4817DF6800000h, 0, 0
+				QWORD			1E8CA3185DEB719h, 0A2FD64B0CCBF84BAh, 0D2D8AF57D5D929CBh, 5F1E32BFFBDC5D1Ch, 3E21F7954FE4A741h, 0D3AD0EEBA1000000h, 0, 0
+				QWORD			1317E5EF3AB32700h, 5DE5EEE7FF7B2F4Ch, 3C76D96E5A7BA1F1h, 0B72DFB7FD69BA31Ah, 6D53ABD51EEE8892h, 44C295344A000000h, 0, 0
+				QWORD			0BEEEFB584AFF8603h, 0AAFB550FFACFD8FAh, 5CA47E4F88D45371h, 27CBD2FE62145F08h, 4544B653355155B6h, 0AF99D40AE4000000h, 0, 0
 ; end of memory resident constants
 ui512D			ENDS												; end of data segment
 
@@ -35,25 +230,26 @@ ui512D			ENDS												; end of data segment
 ;			multiplicand	-	Address of 8 QWORDS multiplicand (in R8)
 ;			multiplier		-	Address of 8 QWORDS multiplier (in R9)
 ;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			If either operand is four qwords or fewer, the shorter is the multiplier of mult_uT64, mult_uT128 or mult_uT256 (no loop).
 ;
 		
 				Other_Entry		mult_u, ui512
-mult_u			PROC			PUBLIC
+mult_u			PROC			PUBLIC FRAME
 				LOCAL			padding1 [ 8 ] : QWORD
 				LOCAL			product [ 16 ] : QWORD
 				LOCAL			savedRBP : QWORD
-				LOCAL			savedRCX : QWORD, savedRDX : QWORD, savedR10 : QWORD, savedR11 : QWORD, savedR12 : QWORD
+				LOCAL			savedRCX : QWORD, savedRDX : QWORD, savedR10 : QWORD, savedR11 : QWORD
 				LOCAL			plierl : WORD						; low limit index of of multiplier (7 - first non-zero)
 				LOCAL			candl : WORD						; low limit index of multiplicand
 				LOCAL			padding2 [ 16 ] : QWORD
 mult_u_ofs		EQU				padding2 + 64 - padding1			; offset is the size of the local memory declarations
 
-				CreateFrame		220h, savedRBP
+				CreateFrame		220h, savedRBP, < R12 >
 				MOV				savedRCX, RCX
 				MOV				savedRDX, RDX
 				MOV				savedR10, R10
 				MOV				savedR11, R11
-				MOV				savedR12, R12
 
 ; Check passed parameters alignment, since this is checked within frame, need to specify exit / cleanup / unwrap label
 				CheckAlign		RCX, @@exit							; (out) Product
@@ -63,7 +259,11 @@ mult_u_ofs		EQU				padding2 + 64 - padding1			; offset is the size of the local
 
 ; Examine multiplicand, save dimensions, handle edge cases of zero or one
 				MOV				RCX, R8								; examine multiplicand
+	IF		__UseZ
+				CALL			msb_uZ								; get count to most significant bit (-1 if no bits), branch free
+	ELSE
 				CALL			msb_u								; get count to most significant bit (-1 if no bits)
+	ENDIF
 				CMP				AX, 0								
 				JL				@@zeroandexit						; msb < 0? multiplicand = 0; exit with product = 0
 				LEA				RDX, [ R9 ]							; multiplicand = 1?	exit with product = multiplier -> address of multiplier (to be copied to product)
@@ -75,7 +275,11 @@ mult_u_ofs		EQU				padding2 + 64 - padding1			; offset is the size of the local
 
 ; Examine multiplier, save dimensions, handle edge cases of zero or one
 				MOV				RCX, R9								; examine multiplier
+	IF		__UseZ
+				CALL			msb_uZ								; get count to most significant bit (-1 if no bits), branch free
+	ELSE
 				CALL			msb_u								; get count to most significant bit (-1 if no bits)
+	ENDIF
 				CMP				AX, 0								; multiplier = 0? exit with product = 0
 				JL				@@zeroandexit
 				LEA				RDX, [ R8 ]							; multiplier = 1? exit with product = multiplicand -> address of multiplicand (to be copied to product)
@@ -85,6 +289,22 @@ mult_u_ofs		EQU				padding2 + 64 - padding1			; offset is the size of the local
 				SUB				CX, AX								; subtract from 7 to get starting (high order, left-most) beginning index
 				MOV				plierl, CX							; save off multiplier index lower limit (eliminate multiplying leading zero words)
 
+; Short operands: put the shorter in the multiplier (the product commutes); up to four qwords go to the fixed length, unrolled kernels
+				CMP				CX, candl
+				JGE				@F									; multiplier no longer than multiplicand
+				XCHG			R8, R9
+				MOV				AX, candl
+				MOV				candl, CX
+				MOV				plierl, AX
+				MOV				CX, AX
+@@:
+				CMP				CX, 7
+				JE				@@byT64
+				CMP				CX, 6
+				JE				@@byT128
+				CMP				CX, 4
+				JGE				@@byT256
+
 ; In frame / stack reserved memory, clear 16 qword area for working version of overflow/product; set up indexes for loop
 				LEA				RCX, product [ 0 ]
 				Zero512			RCX									; clear working copy of overflow, need to start as zero, results are accumulated
@@ -128,9 +348,8 @@ mult_u_ofs		EQU				padding2 + 64 - padding1			; offset is the size of the local
 @@exit:			
 				MOV				R10, savedR10
 				MOV				R11, savedR11
-				MOV				R12, savedR12						; restore any non-volitile regs used
-				ReleaseFrame	savedRBP
 				XOR				RAX, RAX							; return zero
+				ReleaseFrame
 				RET
 
 ; zero callers product and overflow
@@ -148,6 +367,48 @@ mult_u_ofs		EQU				padding2 + 64 - padding1			; offset is the size of the local
 				MOV				RCX, savedRCX						; copy (whichever: multiplier or multiplicand) to callers product
 				Copy512			RCX, RDX							; RDX "passed" here from whomever jumped here (either &multiplier, or &multiplicand in RDX)
 				JMP				@@exit								; and exit
+
+; multiplier of one qword: mult_uT64 to the last qword of the overflow, zero the rest
+@@byT64:
+				MOV				RCX, savedRCX
+				MOV				RDX, savedRDX
+				ADD				RDX, 7 * 8
+				MOV				R9, Q_PTR [ R9 ] [ 7 * 8 ]
+				CALL			mult_uT64
+				MOV				RCX, savedRDX
+				XOR				EAX, EAX
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6 >
+				MOV				Q_PTR [ RCX ] [ idx * 8 ], RAX
+				ENDM
+				JMP				@@exit
+
+; multiplier of two qwords: mult_uT128 to the last two qwords of the overflow, zero the rest
+@@byT128:
+				MOV				RCX, savedRCX
+				MOV				RDX, savedRDX
+				ADD				RDX, 6 * 8
+				ADD				R9, 6 * 8
+				CALL			mult_uT128
+				MOV				RCX, savedRDX
+				XOR				EAX, EAX
+				FOR				idx, < 0, 1, 2, 3, 4, 5 >
+				MOV				Q_PTR [ RCX ] [ idx * 8 ], RAX
+				ENDM
+				JMP				@@exit
+
+; multiplier of three or four qwords: mult_uT256 to the last four qwords of the overflow, zero the rest
+@@byT256:
+				MOV				RCX, savedRCX
+				MOV				RDX, savedRDX
+				ADD				RDX, 4 * 8
+				ADD				R9, 4 * 8
+				CALL			mult_uT256
+				MOV				RCX, savedRDX
+				XOR				EAX, EAX
+				FOR				idx, < 0, 1, 2, 3 >
+				MOV				Q_PTR [ RCX ] [ idx * 8 ], RAX
+				ENDM
+				JMP				@@exit
 				
 mult_u			ENDP				
 				Other_Exit		mult_u, ui512
@@ -163,7 +424,10 @@ mult_u			ENDP
 ;			multiplier		-	multiplier QWORD (in R9)
 ;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
 				Other_Entry		mult_uT64, ui512
-mult_uT64		PROC			PUBLIC
+mult_uT64		PROC			PUBLIC FRAME
+				SUB				RSP, 8 * 8							; room for a copy of the multiplicand (a fixed allocation, so stack walks can find the caller)
+				.ALLOCSTACK		8 * 8
+				.ENDPROLOG
 
 ; Check passed parameters alignment, since this is checked within frame, need to specify exit / cleanup / unwrap label
 				CheckAlign		RCX, @@exit							; (out) Product
@@ -171,7 +435,8 @@ mult_uT64		PROC			PUBLIC
 
 ; caller might be doing multiply 'in-place', so need to save the original multiplicand, prior to clearing callers product (A = A * x), or (A *= x)
 				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
-				PUSH			Q_PTR [ R8 ] [ idx * 8 ]
+				MOV				RAX, Q_PTR [ R8 ] [ idx * 8 ]
+				MOV				Q_PTR [ RSP ] [ idx * 8 ], RAX
 				ENDM
 
 ; clear callers product and overflow
@@ -182,21 +447,22 @@ mult_uT64		PROC			PUBLIC
 				MOV				Q_PTR [ RDX ], RAX					; clear callers overflow
  				MOV				R10, RDX							; RDX (pointer to callers overflow) gets used in the MUL: save it in R10
 
-; FOR EACH index of 7 thru 1 (omiting 0): fetch (pop) qword of multiplicand, multiply, add 128 bit result (RAX, RDX) to running working product
+; FOR EACH index of 7 thru 1 (omiting 0): fetch saved qword of multiplicand, multiply, add 128 bit result (RAX, RDX) to running working product
 				FOR				idx, < 7, 6, 5, 4, 3, 2, 1 >		; Note: this is not a 'real' for, this is a macro that generates an unwound loop
-				POP				RAX									; multiplicand [ idx ] qword -> RAX
+				MOV				RAX, Q_PTR [ RSP ] [ idx * 8 ]		; multiplicand [ idx ] qword -> RAX
 				MUL				R9									; times multiplier -> RAX, RDX
 				ADD				Q_PTR [ RCX ] [ idx * 8 ], RAX		; add RAX to working product [ idx ] qword
 				ADC				Q_PTR [ RCX ] [ (idx - 1) * 8 ], RDX	; and add RDX with carry to [ idx - 1 ] qword of working product
 				ENDM
 
 ; Most significant (idx=0), the high order result of the multiply in RDX, goes to the overflow of the caller
-				POP				RAX
+				MOV				RAX, Q_PTR [ RSP ] [ 0 * 8 ]
 				MUL				R9
 				ADD				Q_PTR [ RCX ] [ 0 * 8 ], RAX
 				ADC				Q_PTR [ R10 ], RDX					; last qword overflow is also the operation overflow
 				XOR				RAX, RAX							; return zero
 @@exit:
+				ADD				RSP, 8 * 8
 				RET
 				
 mult_uT64		ENDP
@@ -212,37 +478,54 @@ mult_uT64		ENDP
 ;			dividend		-	Address of 8 QWORDS dividend (in R8)
 ;			divisor			-	Address of 8 QWORDs divisor (in R9)
 ;			returns			-	0 for success, -1 for attempt to divide by zero, (GP_Fault) for mis-aligned parameter address
+;
+;			div_u and div_round_u are entries to div_core_u, which takes a rounding mode in the home slot of R9 (rnd_floor from div_u),
+;			and a null remainder address when no remainder is wanted.
 
 				Other_Entry		div_u, ui512
 div_u			PROC			PUBLIC
+				MOV				Q_PTR [ RSP ] [ 4 * 8 ], rnd_floor	; mode, in the home slot of R9: truncate
+				JMP				div_core_u
+div_u			ENDP
+				Other_Exit		div_u, ui512
+
+				Other_Entry		div_core_u, ui512
+div_core_u		PROC			PRIVATE FRAME
 				LOCAL			padding1 [ 16 ] : QWORD
 				LOCAL			currnumerator [ 16 ] : QWORD
 				LOCAL			qdiv [ 16 ] : QWORD, quotient [ 8 ] : QWORD, normdivisor [ 8 ] : QWORD
 				LOCAL			savedRCX : QWORD, savedRDX : QWORD, savedR8 : QWORD, savedR9 : QWORD
-				LOCAL			savedR10 : QWORD, savedR11 : QWORD, savedR12 : QWORD, savedRBP : QWORD
+				LOCAL			savedR10 : QWORD, savedR11 : QWORD, savedRBP : QWORD
+				LOCAL			rmode : QWORD, rem64 : QWORD
 				LOCAL			qHat : QWORD, rHat : QWORD,	nDiv : QWORD
 				LOCAL			sublen: QWORD, addbackRDX : QWORD, addbackR11 : QWORD
 				LOCAL			normf : WORD, jIdx : WORD, mIdx : WORD, nIdx : WORD, mDim : WORD, nDim : Word	
 				LOCAL			padding2 [ 16 ] : QWORD
 div_oset		EQU				padding2 + 64 - padding1
+div_mode		EQU				8 + 4 * 8							; rounding mode, in the home slot of R9, as offset from saved RBP
 
-				CreateFrame		360h, savedRBP
+				CreateFrame		360h, savedRBP, < R12 >
 				MOV				savedRCX, RCX
 				MOV				savedRDX, RDX
 				MOV				savedR8, R8
 				MOV				savedR9, R9
 				MOV				savedR10, R10
 				MOV				savedR11, R11
-				MOV				savedR12, R12
+				MOV				RAX, savedRBP
+				MOV				RAX, Q_PTR [ RAX ] [ div_mode ]
+				MOV				rmode, RAX
 
 				CheckAlign		RCX, cleanupwretcode				; (out) Quotient
-				CheckAlign		RDX, cleanupwretcode				; (out) Remainder
+				CheckAlign		RDX, cleanupwretcode				; (out) Remainder, or null
 				CheckAlign		R8, cleanupwretcode					; (in) Dividend
 				CheckAlign		R9, cleanupwretcode					; (in) Divisor
 
 ; Initialize
 				Zero512			RCX									; zero callers quotient
+				TEST			RDX, RDX
+				JZ				@F
 				Zero512			RDX									; zero callers remainder
+@@:
 				LEA				RCX, quotient
 				Zero512			RCX									; zero working quotient
 
@@ -255,17 +538,48 @@ div_oset		EQU				padding2 + 64 - padding1
 				CMP				AX, 64								; divisor only one 64-bit word?
 				JGE				mbynDiv								; no, do divide of m digit by n digit
 
-;	divide of m 64-bit qwords by one 64 bit qword divisor, use the quicker divide routine (div_uT64), and return
+;	divide of m 64-bit qwords by one 64 bit qword divisor, use the quicker divide routine (div_uT64), round from its remainder, and return
 				MOV				RCX, savedRCX						; set up parms for call to div by 64bit: RCX - addr of quotient
 				MOV				RDX, savedRDX						; RDX - addr of remainder
+				TEST			RDX, RDX
+				JNZ				@F
+				LEA				RDX, rem64							; no remainder wanted: div_uT64 still stores its one qword
+@@:
 				MOV				R8, savedR8							; R8 - addr of dividend
 				MOV				RAX, savedR9
 				MOV				R9, Q_PTR [ RAX ] [ 7 * 8 ]			; R9 - value of 64 bit divisor
 				CALL			div_uT64
+				MOV				RCX, rem64
 				MOV				RDX, savedRDX						; move 64 bit remainder to last word of 8 word remainder
+				TEST			RDX, RDX
+				JZ				@F
 				MOV				RCX, Q_PTR [ RDX ]					; get the one qword remainder
 				Zero512			RDX									; clear the 8 qword callers remainder
 				MOV				Q_PTR [ RDX ] [ 7 * 8 ], RCX		; put the one qword remainder in the least significant qword of the callers remainder
+@@:
+				MOV				RAX, rmode							; round: remainder r in RCX
+				CMP				RAX, rnd_floor
+				JE				cleanupret
+				TEST			RCX, RCX
+				JZ				cleanupret							; exact: no rounding in any mode
+				MOV				R8, savedRCX						; callers quotient
+				CMP				RAX, rnd_ceil
+				JE				Round64Up
+				MOV				RDX, savedR9
+				MOV				RDX, Q_PTR [ RDX ] [ 7 * 8 ]
+				SUB				RDX, RCX							; divisor - r
+				CMP				RCX, RDX
+				JA				Round64Up
+				JB				cleanupret
+				CMP				RAX, rnd_half_up
+				JE				Round64Up
+				TEST			B_PTR [ R8 ] [ 7 * 8 ], 1			; half even: up only from an odd quotient
+				JZ				cleanupret
+Round64Up:
+				ADD				Q_PTR [ R8 ] [ 7 * 8 ], 1			; cannot carry out: a divisor of 2 or more leaves room, and one leaves no remainder
+				FOR				idx, < 6, 5, 4, 3, 2, 1, 0 >
+				ADC				Q_PTR [ R8 ] [ idx * 8 ], 0
+				ENDM
 				JMP				cleanupret
 
 ;
@@ -387,8 +701,14 @@ D4:
 				MOV				addbackRDX, RDX
 				MOV			    addbackR11, RCX
 
-; Call subtraction subroutine
-				CALL    @sub
+; Subtract n digits at [RCX] from [RDX], count of digits in R8 (in line, RSP does not change within the frame, see CreateFrame)
+				CLC
+@@:				TEST			R8, R8
+				JZ				D5
+				MOV				RAX, Q_PTR [ RCX ] [ R8 * 8 ]
+				SBB				Q_PTR [ RDX ] [ R8 * 8 ], RAX
+				DEC				R8
+				JMP				@B
 
 ; Step D5: Test remainder
 D5:
@@ -403,8 +723,13 @@ D6:
 				MOV				R8, sublen
 				MOV				RCX, addbackR11
 				MOV				RDX, addbackRDX
-				CALL			@addback
-				JMP				 D7
+				CLC													; add (back) n digits at [RCX] to [RDX], count of digits in R8
+@@:				TEST			R8, R8
+				JZ				D7
+				MOV				RAX, Q_PTR [ RCX ] [ R8 * 8 ]
+				ADC				Q_PTR [ RDX ] [ R8 * 8 ], RAX
+				DEC				R8
+				JMP				@B
 
 ; Step D7: Loop on j
 D7:
@@ -412,27 +737,67 @@ D7:
 				CMP				jIdx, 8								; done?
 				JLE				D3									; no, loop to D3
 
+; Rounding, decided on the remainder r as it stands, still normalized (currnumerator [ 8 .. 15 ]), against the normalized divisor d:
+;	both carry the same 2^normf, so r against d - r decides as it would unshifted. Exact (r zero) never rounds. The quotient is still the working copy.
+D8Round:
+				MOV				RAX, rmode
+				CMP				RAX, rnd_floor
+				JE				D8UnNormalize
+				LEA				RDX, currnumerator [ 8 * 8 ]
+				MOV				RCX, Q_PTR [ RDX ]
+				FOR				idx, < 1, 2, 3, 4, 5, 6, 7 >
+				OR				RCX, Q_PTR [ RDX ] [ idx * 8 ]
+				ENDM
+				JZ				D8UnNormalize						; exact
+				CMP				RAX, rnd_ceil
+				JE				D8Up
+				LEA				R8, normdivisor
+				LEA				R9, qdiv [ 8 * 8 ]					; d - r, in the (free) multiply work area
+				CLC
+				FOR				idx, < 7, 6, 5, 4, 3, 2, 1, 0 >
+				MOV				RCX, Q_PTR [ R8 ] [ idx * 8 ]
+				SBB				RCX, Q_PTR [ RDX ] [ idx * 8 ]
+				MOV				Q_PTR [ R9 ] [ idx * 8 ], RCX
+				ENDM
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >		; r against d - r, most significant first
+				MOV				RCX, Q_PTR [ RDX ] [ idx * 8 ]
+				CMP				RCX, Q_PTR [ R9 ] [ idx * 8 ]
+				JA				D8Up
+				JB				D8UnNormalize
+				ENDM
+				CMP				RAX, rnd_half_up					; a tie
+				JE				D8Up
+				TEST			B_PTR quotient [ 7 * 8 ], 1			; half even: up only from an odd quotient
+				JZ				D8UnNormalize
+D8Up:
+				ADD				quotient [ 7 * 8 ], 1				; cannot carry out (as above)
+				FOR				idx, < 6, 5, 4, 3, 2, 1, 0 >
+				ADC				quotient [ idx * 8 ], 0
+				ENDM
+
 ; Step D8: Un Normalize:
 D8UnNormalize:
 				MOV				RCX, savedRDX						; reduced working numerator is now the remainder
+				TEST			RCX, RCX
+				JZ				D8Quotient							; no remainder wanted
 				LEA				RDX, currnumerator [ 8 * 8 ]		; shifted result to callers remainder
 				MOV				R8W, normf
 				CALL			shr_u
 				;
+D8Quotient:
 				MOV				RCX, savedRCX						; copy working quotient to callers quotient
 				LEA				RDX, quotient
 				Copy512			RCX, RDX
 cleanupret:
 				XOR				RAX, RAX							; return zero
 cleanupwretcode:
-				MOV				R12, savedR12
 				MOV				R11, savedR11
 				MOV				R10, savedR10
 				MOV				R9,  savedR9
 				MOV				R8,  savedR8
 				MOV				RDX, savedRDX
 				MOV				RCX, savedRCX						; restore parameter registers back to "as-called" values
-				ReleaseFrame	savedRBP
+				ReleaseFrame
 				RET
 divbyzero:
 				LEA				EAX, [ retcode_neg_one ]
@@ -443,35 +808,22 @@ divbyone:
 				MOV				R8,  savedR8						; callers dividend
 				Copy512			RCX, R8								; copy dividend to quotient
 				MOV				RDX, savedRDX						; callers remainder	
+				TEST			RDX, RDX
+				JZ				cleanupret
 				Zero512			RDX									; remainder is zero
 				JMP				cleanupret
 
-numtoremain:	MOV				R8, savedR8							; callers dividend
+numtoremain:	CMP				rmode, rnd_floor
+				JNE				D8Round								; quotient zero, remainder the dividend (normalized, no bits lost): round from it
+				MOV				R8, savedR8							; callers dividend
 				MOV				RDX, savedRDX						; callers remainder
+				TEST			RDX, RDX
+				JZ				cleanupret
 				Copy512			RDX, R8
 				JMP				cleanupret
-; subroutine (called) to subtract n digits at [RCX] from [RDX] count of digits in R8
-@sub:			CLC
-@@:				TEST			R8,  R8
-				JZ				@e1
-				MOV				RAX, Q_PTR [ RCX ] [ R8 * 8 ]
-				SBB				Q_PTR [ RDX ] [ R8 * 8 ], RAX
-				DEC				R8
-				JMP				@B
-@e1:			RET
-
-; subroutine (called) to add (back) n digits at [RCX] to [RDX] count of digits in R8
-@addback:		CLC
-@@:				TEST			R8, R8
-				JZ				@e2
-				MOV				RAX, Q_PTR [ RCX ] [ R8 * 8 ]
-				ADC				Q_PTR [ RDX ] [ R8 * 8 ], RAX
-				DEC				R8
-				JMP				@B
-@e2:			RET
 
-div_u			ENDP
-				Other_Exit		div_u, ui512
+div_core_u		ENDP
+				Other_Exit		div_core_u, ui512
 
 
 ;
@@ -524,4 +876,4582 @@ div_uT64		PROC			PUBLIC
 div_uT64		ENDP
 				Other_Exit		div_uT64, ui512
 
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_setup_u:PROC			; s16 mont_setup_u( u64* ctx, u64* modulus)
+;			mont_setup_u	-	prepare a Montgomery context for the supplied (odd) modulus N, with R = 2^512
+;			Prototype:		-	s16 mont_setup_u( u64* ctx, u64* modulus);
+;			ctx				-	Address of 32 QWORDS to receive the context: N, R mod N, R^2 mod N, N', shape (in RCX)
+;			modulus			-	Address of 8 QWORDS modulus, must be odd and greater than one (in RDX)
+;			returns			-	0 for success, -1 for an even (or zero, or one) modulus, (GP_Fault) for mis-aligned parameter address
+;
+;			Context layout (offsets in ui512mdMacros.inc):
+;				mctx_modulus	8 QWORDS	N
+;				mctx_rmodn		8 QWORDS	R mod N (also the Montgomery form of one)
+;				mctx_r2modn		8 QWORDS	R^2 mod N (used to convert into Montgomery form)
+;				mctx_nprime		QWORD		N' = -N^-1 mod 2^64
+;				mctx_shape		QWORD		non-zero qwords of N (mask), and mshape_nprime1, mshape_sparse: see mont_mul_u
+;
+				Other_Entry		mont_setup_u, ui512
+mont_setup_u	PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			work [ 8 ] : QWORD, quot [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		200h, savedRBP
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+
+				CheckAlign		RCX, @@exit							; (out) Context
+				CheckAlign		RDX, @@exit							; (in) Modulus
+
+; Modulus must be odd (Montgomery needs N relatively prime to R), and greater than one
+				TEST			B_PTR [ RDX ] [ 7 * 8 ], 1			; least significant bit of least significant qword
+				JZ				@@badmod
+				MOV				RCX, RDX
+				MOV				EDX, 1
+				CALL			compare_uT64
+				CMP				AX, 0
+				JLE				@@badmod
+
+; Copy modulus into context
+				MOV				RCX, savedRCX
+				MOV				RDX, savedRDX
+				Copy512			RCX, RDX
+
+; Shape, for mont_mul_u to choose its reduction: a mask of the non-zero qwords of N (bit j for qword j, low order first),
+;	plus mshape_nprime1 when the low qword is all ones (N' = 1), and mshape_sparse when at least half the qwords are zero
+				XOR				R8D, R8D
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				CMP				Q_PTR [ RDX ] [ idx * 8 ], 1		; carry set for a zero qword
+				CMC
+				ADC				R8D, R8D							; shift in, most significant qword first
+				ENDM
+				POPCNT			R9D, R8D							; non-zero qwords
+				MOV				EAX, R8D
+				OR				EAX, mshape_sparse
+				CMP				R9D, 4
+				CMOVBE			R8D, EAX
+				MOV				EAX, R8D
+				OR				EAX, mshape_nprime1
+				CMP				Q_PTR [ RDX ] [ 7 * 8 ], -1
+				CMOVE			R8D, EAX
+				MOV				Q_PTR [ RCX ] [ mctx_shape ], R8
+
+; N' = -N^-1 mod 2^64. Newton iteration x = x * ( 2 - n0 * x ) on the least significant qword n0.
+;	Any odd n0 is its own inverse to 3 bits, each step doubles the bits of precision: 3, 6, 12, 24, 48, 96
+				MOV				R8, Q_PTR [ RDX ] [ 7 * 8 ]			; n0
+				MOV				RAX, R8								; x, correct to 3 bits
+				REPEAT			5
+				MOV				R9, R8
+				IMUL			R9, RAX								; n0 * x
+				NEG				R9
+				ADD				R9, 2								; 2 - n0 * x
+				IMUL			RAX, R9								; x = x * ( 2 - n0 * x )
+				ENDM
+				NEG				RAX
+				MOV				Q_PTR [ RCX ] [ mctx_nprime ], RAX
+
+; R mod N = ( 2^512 - N ) mod N. 2^512 - N is the two's complement of N, then one divide
+				CLC
+				FOR				idx, < 7, 6, 5, 4, 3, 2, 1, 0 >
+				MOV				RAX, 0								; (MOV, not XOR, to preserve the borrow)
+				SBB				RAX, Q_PTR [ RDX ] [ idx * 8 ]
+				MOV				work [ idx * 8 ], RAX
+				ENDM
+				LEA				RCX, quot
+				MOV				RDX, savedRCX
+				LEA				RDX, [ RDX ] [ mctx_rmodn ]			; remainder goes directly to context
+				LEA				R8, work
+				MOV				R9, savedRDX
+				CALL			div_u
+
+; R^2 mod N. Double R mod N once (giving R * 2^1), then square it nine times with Montgomery multiply:
+;	mont_mul( R * 2^k, R * 2^k ) = R * 2^2k, so 2^1 -> 2^2 -> 2^4 ... -> 2^512, leaving R * R mod N
+				LEA				RCX, work
+				MOV				RDX, savedRCX
+				LEA				RDX, [ RDX ] [ mctx_rmodn ]
+				Copy512			RCX, RDX
+				LEA				RCX, work
+				LEA				RDX, work
+				LEA				R8, work
+				CALL			add_u								; double it
+				TEST			AX, AX
+				JNZ				@F									; carry out? definitely greater than N, subtract
+				LEA				RCX, work
+				MOV				RDX, savedRDX
+				CALL			compare_u
+				CMP				AX, 0
+				JL				@@square							; less than N? no subtract needed
+@@:
+				LEA				RCX, work
+				LEA				RDX, work
+				MOV				R8, savedRDX
+				CALL			sub_u
+@@square:
+				REPEAT			9
+				LEA				RCX, work
+				LEA				RDX, work
+				LEA				R8, work
+				MOV				R9, savedRCX
+				CALL			mont_mul_u
+				ENDM
+				MOV				RCX, savedRCX
+				LEA				RCX, [ RCX ] [ mctx_r2modn ]
+				LEA				RDX, work
+				Copy512			RCX, RDX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+@@badmod:
+				LEA				EAX, [ retcode_neg_one ]
+				JMP				@@exit
+
+mont_setup_u	ENDP
+				Other_Exit		mont_setup_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_mul_u:PROC				; s16 mont_mul_u( u64* result, u64* lh_op, u64* rh_op, u64* ctx)
+;			mont_mul_u		-	Montgomery multiply: result = lh_op * rh_op * R^-1 mod N (R = 2^512, N the modulus in ctx)
+;			Prototype:		-	s16 mont_mul_u( u64* result, u64* lh_op, u64* rh_op, u64* ctx);
+;			result			-	Address of 8 QWORDS to store resulting product (in RCX)
+;			lh_op			-	Address of 8 QWORDS left hand operand, Montgomery form, less than N (in RDX)
+;			rh_op			-	Address of 8 QWORDS right hand operand, Montgomery form, less than N (in R8)
+;			ctx				-	Address of Montgomery context from mont_setup_u (in R9)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			CIOS (coarsely integrated operand scanning) method. Ref: Koc, Acar, Kaliski, "Analyzing and Comparing
+;			Montgomery Multiplication Algorithms", IEEE Micro, 1996. Result may be the same variable as either operand.
+;			Note: the working accumulator 'tw' is least significant qword first (tw [ 0 ] is low order), the reverse of the ui512 layout
+;
+				Other_Entry		mont_mul_u, ui512
+mont_mul_u		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			dw [ 8 ] : QWORD					; accumulator less modulus (low order first, as tw)
+				LOCAL			tw [ 10 ] : QWORD					; working accumulator
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		200h, savedRBP, < RBX, R12, R13, R14 >
+				MOV				savedRCX, RCX
+
+				CheckAlign		RCX, @@exit							; (out) Result
+				CheckAlign		RDX, @@exit							; (in) LH Op
+				CheckAlign		R8, @@exit							; (in) RH Op
+
+				MOV				R10, RDX							; lh_op (RDX is needed by MUL)
+				XOR				EAX, EAX
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 >
+				MOV				tw [ idx * 8 ], RAX
+				ENDM
+				XOR				R14, R14							; i: index to rh_op qwords, low order first
+
+; Outer loop, for each qword of rh_op: accumulate lh_op * rh_op [ i ], then reduce by one qword
+@@outer:
+				MOV				RAX, 7
+				SUB				RAX, R14
+				MOV				R11, Q_PTR [ R8 ] [ RAX * 8 ]		; rh_op qword [ i ]
+				XOR				RBX, RBX							; carry qword
+				XOR				R12, R12							; j: index to lh_op qwords, low order first
+@@mulloop:
+				MOV				RCX, 7
+				SUB				RCX, R12
+				MOV				RAX, Q_PTR [ R10 ] [ RCX * 8 ]		; lh_op qword [ j ]
+				MUL				R11									; times rh_op qword [ i ]
+				ADD				RAX, tw [ R12 * 8 ]					; plus accumulator [ j ]
+				ADC				RDX, 0
+				ADD				RAX, RBX							; plus carry from previous qword
+				ADC				RDX, 0
+				MOV				tw [ R12 * 8 ], RAX
+				MOV				RBX, RDX							; high order becomes the carry
+				INC				R12
+				CMP				R12, 8
+				JL				@@mulloop
+				XOR				EAX, EAX
+				ADD				tw [ 8 * 8 ], RBX
+				ADC				RAX, 0
+				MOV				tw [ 9 * 8 ], RAX
+
+; Reduce: m = tw [ 0 ] * N' mod 2^64, then tw = ( tw + m * N ) / 2^64 (low qword becomes zero, shifted out)
+;	The context shape (from mont_setup_u) picks the kernel. N' = 1: m is tw [ 0 ], and m * n0 + tw [ 0 ] = m * 2^64, so the
+;	carry into qword 1 is m itself, no multiply needed. Sparse N: zero qwords of N only pass the carry along, no multiply
+				MOV				R13, tw [ 0 * 8 ]
+				MOV				R11, Q_PTR [ R9 ] [ mctx_shape ]
+				TEST			R11D, mshape_nprime1
+				JNZ				@@nprime1
+				IMUL			R13, Q_PTR [ R9 ] [ mctx_nprime ]	; m
+				MOV				RAX, R13
+				MUL				Q_PTR [ R9 ] [ mctx_modulus + 7 * 8 ]	; m * n0
+				ADD				RAX, tw [ 0 * 8 ]					; (low order result is zero by construction)
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				JMP				@@reduce
+@@nprime1:
+				MOV				RBX, R13							; m * ( 2^64 - 1 ) + m = m * 2^64
+@@reduce:
+				MOV				R12, 1
+				TEST			R11D, mshape_sparse
+				JNZ				@@sparse
+@@redloop:
+				MOV				RCX, 7
+				SUB				RCX, R12
+				MOV				RAX, R13
+				MUL				Q_PTR [ R9 ] [ RCX * 8 ]			; m * modulus qword [ j ]
+				ADD				RAX, tw [ R12 * 8 ]
+				ADC				RDX, 0
+				ADD				RAX, RBX
+				ADC				RDX, 0
+				MOV				tw [ R12 * 8 - 8 ], RAX				; store one qword lower (the divide by 2^64)
+				MOV				RBX, RDX
+				INC				R12
+				CMP				R12, 8
+				JL				@@redloop
+				JMP				@@reduced
+@@sparse:
+				BT				R11D, R12D							; modulus qword [ j ] non-zero?
+				JNC				@@zeroq
+				MOV				RCX, 7
+				SUB				RCX, R12
+				MOV				RAX, R13
+				MUL				Q_PTR [ R9 ] [ RCX * 8 ]
+				ADD				RAX, tw [ R12 * 8 ]
+				ADC				RDX, 0
+				ADD				RAX, RBX
+				ADC				RDX, 0
+				MOV				tw [ R12 * 8 - 8 ], RAX
+				MOV				RBX, RDX
+				JMP				@@nextq
+@@zeroq:
+				MOV				RAX, tw [ R12 * 8 ]
+				ADD				RAX, RBX							; carry only
+				MOV				tw [ R12 * 8 - 8 ], RAX
+				SBB				RBX, RBX
+				NEG				RBX									; carry out, 0 or 1
+@@nextq:
+				INC				R12
+				CMP				R12, 8
+				JL				@@sparse
+@@reduced:
+				ADD				RBX, tw [ 8 * 8 ]
+				MOV				tw [ 7 * 8 ], RBX
+				MOV				RAX, tw [ 9 * 8 ]
+				ADC				RAX, 0
+				MOV				tw [ 8 * 8 ], RAX
+				INC				R14
+				CMP				R14, 8
+				JL				@@outer
+
+; Accumulator is less than 2N. Subtract N; if that borrows (and no ninth qword), keep the accumulator, else keep the difference
+				CLC
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				RAX, tw [ idx * 8 ]
+				SBB				RAX, Q_PTR [ R9 ] [ ( 7 - idx ) * 8 ]
+				MOV				dw [ idx * 8 ], RAX
+				ENDM
+				MOV				RAX, tw [ 8 * 8 ]
+				SBB				RAX, 0								; carry set: accumulator was less than N
+				MOV				RCX, savedRCX
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				RAX, tw [ idx * 8 ]
+				CMOVNC			RAX, dw [ idx * 8 ]					; (MOV, CMOV leave the flags alone)
+				MOV				Q_PTR [ RCX ] [ ( 7 - idx ) * 8 ], RAX
+				ENDM
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+mont_mul_u		ENDP
+				Other_Exit		mont_mul_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_to_u:PROC				; s16 mont_to_u( u64* result, u64* source, u64* ctx)
+;			mont_to_u		-	convert source (less than N) into Montgomery form: result = source * R mod N
+;			Prototype:		-	s16 mont_to_u( u64* result, u64* source, u64* ctx);
+;			result			-	Address of 8 QWORDS to store result (in RCX)
+;			source			-	Address of 8 QWORDS source, less than N (in RDX)
+;			ctx				-	Address of Montgomery context from mont_setup_u (in R8)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		mont_to_u, ui512
+mont_to_u		PROC			PUBLIC
+				MOV				R9, R8								; context
+				LEA				R8, [ R8 ] [ mctx_r2modn ]			; mont_mul ( source, R^2 ) = source * R
+				JMP				mont_mul_u
+mont_to_u		ENDP
+				Other_Exit		mont_to_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_from_u:PROC			; s16 mont_from_u( u64* result, u64* source, u64* ctx)
+;			mont_from_u		-	convert source out of Montgomery form: result = source * R^-1 mod N
+;			Prototype:		-	s16 mont_from_u( u64* result, u64* source, u64* ctx);
+;			result			-	Address of 8 QWORDS to store result (in RCX)
+;			source			-	Address of 8 QWORDS source, Montgomery form (in RDX)
+;			ctx				-	Address of Montgomery context from mont_setup_u (in R8)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		mont_from_u, ui512
+mont_from_u		PROC			PUBLIC
+				MOV				R9, R8								; context
+				LEA				R8, one512							; mont_mul ( source, 1 ) = source * R^-1
+				JMP				mont_mul_u
+mont_from_u		ENDP
+				Other_Exit		mont_from_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_pow_uT64:PROC			; s16 mont_pow_uT64( u64* result, u64* base, u64 exponent, u64* ctx)
+;			mont_pow_uT64	-	raise base (Montgomery form) to a 64 bit exponent, giving result (Montgomery form)
+;			Prototype:		-	s16 mont_pow_uT64( u64* result, u64* base, u64 exponent, u64* ctx);
+;			result			-	Address of 8 QWORDS to store result (in RCX)
+;			base			-	Address of 8 QWORDS base, Montgomery form (in RDX)
+;			exponent		-	exponent QWORD (in R8)
+;			ctx				-	Address of Montgomery context from mont_setup_u (in R9)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			Left to right binary (square and multiply). An exponent of zero gives R mod N (Montgomery one)
+;
+				Other_Entry		mont_pow_uT64, ui512
+mont_pow_uT64	PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			acc [ 8 ] : QWORD, base [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedR9 : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		200h, savedRBP, < R12, R13 >
+				MOV				savedRCX, RCX
+				MOV				savedR9, R9
+
+				CheckAlign		RCX, @@exit							; (out) Result
+				CheckAlign		RDX, @@exit							; (in) Base
+
+				LEA				RCX, base							; copy base (caller may use result as base)
+				Copy512			RCX, RDX
+				LEA				RCX, acc							; accumulator starts as Montgomery one
+				LEA				RDX, [ R9 ] [ mctx_rmodn ]
+				Copy512			RCX, RDX
+				MOV				R12, R8								; exponent
+				BSR				R13, R12							; index of leading bit
+				JZ				@@done								; exponent zero? result is one
+
+@@powloop:
+				LEA				RCX, acc
+				LEA				RDX, acc
+				LEA				R8, acc
+				MOV				R9, savedR9
+				CALL			mont_mul_u							; square
+				BT				R12, R13
+				JNC				@F
+				LEA				RCX, acc
+				LEA				RDX, acc
+				LEA				R8, base
+				MOV				R9, savedR9
+				CALL			mont_mul_u							; and multiply if bit is set
+@@:
+				DEC				R13
+				JGE				@@powloop
+
+@@done:
+				MOV				RCX, savedRCX
+				LEA				RDX, acc
+				Copy512			RCX, RDX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+mont_pow_uT64	ENDP
+				Other_Exit		mont_pow_uT64, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		bsgs_log_u:PROC				; s16 bsgs_log_u( u64* x, u64* g, u64* h, u64* ctx, u64 bound, u64* table, u32 tblbits)
+;			bsgs_log_u		-	discrete log by baby-step giant-step: find x, 0 <= x <= bound, with g^x = h mod N
+;			Prototype:		-	s16 bsgs_log_u( u64* x, u64* g, u64* h, u64* ctx, u64 bound, u64* table, u32 tblbits);
+;			x				-	Address of QWORD to receive the exponent (in RCX)
+;			g				-	Address of 8 QWORDS base, less than N, not Montgomery form (in RDX)
+;			h				-	Address of 8 QWORDS target, less than N, not Montgomery form (in R8)
+;			ctx				-	Address of Montgomery context for the modulus, from mont_setup_u (in R9)
+;			bound			-	largest exponent to be searched (on stack)
+;			table			-	Address of caller supplied work area, 2^tblbits entries of 2 QWORDS (16 bytes each) (on stack)
+;			tblbits			-	table size, as a power of two, 2 to 40 (on stack)
+;			returns			-	0 for success, -1 if no x within bound (or tblbits out of range), (GP_Fault) for mis-aligned parameter address
+;
+;			Memory / time tradeoff: the table holds m = 2^(tblbits-1) baby steps (half full), and the search makes bound / m + 1 giant steps.
+;			Each doubling of the table halves the giant steps. Baby steps store h * g^j, j = 0 .. m-1; giant steps compute g^(i*m), i = 0, 1, ..
+;			a match gives x = i*m - j (no modular inverse needed). Table entries are keyed by the least significant qword of the Montgomery
+;			form value (a truncated key), open addressing with linear probing; a matching key is confirmed by g^x = h before returning.
+;			Baby steps and giant steps are in Montgomery form throughout. The table is read-only during the giant steps.
+;
+				Other_Entry		bsgs_log_u, ui512
+bsgs_log_u		PROC			PUBLIC
+				XOR				R10, R10							; no range: build the table, then every giant step
+				JMP				bsgs_core_u
+bsgs_log_u		ENDP
+				Other_Exit		bsgs_log_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		bsgs_range_u:PROC			; s16 bsgs_range_u( u64* x, u64* g, u64* h, u64* ctx, u64 bound, u64* table, u32 tblbits, u64* range)
+;			bsgs_range_u	-	discrete log by baby-step giant-step, over one share of the giant steps (as bsgs_log_u, for one of several threads)
+;			Prototype:		-	s16 bsgs_range_u( u64* x, u64* g, u64* h, u64* ctx, u64 bound, u64* table, u32 tblbits, u64* range);
+;			x .. tblbits	-	as bsgs_log_u
+;			range			-	Address of 4 QWORDS (on stack):
+;								[ 0 ] first giant step index, [ 1 ] stride between giant step indexes (non-zero),
+;								[ 2 ] address of a limit QWORD shared by the threads (or null): giant steps beyond it are skipped, and a find lowers it
+;									(atomically) to its giant step. Start it at u64_Max.
+;								[ 3 ] non-zero to clear and fill the table first; zero to search a table already built (by an earlier call with it set).
+;									With a first giant step of u64_Max the call builds the table only.
+;			returns			-	0 for success, -1 if no x within bound in this share (or tblbits, stride out of range), (GP_Fault) for mis-aligned parameter address
+;
+;			Threads share one table: build it with one call ( u64_Max, 1, null, 1 ), then give thread t of T the share ( t, T, &limit, 0 ).
+;			Giant step i covers x in ( i*m - m, i*m ], so the lowest giant step with a find holds the smallest x: the limit stops
+;			the threads above it, and the smallest x returned by the threads is the one bsgs_log_u returns.
+;
+				Other_Entry		bsgs_range_u, ui512
+bsgs_range_u	PROC			PUBLIC
+				MOV				R10, Q_PTR [ RSP ] [ 8 + 7 * 8 ]	; range, the eighth parameter
+				JMP				bsgs_core_u
+bsgs_range_u	ENDP
+				Other_Exit		bsgs_range_u, ui512
+
+;			bsgs_core_u: bsgs_log_u and bsgs_range_u, with the range address (or null for the whole search) in R10
+				Other_Entry		bsgs_core_u, ui512
+bsgs_core_u		PROC			PRIVATE FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			gM [ 8 ] : QWORD, hM [ 8 ] : QWORD, cur [ 8 ] : QWORD, giant [ 8 ] : QWORD, work [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD, savedR8 : QWORD, savedR9 : QWORD
+				LOCAL			imax : QWORD, candidate : QWORD
+				LOCAL			prange : QWORD, gstart : QWORD, gstride : QWORD, plimit : QWORD, build : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+bsgs_bound		EQU				8 + 5 * 8							; stack parameters, as offsets from saved RBP (which is entry RSP less the pushed RBP)
+bsgs_table		EQU				8 + 6 * 8
+bsgs_tblbits	EQU				8 + 7 * 8
+
+				CreateFrame		300h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+				MOV				savedR8, R8
+				MOV				savedR9, R9
+				MOV				prange, R10
+
+				CheckAlign		RDX, @@exit							; (in) g
+				CheckAlign		R8, @@exit							; (in) h
+
+; Pick up stack parameters, set dimensions. R12: bound, RSI: table, R13: mask (slots - 1), R14: m (Nr baby steps)
+				MOV				RAX, savedRBP
+				MOV				R12, Q_PTR [ RAX ] [ bsgs_bound ]
+				MOV				RSI, Q_PTR [ RAX ] [ bsgs_table ]
+				MOV				ECX, D_PTR [ RAX ] [ bsgs_tblbits ]
+				CMP				ECX, 2
+				JB				@@notfound
+				CMP				ECX, 40
+				JA				@@notfound
+				MOV				R13, 1
+				SHL				R13, CL
+				LEA				R14, [ R13 ]
+				SHR				R14, 1								; m = slots / 2
+				DEC				R13									; mask
+				MOV				RAX, R12
+				DEC				ECX
+				SHR				RAX, CL								; bound / m
+				INC				RAX
+				MOV				imax, RAX							; last giant step index
+
+; Giant step share: first, stride, limit address (or null), build flag. No range: 0, 1, none, build
+				MOV				RCX, prange
+				XOR				EAX, EAX
+				MOV				EDX, 1
+				XOR				R8, R8
+				MOV				R9D, 1
+				TEST			RCX, RCX
+				JZ				@F
+				MOV				RAX, Q_PTR [ RCX ]
+				MOV				RDX, Q_PTR [ RCX ] [ 1 * 8 ]
+				MOV				R8, Q_PTR [ RCX ] [ 2 * 8 ]
+				MOV				R9, Q_PTR [ RCX ] [ 3 * 8 ]
+				TEST			RDX, RDX
+				JZ				@@notfound							; a stride of zero
+@@:
+				MOV				gstart, RAX
+				MOV				gstride, RDX
+				MOV				plimit, R8
+				MOV				build, R9
+
+; Convert g and h into Montgomery form
+				LEA				RCX, gM
+				MOV				RDX, savedRDX
+				MOV				R8, savedR9
+				CALL			mont_to_u
+				LEA				RCX, hM
+				MOV				RDX, savedR8
+				MOV				R8, savedR9
+				CALL			mont_to_u
+				CMP				build, 0
+				JE				@@giantsetup						; table already built (by another share)
+
+; Clear the table (empty slots have a zero value qword)
+				MOV				RDI, RSI
+				LEA				RCX, [ R13 + 1 ]
+				SHL				RCX, 1								; Nr qwords
+				XOR				EAX, EAX
+				REP STOSQ
+
+; Baby steps: cur = h * g^j, insert ( key, j + 1 ) for j = 0 .. m - 1
+				LEA				RCX, cur
+				LEA				RDX, hM
+				Copy512			RCX, RDX
+				XOR				R15, R15							; j
+@@baby:
+				MOV				RDI, cur [ 7 * 8 ]					; key: least significant qword
+				MOV				RBX, RDI
+				AND				RBX, R13							; home slot
+@@:
+				MOV				RAX, RBX
+				SHL				RAX, 4								; slot * 16
+				CMP				Q_PTR [ RSI ] [ RAX ] [ 8 ], 0		; empty?
+				JE				@F
+				INC				RBX									; no, probe next slot
+				AND				RBX, R13
+				JMP				@B
+@@:
+				MOV				Q_PTR [ RSI ] [ RAX ], RDI
+				LEA				RDX, [ R15 + 1 ]
+				MOV				Q_PTR [ RSI ] [ RAX ] [ 8 ], RDX
+				LEA				RCX, cur
+				LEA				RDX, cur
+				LEA				R8, gM
+				MOV				R9, savedR9
+				CALL			mont_mul_u							; next baby step
+				INC				R15
+				CMP				R15, R14
+				JB				@@baby
+
+; Giant step multiplier g^(m*stride), starting giant step g^(first*m) (Montgomery one for the first of zero)
+@@giantsetup:
+				MOV				R15, gstart							; i
+				CMP				R15, imax
+				JA				@@notfound
+				LEA				RCX, giant
+				LEA				RDX, gM
+				MOV				R8, R14
+				IMUL			R8, gstride
+				MOV				R9, savedR9
+				CALL			mont_pow_uT64
+				LEA				RCX, cur
+				LEA				RDX, gM
+				MOV				R8, R14
+				IMUL			R8, R15
+				MOV				R9, savedR9
+				CALL			mont_pow_uT64
+
+; Giant steps: look up cur = g^(i*m); each matching key gives a candidate x = i*m - j
+@@giant:
+				MOV				RAX, plimit
+				TEST			RAX, RAX
+				JZ				@F
+				CMP				R15, Q_PTR [ RAX ]
+				JA				@@notfound							; another share has a find at a lower giant step
+@@:
+				MOV				RDI, cur [ 7 * 8 ]
+				MOV				RBX, RDI
+				AND				RBX, R13
+@@probe:
+				MOV				RAX, RBX
+				SHL				RAX, 4
+				MOV				RDX, Q_PTR [ RSI ] [ RAX ] [ 8 ]	; j + 1, or zero for an empty slot
+				TEST			RDX, RDX
+				JZ				@@nextgiant							; empty slot ends the probe
+				CMP				Q_PTR [ RSI ] [ RAX ], RDI
+				JNE				@@nextprobe
+				MOV				RAX, R15
+				IMUL			RAX, R14							; i * m
+				DEC				RDX									; j
+				SUB				RAX, RDX							; x = i * m - j
+				JB				@@nextprobe							; (negative, not a candidate)
+				CMP				RAX, R12
+				JA				@@nextprobe							; beyond bound
+				MOV				candidate, RAX
+				LEA				RCX, work							; confirm: key is truncated, so verify g^x = h
+				LEA				RDX, gM
+				MOV				R8, RAX
+				MOV				R9, savedR9
+				CALL			mont_pow_uT64
+				LEA				RCX, work
+				LEA				RDX, hM
+				CALL			compare_u
+				TEST			AX, AX
+				JZ				@@found
+@@nextprobe:
+				INC				RBX
+				AND				RBX, R13
+				JMP				@@probe
+@@nextgiant:
+				LEA				RCX, cur
+				LEA				RDX, cur
+				LEA				R8, giant
+				MOV				R9, savedR9
+				CALL			mont_mul_u							; next giant step
+				ADD				R15, gstride
+				JC				@@notfound
+				CMP				R15, imax
+				JBE				@@giant
+
+@@notfound:
+				MOV				RCX, savedRCX
+				MOV				Q_PTR [ RCX ], 0
+				LEA				EAX, [ retcode_neg_one ]
+				JMP				@@exit
+
+@@found:
+				MOV				RCX, plimit							; lower the shared limit to this giant step
+				TEST			RCX, RCX
+				JZ				@@store
+				MOV				RAX, Q_PTR [ RCX ]
+@@:
+				CMP				RAX, R15
+				JBE				@@store								; already at or below it
+				LOCK CMPXCHG	Q_PTR [ RCX ], R15
+				JNZ				@B									; changed under us: RAX has the new value, try again
+@@store:
+				MOV				RCX, savedRCX
+				MOV				RAX, candidate
+				MOV				Q_PTR [ RCX ], RAX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+bsgs_core_u		ENDP
+				Other_Exit		bsgs_core_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_add_u:PROC				; s16 mont_add_u( u64* result, u64* lh_op, u64* rh_op, u64* ctx)
+;			mont_add_u		-	modular add: result = lh_op + rh_op mod N (either form, both operands less than N)
+;			Prototype:		-	s16 mont_add_u( u64* result, u64* lh_op, u64* rh_op, u64* ctx);
+;			result			-	Address of 8 QWORDS to store result (in RCX)
+;			lh_op			-	Address of 8 QWORDS left hand operand (in RDX)
+;			rh_op			-	Address of 8 QWORDS right hand operand (in R8)
+;			ctx				-	Address of Montgomery context from mont_setup_u (in R9)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		mont_add_u, ui512
+mont_add_u		PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Result
+				CheckAlign		RDX, @@exit							; (in) LH Op
+				CheckAlign		R8, @@exit							; (in) RH Op
+
+; Sum to callers result, least significant qword first (each qword of result written after its operand qwords read, so may be either operand)
+				MOV				RAX, Q_PTR [ RDX ] [ 7 * 8 ]
+				ADD				RAX, Q_PTR [ R8 ] [ 7 * 8 ]
+				MOV				Q_PTR [ RCX ] [ 7 * 8 ], RAX
+				FOR				idx, < 6, 5, 4, 3, 2, 1, 0 >
+				MOV				RAX, Q_PTR [ RDX ] [ idx * 8 ]
+				ADC				RAX, Q_PTR [ R8 ] [ idx * 8 ]
+				MOV				Q_PTR [ RCX ] [ idx * 8 ], RAX
+				ENDM
+				JC				@@subtract							; carry out? sum is beyond N
+
+; Trial subtract of N, keeping only the borrow: borrow means sum is already less than N
+				MOV				RAX, Q_PTR [ RCX ] [ 7 * 8 ]
+				SUB				RAX, Q_PTR [ R9 ] [ 7 * 8 ]
+				FOR				idx, < 6, 5, 4, 3, 2, 1, 0 >
+				MOV				RAX, Q_PTR [ RCX ] [ idx * 8 ]
+				SBB				RAX, Q_PTR [ R9 ] [ idx * 8 ]
+				ENDM
+				JC				@@done
+
+@@subtract:
+				MOV				RAX, Q_PTR [ R9 ] [ 7 * 8 ]
+				SUB				Q_PTR [ RCX ] [ 7 * 8 ], RAX
+				FOR				idx, < 6, 5, 4, 3, 2, 1, 0 >
+				MOV				RAX, Q_PTR [ R9 ] [ idx * 8 ]
+				SBB				Q_PTR [ RCX ] [ idx * 8 ], RAX
+				ENDM
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				RET
+mont_add_u		ENDP
+				Other_Exit		mont_add_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_sub_u:PROC				; s16 mont_sub_u( u64* result, u64* lh_op, u64* rh_op, u64* ctx)
+;			mont_sub_u		-	modular subtract: result = lh_op - rh_op mod N (either form, both operands less than N)
+;			Prototype:		-	s16 mont_sub_u( u64* result, u64* lh_op, u64* rh_op, u64* ctx);
+;			result			-	Address of 8 QWORDS to store result (in RCX)
+;			lh_op			-	Address of 8 QWORDS left hand operand (in RDX)
+;			rh_op			-	Address of 8 QWORDS right hand operand (in R8)
+;			ctx				-	Address of Montgomery context from mont_setup_u (in R9)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		mont_sub_u, ui512
+mont_sub_u		PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Result
+				CheckAlign		RDX, @@exit							; (in) LH Op
+				CheckAlign		R8, @@exit							; (in) RH Op
+
+				MOV				RAX, Q_PTR [ RDX ] [ 7 * 8 ]
+				SUB				RAX, Q_PTR [ R8 ] [ 7 * 8 ]
+				MOV				Q_PTR [ RCX ] [ 7 * 8 ], RAX
+				FOR				idx, < 6, 5, 4, 3, 2, 1, 0 >
+				MOV				RAX, Q_PTR [ RDX ] [ idx * 8 ]
+				SBB				RAX, Q_PTR [ R8 ] [ idx * 8 ]
+				MOV				Q_PTR [ RCX ] [ idx * 8 ], RAX
+				ENDM
+				JNC				@@done								; no borrow? difference is in range
+
+				MOV				RAX, Q_PTR [ R9 ] [ 7 * 8 ]			; borrow: add N back (the carry out cancels the borrow)
+				ADD				Q_PTR [ RCX ] [ 7 * 8 ], RAX
+				FOR				idx, < 6, 5, 4, 3, 2, 1, 0 >
+				MOV				RAX, Q_PTR [ R9 ] [ idx * 8 ]
+				ADC				Q_PTR [ RCX ] [ idx * 8 ], RAX
+				ENDM
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				RET
+mont_sub_u		ENDP
+				Other_Exit		mont_sub_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_pow_u:PROC				; s16 mont_pow_u( u64* result, u64* base, u64* exponent, u64* ctx)
+;			mont_pow_u		-	raise base (Montgomery form) to a 512 bit exponent, giving result (Montgomery form)
+;			Prototype:		-	s16 mont_pow_u( u64* result, u64* base, u64* exponent, u64* ctx);
+;			result			-	Address of 8 QWORDS to store result (in RCX)
+;			base			-	Address of 8 QWORDS base, Montgomery form (in RDX)
+;			exponent		-	Address of 8 QWORDS exponent (in R8)
+;			ctx				-	Address of Montgomery context from mont_setup_u (in R9)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		mont_pow_u, ui512
+mont_pow_u		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			acc [ 8 ] : QWORD, base [ 8 ] : QWORD, expo [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedR9 : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		240h, savedRBP, < R12 >
+				MOV				savedRCX, RCX
+				MOV				savedR9, R9
+
+				CheckAlign		RCX, @@exit							; (out) Result
+				CheckAlign		RDX, @@exit							; (in) Base
+				CheckAlign		R8, @@exit							; (in) Exponent
+
+				LEA				RCX, base							; local copies: caller may use result as base or exponent
+				Copy512			RCX, RDX
+				LEA				RCX, expo
+				Copy512			RCX, R8
+				LEA				RCX, acc							; accumulator starts as Montgomery one
+				LEA				RDX, [ R9 ] [ mctx_rmodn ]
+				Copy512			RCX, RDX
+				LEA				RCX, expo
+				CALL			msb_u								; leading bit of exponent
+				MOVSX			R12, AX
+				TEST			R12, R12
+				JS				@@done								; exponent zero? result is one
+
+@@powloop:
+				LEA				RCX, acc
+				LEA				RDX, acc
+				LEA				R8, acc
+				MOV				R9, savedR9
+				CALL			mont_mul_u							; square
+				MOV				RAX, R12
+				SHR				RAX, 6
+				MOV				RCX, 7
+				SUB				RCX, RAX							; qword holding bit [ R12 ]
+				MOV				RAX, expo [ RCX * 8 ]
+				BT				RAX, R12							; (bit index taken mod 64)
+				JNC				@F
+				LEA				RCX, acc
+				LEA				RDX, acc
+				LEA				R8, base
+				MOV				R9, savedR9
+				CALL			mont_mul_u							; and multiply if bit is set
+@@:
+				DEC				R12
+				JGE				@@powloop
+
+@@done:
+				MOV				RCX, savedRCX
+				LEA				RDX, acc
+				Copy512			RCX, RDX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+mont_pow_u		ENDP
+				Other_Exit		mont_pow_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_inv_u:PROC				; s16 mont_inv_u( u64* result, u64* source, u64* ctx)
+;			mont_inv_u		-	modular inverse (Montgomery form in and out), for a prime modulus: result = source^(N-2) (Fermat)
+;			Prototype:		-	s16 mont_inv_u( u64* result, u64* source, u64* ctx);
+;			result			-	Address of 8 QWORDS to store result (in RCX)
+;			source			-	Address of 8 QWORDS source, Montgomery form (in RDX)
+;			ctx				-	Address of Montgomery context from mont_setup_u, modulus must be prime (in R8)
+;			returns			-	0 for success, -1 for source of zero (no inverse; result is zero), (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		mont_inv_u, ui512
+mont_inv_u		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			expo [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD, savedR8 : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		180h, savedRBP
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+				MOV				savedR8, R8
+
+				CheckAlign		RCX, @@exit							; (out) Result
+				CheckAlign		RDX, @@exit							; (in) Source
+
+				MOV				RCX, RDX
+				XOR				EDX, EDX
+				CALL			compare_uT64						; zero has no inverse
+				TEST			AX, AX
+				JZ				@@zero
+
+				LEA				RCX, expo							; exponent N - 2
+				MOV				RDX, savedR8
+				MOV				R8, 2
+				CALL			sub_uT64
+				MOV				RCX, savedRCX
+				MOV				RDX, savedRDX
+				LEA				R8, expo
+				MOV				R9, savedR8
+				CALL			mont_pow_u
+				JMP				@@exit
+
+@@zero:
+				MOV				RCX, savedRCX
+				Zero512			RCX
+				LEA				EAX, [ retcode_neg_one ]
+@@exit:
+				ReleaseFrame
+				RET
+
+mont_inv_u		ENDP
+				Other_Exit		mont_inv_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mont_batchinv_u:PROC		; s16 mont_batchinv_u( u64* results, u64* values, u64 count, u64* ctx)
+;			mont_batchinv_u	-	invert an array of values with one modular inverse (Montgomery's trick), prime modulus
+;			Prototype:		-	s16 mont_batchinv_u( u64* results, u64* values, u64 count, u64* ctx);
+;			results			-	Address of count * 8 QWORDS to store inverses; must not be the values array (in RCX)
+;			values			-	Address of count * 8 QWORDS values, Montgomery form (in RDX)
+;			count			-	Nr of values (in R8)
+;			ctx				-	Address of Montgomery context from mont_setup_u, modulus must be prime (in R9)
+;			returns			-	0 for success, -1 if any value is zero (results undefined), (GP_Fault) for mis-aligned parameter address
+;
+;			Forward: results [ i ] = v0 * v1 * .. * vi. One inverse of the full product. Backward: results [ i ] = inv * results [ i-1 ],
+;			then inv = inv * vi. Cost is 3 (count - 1) multiplies plus one inverse, instead of count inverses.
+;
+				Other_Entry		mont_batchinv_u, ui512
+mont_batchinv_u	PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			inv [ 8 ] : QWORD, tmp [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD, savedR9 : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		200h, savedRBP, < RBX, R12, R13 >
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+				MOV				savedR9, R9
+
+				CheckAlign		RCX, @@exit							; (out) Results
+				CheckAlign		RDX, @@exit							; (in) Values
+
+				XOR				EAX, EAX
+				MOV				R13, R8								; count
+				TEST			R13, R13
+				JZ				@@exit								; nothing to do
+
+; Forward pass: running products
+				Copy512			RCX, RDX							; results [ 0 ] = values [ 0 ]
+				MOV				R12, 1
+@@fwd:
+				CMP				R12, R13
+				JAE				@@invert
+				ElemAddr		RCX, savedRCX, R12
+				LEA				RDX, [ RCX - 64 ]					; results [ i - 1 ]
+				ElemAddr		R8, savedRDX, R12					; values [ i ]
+				MOV				R9, savedR9
+				CALL			mont_mul_u
+				INC				R12
+				JMP				@@fwd
+
+; One inverse, of the product of all values
+@@invert:
+				LEA				RCX, inv
+				LEA				RDX, [ R13 - 1 ]
+				ElemAddr		RDX, savedRCX, RDX
+				MOV				R8, savedR9
+				CALL			mont_inv_u
+				TEST			AX, AX
+				JNZ				@@exit								; a zero value, no inverses
+
+; Backward pass
+				LEA				R12, [ R13 - 1 ]
+@@bwd:
+				TEST			R12, R12
+				JZ				@@last
+				ElemAddr		RBX, savedRCX, R12					; results [ i ]
+				LEA				RCX, tmp
+				LEA				RDX, inv
+				LEA				R8, [ RBX - 64 ]					; results [ i - 1 ]
+				MOV				R9, savedR9
+				CALL			mont_mul_u							; inverse of values [ i ]
+				LEA				RCX, inv
+				LEA				RDX, inv
+				ElemAddr		R8, savedRDX, R12
+				MOV				R9, savedR9
+				CALL			mont_mul_u							; inv now inverse of v0 .. v(i-1)
+				LEA				RDX, tmp
+				Copy512			RBX, RDX
+				DEC				R12
+				JMP				@@bwd
+@@last:
+				MOV				RCX, savedRCX
+				LEA				RDX, inv
+				Copy512			RCX, RDX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+mont_batchinv_u	ENDP
+				Other_Exit		mont_batchinv_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		shamir_split_u:PROC			; s16 shamir_split_u( u64* shares, u64* coeffs, u64 k, u64* xs, u64 n, u64* ctx)
+;			shamir_split_u	-	Shamir share generation: evaluate polynomial coeffs (degree k-1) at each of n points (Horner's rule)
+;			Prototype:		-	s16 shamir_split_u( u64* shares, u64* coeffs, u64 k, u64* xs, u64 n, u64* ctx);
+;			shares			-	Address of n * 8 QWORDS to store the shares, y = f ( x ) (in RCX)
+;			coeffs			-	Address of k * 8 QWORDS coefficients, coeffs [ 0 ] is the secret, the rest random (in RDX)
+;			k				-	Nr of coefficients, the threshold Nr of shares to reconstruct, at least one (in R8)
+;			xs				-	Address of n * 8 QWORDS evaluation points, distinct and non-zero (in R9)
+;			n				-	Nr of shares (on stack)
+;			ctx				-	Address of Montgomery context from mont_setup_u, prime modulus (on stack)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			All values are in Montgomery form. The caller supplies the random coefficients.
+;
+				Other_Entry		shamir_split_u, ui512
+shamir_split_u	PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			y [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD, savedR8 : QWORD, savedR9 : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+shsp_n			EQU				8 + 5 * 8							; stack parameters, as offsets from saved RBP
+shsp_ctx		EQU				8 + 6 * 8
+
+				CreateFrame		200h, savedRBP, < RBX, R12, R13, R14, R15 >
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+				MOV				savedR8, R8
+				MOV				savedR9, R9
+
+				CheckAlign		RCX, @@exit							; (out) Shares
+				CheckAlign		RDX, @@exit							; (in) Coefficients
+				CheckAlign		R9, @@exit							; (in) Points
+
+				MOV				RAX, savedRBP
+				MOV				R14, Q_PTR [ RAX ] [ shsp_n ]		; n
+				MOV				R15, Q_PTR [ RAX ] [ shsp_ctx ]		; ctx
+				XOR				R12, R12							; p: point index
+@@point:
+				CMP				R12, R14
+				JAE				@@done
+				ElemAddr		RBX, savedR9, R12					; xs [ p ]
+				MOV				R13, savedR8
+				DEC				R13									; t = k - 1
+				LEA				RCX, y
+				ElemAddr		RDX, savedRDX, R13
+				Copy512			RCX, RDX							; y = coeffs [ k - 1 ]
+@@horner:
+				DEC				R13
+				JS				@@store								; done with coefficients?
+				LEA				RCX, y
+				LEA				RDX, y
+				MOV				R8, RBX
+				MOV				R9, R15
+				CALL			mont_mul_u							; y = y * x
+				LEA				RCX, y
+				LEA				RDX, y
+				ElemAddr		R8, savedRDX, R13
+				MOV				R9, R15
+				CALL			mont_add_u							; y = y + coeffs [ t ]
+				JMP				@@horner
+@@store:
+				ElemAddr		RCX, savedRCX, R12
+				LEA				RDX, y
+				Copy512			RCX, RDX							; shares [ p ] = y
+				INC				R12
+				JMP				@@point
+
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+shamir_split_u	ENDP
+				Other_Exit		shamir_split_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		shamir_lagrange_u:PROC		; s16 shamir_lagrange_u( u64* lambdas, u64* xs, u64 k, u64* ctx, u64* scratch)
+;			shamir_lagrange_u -	Lagrange coefficients at zero for a set of k share points: lambda [ i ] = product, j != i, of x [ j ] / ( x [ j ] - x [ i ] )
+;			Prototype:		-	s16 shamir_lagrange_u( u64* lambdas, u64* xs, u64 k, u64* ctx, u64* scratch);
+;			lambdas			-	Address of k * 8 QWORDS to store coefficients (in RCX)
+;			xs				-	Address of k * 8 QWORDS share points, Montgomery form (in RDX)
+;			k				-	Nr of share points (in R8)
+;			ctx				-	Address of Montgomery context from mont_setup_u, prime modulus (in R9)
+;			scratch			-	Address of k * 8 QWORDS work area (on stack)
+;			returns			-	0 for success, -1 for repeated share points, (GP_Fault) for mis-aligned parameter address
+;
+;			The denominators are inverted together by mont_batchinv_u. For a fixed set of share points the coefficients do not change:
+;			compute them once, keep them, and reconstruct each secret with shamir_combine_u alone.
+;
+				Other_Entry		shamir_lagrange_u, ui512
+shamir_lagrange_u	PROC		PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			diff [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD, savedR8 : QWORD, savedR9 : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+shlg_scratch	EQU				8 + 5 * 8							; stack parameter, as offset from saved RBP
+
+				CreateFrame		200h, savedRBP, < RBX, R12, R13, R14 >
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+				MOV				savedR8, R8
+				MOV				savedR9, R9
+
+				CheckAlign		RCX, @@exit							; (out) Lambdas
+				CheckAlign		RDX, @@exit							; (in) Points
+
+				MOV				RAX, savedRBP
+				MOV				R14, Q_PTR [ RAX ] [ shlg_scratch ]
+
+; Denominators: scratch [ i ] = product, j != i, of ( x [ j ] - x [ i ] )
+				XOR				R12, R12							; i
+@@den_i:
+				CMP				R12, savedR8
+				JAE				@@invert
+				ElemAddr		RBX, R14, R12						; scratch [ i ]
+				MOV				RDX, savedR9
+				LEA				RDX, [ RDX ] [ mctx_rmodn ]
+				Copy512			RBX, RDX							; start with one
+				XOR				R13, R13							; j
+@@den_j:
+				CMP				R13, R12
+				JE				@@den_next
+				LEA				RCX, diff
+				ElemAddr		RDX, savedRDX, R13
+				ElemAddr		R8, savedRDX, R12
+				MOV				R9, savedR9
+				CALL			mont_sub_u							; x [ j ] - x [ i ]
+				MOV				RCX, RBX
+				MOV				RDX, RBX
+				LEA				R8, diff
+				MOV				R9, savedR9
+				CALL			mont_mul_u
+@@den_next:
+				INC				R13
+				CMP				R13, savedR8
+				JB				@@den_j
+				INC				R12
+				JMP				@@den_i
+
+; One batch inverse of all denominators, straight into lambdas
+@@invert:
+				MOV				RCX, savedRCX
+				MOV				RDX, R14
+				MOV				R8, savedR8
+				MOV				R9, savedR9
+				CALL			mont_batchinv_u
+				TEST			AX, AX
+				JNZ				@@exit								; a zero denominator: repeated share point
+
+; Numerators: lambda [ i ] = lambda [ i ] * product, j != i, of x [ j ]
+				XOR				R12, R12
+@@num_i:
+				CMP				R12, savedR8
+				JAE				@@done
+				ElemAddr		RBX, savedRCX, R12
+				XOR				R13, R13
+@@num_j:
+				CMP				R13, R12
+				JE				@@num_next
+				MOV				RCX, RBX
+				MOV				RDX, RBX
+				ElemAddr		R8, savedRDX, R13
+				MOV				R9, savedR9
+				CALL			mont_mul_u
+@@num_next:
+				INC				R13
+				CMP				R13, savedR8
+				JB				@@num_j
+				INC				R12
+				JMP				@@num_i
+
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+shamir_lagrange_u	ENDP
+				Other_Exit		shamir_lagrange_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		shamir_combine_u:PROC		; s16 shamir_combine_u( u64* secret, u64* lambdas, u64* shares, u64 k, u64* ctx)
+;			shamir_combine_u -	Shamir reconstruction: secret = sum of lambda [ i ] * share [ i ]
+;			Prototype:		-	s16 shamir_combine_u( u64* secret, u64* lambdas, u64* shares, u64 k, u64* ctx);
+;			secret			-	Address of 8 QWORDS to store the secret, Montgomery form (in RCX)
+;			lambdas			-	Address of k * 8 QWORDS Lagrange coefficients from shamir_lagrange_u (in RDX)
+;			shares			-	Address of k * 8 QWORDS share values, y, in the same order as the points given to shamir_lagrange_u (in R8)
+;			k				-	Nr of shares (in R9)
+;			ctx				-	Address of Montgomery context from mont_setup_u (on stack)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		shamir_combine_u, ui512
+shamir_combine_u	PROC		PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			acc [ 8 ] : QWORD, tmp [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD, savedR8 : QWORD, savedR9 : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+shcb_ctx		EQU				8 + 5 * 8							; stack parameter, as offset from saved RBP
+
+				CreateFrame		200h, savedRBP, < R12, R13 >
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+				MOV				savedR8, R8
+				MOV				savedR9, R9
+
+				CheckAlign		RCX, @@exit							; (out) Secret
+				CheckAlign		RDX, @@exit							; (in) Lambdas
+				CheckAlign		R8, @@exit							; (in) Shares
+
+				MOV				RAX, savedRBP
+				MOV				R13, Q_PTR [ RAX ] [ shcb_ctx ]
+				LEA				RCX, acc
+				Zero512			RCX									; (zero is zero in either form)
+				XOR				R12, R12
+@@sum:
+				CMP				R12, savedR9
+				JAE				@@done
+				LEA				RCX, tmp
+				ElemAddr		RDX, savedRDX, R12
+				ElemAddr		R8, savedR8, R12
+				MOV				R9, R13
+				CALL			mont_mul_u							; lambda [ i ] * y [ i ]
+				LEA				RCX, acc
+				LEA				RDX, acc
+				LEA				R8, tmp
+				MOV				R9, R13
+				CALL			mont_add_u
+				INC				R12
+				JMP				@@sum
+
+@@done:
+				MOV				RCX, savedRCX
+				LEA				RDX, acc
+				Copy512			RCX, RDX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+shamir_combine_u	ENDP
+				Other_Exit		shamir_combine_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		adds_u:PROC					; s16 adds_u( u64* sum, u64* addend1, u64* addend2)
+;			adds_u			-	saturating add: sum = addend1 + addend2, clamped at 2^512 - 1 (all ones)
+;			Prototype:		-	s16 adds_u( u64* sum, u64* addend1, u64* addend2);
+;			sum				-	Address of 8 QWORDS to store result (in RCX)
+;			addend1			-	Address of 8 QWORDS addend (in RDX)
+;			addend2			-	Address of 8 QWORDS addend (in R8)
+;			returns			-	zero for no carry, 1 for saturated, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		adds_u, ui512
+adds_u			PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Sum
+				CheckAlign		RDX, @@exit							; (in) Addend1
+				CheckAlign		R8, @@exit							; (in) Addend2
+				SatAdd512		RCX, RDX, R8
+				SETC			AL
+				MOVZX			EAX, AL								; return 1 if saturated
+@@exit:
+				RET
+adds_u			ENDP
+				Other_Exit		adds_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		subs_u:PROC					; s16 subs_u( u64* difference, u64* left operand, u64* right operand)
+;			subs_u			-	saturating subtract: difference = left - right, clamped at zero
+;			Prototype:		-	s16 subs_u( u64* difference, u64* left operand, u64* right operand);
+;			difference		-	Address of 8 QWORDS to store result (in RCX)
+;			left operand	-	Address of 8 QWORDS left operand (in RDX)
+;			right operand	-	Address of 8 QWORDS right operand (in R8)
+;			returns			-	zero for no borrow, 1 for saturated, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		subs_u, ui512
+subs_u			PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Difference
+				CheckAlign		RDX, @@exit							; (in) Left operand
+				CheckAlign		R8, @@exit							; (in) Right operand
+				SatSub512		RCX, RDX, R8
+				SETC			AL
+				MOVZX			EAX, AL								; return 1 if saturated
+@@exit:
+				RET
+subs_u			ENDP
+				Other_Exit		subs_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		muls_u:PROC					; s16 muls_u( u64* product, u64* multiplicand, u64* multiplier)
+;			muls_u			-	saturating multiply: product = multiplicand * multiplier, clamped at 2^512 - 1 on any overflow
+;			Prototype:		-	s16 muls_u( u64* product, u64* multiplicand, u64* multiplier);
+;			product			-	Address of 8 QWORDS to store result (in RCX)
+;			multiplicand	-	Address of 8 QWORDS multiplicand (in RDX)
+;			multiplier		-	Address of 8 QWORDS multiplier (in R8)
+;			returns			-	zero for no overflow, 1 for saturated, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		muls_u, ui512
+muls_u			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			overflow [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		140h, savedRBP
+				MOV				savedRCX, RCX
+
+				CheckAlign		RCX, @@exit							; (out) Product
+				CheckAlign		RDX, @@exit							; (in) Multiplicand
+				CheckAlign		R8, @@exit							; (in) Multiplier
+
+				MOV				R9, R8								; mult_u ( product, overflow, multiplicand, multiplier )
+				MOV				R8, RDX
+				LEA				RDX, overflow
+				CALL			mult_u
+
+; Any non-zero overflow qword sets the carry flag, then select
+	IF		__UseZ
+				VMOVDQA64		ZMM0, ZM_PTR overflow
+				VPTESTMQ		K1, ZMM0, ZMM0						; mask bit per non-zero qword
+				KMOVB			EAX, K1
+	ELSE
+				MOV				RAX, overflow [ 0 * 8 ]
+				FOR				idx, < 1, 2, 3, 4, 5, 6, 7 >
+				OR				RAX, overflow [ idx * 8 ]
+				ENDM
+	ENDIF
+				NEG				RAX									; carry set if any overflow
+				MOV				RCX, savedRCX
+				SatSelect512	RCX, qOnes
+				SETC			AL
+				MOVZX			EAX, AL								; return 1 if saturated
+@@exit:
+				ReleaseFrame
+				RET
+
+muls_u			ENDP
+				Other_Exit		muls_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		adds_u_n:PROC				; u64 adds_u_n( u64* sums, u64* addends1, u64* addends2, u64 count)
+;			adds_u_n		-	saturating add of arrays: sums [ i ] = addends1 [ i ] + addends2 [ i ], each clamped at 2^512 - 1
+;			Prototype:		-	u64 adds_u_n( u64* sums, u64* addends1, u64* addends2, u64 count);
+;			sums			-	Address of count * 8 QWORDS to store results (in RCX)
+;			addends1		-	Address of count * 8 QWORDS addends (in RDX)
+;			addends2		-	Address of count * 8 QWORDS addends (in R8)
+;			count			-	Nr of 512 bit elements (in R9)
+;			returns			-	Nr of elements that saturated, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		adds_u_n, ui512
+adds_u_n		PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Sums
+				CheckAlign		RDX, @@exit							; (in) Addends1
+				CheckAlign		R8, @@exit							; (in) Addends2
+				XOR				R11, R11							; count of saturated results
+				TEST			R9, R9
+				JZ				@@done
+@@:
+				SatAdd512		RCX, RDX, R8
+				ADC				R11, 0								; count it if saturated
+				ADD				RCX, 64
+				ADD				RDX, 64
+				ADD				R8, 64
+				DEC				R9
+				JNZ				@B
+@@done:
+				MOV				RAX, R11
+@@exit:
+				RET
+adds_u_n		ENDP
+				Other_Exit		adds_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		subs_u_n:PROC				; u64 subs_u_n( u64* differences, u64* left operands, u64* right operands, u64 count)
+;			subs_u_n		-	saturating subtract of arrays: differences [ i ] = left [ i ] - right [ i ], each clamped at zero
+;			Prototype:		-	u64 subs_u_n( u64* differences, u64* left operands, u64* right operands, u64 count);
+;			differences		-	Address of count * 8 QWORDS to store results (in RCX)
+;			left operands	-	Address of count * 8 QWORDS left operands (in RDX)
+;			right operands	-	Address of count * 8 QWORDS right operands (in R8)
+;			count			-	Nr of 512 bit elements (in R9)
+;			returns			-	Nr of elements that saturated, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		subs_u_n, ui512
+subs_u_n		PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Differences
+				CheckAlign		RDX, @@exit							; (in) Left operands
+				CheckAlign		R8, @@exit							; (in) Right operands
+				XOR				R11, R11							; count of saturated results
+				TEST			R9, R9
+				JZ				@@done
+@@:
+				SatSub512		RCX, RDX, R8
+				ADC				R11, 0								; count it if saturated
+				ADD				RCX, 64
+				ADD				RDX, 64
+				ADD				R8, 64
+				DEC				R9
+				JNZ				@B
+@@done:
+				MOV				RAX, R11
+@@exit:
+				RET
+subs_u_n		ENDP
+				Other_Exit		subs_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		muls_u_n:PROC				; u64 muls_u_n( u64* products, u64* multiplicands, u64* multipliers, u64 count)
+;			muls_u_n		-	saturating multiply of arrays: products [ i ] = multiplicands [ i ] * multipliers [ i ], each clamped at 2^512 - 1
+;			Prototype:		-	u64 muls_u_n( u64* products, u64* multiplicands, u64* multipliers, u64 count);
+;			products		-	Address of count * 8 QWORDS to store results (in RCX)
+;			multiplicands	-	Address of count * 8 QWORDS multiplicands (in RDX)
+;			multipliers		-	Address of count * 8 QWORDS multipliers (in R8)
+;			count			-	Nr of 512 bit elements (in R9)
+;			returns			-	Nr of elements that saturated, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		muls_u_n, ui512
+muls_u_n		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < R12, R13, R14, R15, RBX >
+
+				CheckAlign		RCX, @@exit							; (out) Products
+				CheckAlign		RDX, @@exit							; (in) Multiplicands
+				CheckAlign		R8, @@exit							; (in) Multipliers
+
+				MOV				R12, RCX
+				MOV				R13, RDX
+				MOV				R14, R8
+				MOV				R15, R9
+				XOR				RBX, RBX							; count of saturated results
+				TEST			R15, R15
+				JZ				@@done
+@@:
+				MOV				RCX, R12
+				MOV				RDX, R13
+				MOV				R8, R14
+				CALL			muls_u
+				MOVZX			EAX, AX
+				ADD				RBX, RAX
+				ADD				R12, 64
+				ADD				R13, 64
+				ADD				R14, 64
+				DEC				R15
+				JNZ				@B
+@@done:
+				MOV				RAX, RBX
+@@exit:
+				ReleaseFrame
+				RET
+
+muls_u_n		ENDP
+				Other_Exit		muls_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		sum_u_n:PROC				; u64 sum_u_n( u64* sum, u64* values, u64 count)
+;			sum_u_n			-	sum an array of 512 bit values: sum = values [ 0 ] + ... + values [ count - 1 ]
+;			Prototype:		-	u64 sum_u_n( u64* sum, u64* values, u64 count);
+;			sum				-	Address of 8 QWORDS to store the low 512 bits of the sum (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			returns			-	the bits of the sum above 512 (overflow QWORD), (GP_Fault) for mis-aligned parameter address
+;
+;			Each qword lane is summed on its own, with a per-lane count of the carries out of that lane. No carry chain runs per element;
+;			the carry counts are added in once, one lane up, at the end.
+;
+				Other_Entry		sum_u_n, ui512
+sum_u_n			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			sums [ 8 ] : QWORD
+				LOCAL			carries [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		180h, savedRBP
+
+				CheckAlign		RCX, @@exit							; (out) Sum
+				CheckAlign		RDX, @@exit							; (in) Values
+
+	IF		__UseZ
+				VPXORQ			ZMM0, ZMM0, ZMM0					; lane sums (even elements)
+				VPXORQ			ZMM1, ZMM1, ZMM1					; lane carry counts (even elements)
+				VPXORQ			ZMM2, ZMM2, ZMM2					; lane sums (odd elements)
+				VPXORQ			ZMM3, ZMM3, ZMM3					; lane carry counts (odd elements)
+				MOV				EAX, 1
+				VPBROADCASTQ	ZMM4, RAX							; one, each lane
+				MOV				R9, R8
+				SHR				R9, 1								; pairs of elements, two independent accumulators
+				JZ				@@single
+@@pair:
+				VPADDQ			ZMM0, ZMM0, ZM_PTR [ RDX ]
+				VPCMPUQ			K1, ZMM0, ZM_PTR [ RDX ], CPLT		; lane wrapped if new sum is less than addend
+				VPADDQ			ZMM1 {k1}, ZMM1, ZMM4
+				VPADDQ			ZMM2, ZMM2, ZM_PTR [ RDX ] [ 64 ]
+				VPCMPUQ			K2, ZMM2, ZM_PTR [ RDX ] [ 64 ], CPLT
+				VPADDQ			ZMM3 {k2}, ZMM3, ZMM4
+				ADD				RDX, 128
+				DEC				R9
+				JNZ				@@pair
+@@single:
+				TEST			R8, 1
+				JZ				@@merge
+				VPADDQ			ZMM0, ZMM0, ZM_PTR [ RDX ]
+				VPCMPUQ			K1, ZMM0, ZM_PTR [ RDX ], CPLT
+				VPADDQ			ZMM1 {k1}, ZMM1, ZMM4
+@@merge:
+				VPADDQ			ZMM0, ZMM0, ZMM2
+				VPCMPUQ			K1, ZMM0, ZMM2, CPLT
+				VPADDQ			ZMM1 {k1}, ZMM1, ZMM4
+				VPADDQ			ZMM1, ZMM1, ZMM3
+				VMOVDQA64		ZM_PTR sums, ZMM0
+				VMOVDQA64		ZM_PTR carries, ZMM1
+	ELSE
+				XOR				EAX, EAX
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				sums [ idx * 8 ], RAX
+				MOV				carries [ idx * 8 ], RAX
+				ENDM
+				TEST			R8, R8
+				JZ				@@resolve
+@@element:
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				RAX, Q_PTR [ RDX ] [ idx * 8 ]
+				ADD				sums [ idx * 8 ], RAX
+				ADC				carries [ idx * 8 ], 0
+				ENDM
+				ADD				RDX, 64
+				DEC				R8
+				JNZ				@@element
+	ENDIF
+
+; Resolve: each lane's carry count belongs to the next more significant lane (lower index); lane 0's goes to the overflow QWORD
+@@resolve:
+				MOV				RAX, sums [ 7 * 8 ]
+				MOV				Q_PTR [ RCX ] [ 7 * 8 ], RAX
+				MOV				RAX, sums [ 6 * 8 ]
+				ADD				RAX, carries [ 7 * 8 ]
+				MOV				Q_PTR [ RCX ] [ 6 * 8 ], RAX
+				FOR				idx, < 5, 4, 3, 2, 1, 0 >
+				MOV				RAX, sums [ idx * 8 ]
+				ADC				RAX, carries [ ( idx + 1 ) * 8 ]
+				MOV				Q_PTR [ RCX ] [ idx * 8 ], RAX
+				ENDM
+				MOV				RAX, carries [ 0 * 8 ]
+				ADC				RAX, 0								; return overflow
+@@exit:
+				ReleaseFrame
+				RET
+
+sum_u_n			ENDP
+				Other_Exit		sum_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		argmax_u_n:PROC				; s64 argmax_u_n( u64* values, u64 count)
+;			argmax_u_n		-	index of the largest of an array of 512 bit values (the first, if several are equal)
+;			Prototype:		-	s64 argmax_u_n( u64* values, u64 count);
+;			values			-	Address of count * 8 QWORDS values (in RCX)
+;			count			-	Nr of 512 bit elements (in RDX)
+;			returns			-	index of the largest, (-1) for count of zero, (GP_Fault) for mis-aligned parameter address
+;
+;			Under __UseZ each element is compared to the best so far in all eight lanes at once; the lowest lane (most significant
+;			qword) that differs decides, and the update is a masked move, no branch. Otherwise qwords are compared most significant
+;			first, moving to the next qword only on a tie.
+;
+				Other_Entry		argmax_u_n, ui512
+argmax_u_n		PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (in) Values
+				MOV				RAX, -1
+				TEST			RDX, RDX
+				JZ				@@exit
+				XOR				R8, R8								; index of best so far
+				MOV				R9, 1								; index of candidate
+	IF		__UseZ
+				VMOVDQA64		ZMM0, ZM_PTR [ RCX ]				; best so far
+				JMP				@@test
+@@loop:
+				MOV				R11, R9
+				SHL				R11, 6
+				VMOVDQA64		ZMM1, ZM_PTR [ RCX + R11 ]			; candidate
+				VPCMPUQ			K1, ZMM1, ZMM0, CPGT				; lanes where candidate is greater
+				VPCMPUQ			K2, ZMM1, ZMM0, CPLT				; lanes where candidate is less
+				KMOVB			EAX, K1
+				KMOVB			R10D, K2
+				OR				R10D, EAX							; lanes that differ
+				MOV				R11D, R10D
+				NEG				R11D
+				AND				R10D, R11D							; isolate the most significant differing lane
+				AND				EAX, R10D							; non-zero if candidate is greater
+				CMOVNZ			R8, R9
+				SETNZ			AL
+				NEG				AL
+				KMOVB			K3, EAX								; all lanes, or none
+				VMOVDQA64		ZMM0 {k3}, ZMM1
+				INC				R9
+@@test:
+				CMP				R9, RDX
+				JB				@@loop
+	ELSE
+				MOV				R10, RCX							; address of best so far
+				MOV				R11, RCX							; address of candidate
+				JMP				@@test
+@@loop:
+				ADD				R11, 64
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				RAX, Q_PTR [ R11 ] [ idx * 8 ]
+				CMP				RAX, Q_PTR [ R10 ] [ idx * 8 ]
+				JA				@@take
+				JB				@@next
+				ENDM
+				JMP				@@next								; equal, keep the first
+@@take:
+				MOV				R8, R9
+				MOV				R10, R11
+@@next:
+				INC				R9
+@@test:
+				CMP				R9, RDX
+				JB				@@loop
+	ENDIF
+				MOV				RAX, R8
+@@exit:
+				RET
+argmax_u_n		ENDP
+				Other_Exit		argmax_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		argmin_u_n:PROC				; s64 argmin_u_n( u64* values, u64 count)
+;			argmin_u_n		-	index of the smallest of an array of 512 bit values (the first, if several are equal)
+;			Prototype:		-	s64 argmin_u_n( u64* values, u64 count);
+;			values			-	Address of count * 8 QWORDS values (in RCX)
+;			count			-	Nr of 512 bit elements (in RDX)
+;			returns			-	index of the smallest, (-1) for count of zero, (GP_Fault) for mis-aligned parameter address
+;
+;			As argmax_u_n, with the sense of the compare reversed
+;
+				Other_Entry		argmin_u_n, ui512
+argmin_u_n		PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (in) Values
+				MOV				RAX, -1
+				TEST			RDX, RDX
+				JZ				@@exit
+				XOR				R8, R8								; index of best so far
+				MOV				R9, 1								; index of candidate
+	IF		__UseZ
+				VMOVDQA64		ZMM0, ZM_PTR [ RCX ]				; best so far
+				JMP				@@test
+@@loop:
+				MOV				R11, R9
+				SHL				R11, 6
+				VMOVDQA64		ZMM1, ZM_PTR [ RCX + R11 ]			; candidate
+				VPCMPUQ			K1, ZMM1, ZMM0, CPLT				; lanes where candidate is less
+				VPCMPUQ			K2, ZMM1, ZMM0, CPGT				; lanes where candidate is greater
+				KMOVB			EAX, K1
+				KMOVB			R10D, K2
+				OR				R10D, EAX							; lanes that differ
+				MOV				R11D, R10D
+				NEG				R11D
+				AND				R10D, R11D							; isolate the most significant differing lane
+				AND				EAX, R10D							; non-zero if candidate is less
+				CMOVNZ			R8, R9
+				SETNZ			AL
+				NEG				AL
+				KMOVB			K3, EAX								; all lanes, or none
+				VMOVDQA64		ZMM0 {k3}, ZMM1
+				INC				R9
+@@test:
+				CMP				R9, RDX
+				JB				@@loop
+	ELSE
+				MOV				R10, RCX							; address of best so far
+				MOV				R11, RCX							; address of candidate
+				JMP				@@test
+@@loop:
+				ADD				R11, 64
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				RAX, Q_PTR [ R11 ] [ idx * 8 ]
+				CMP				RAX, Q_PTR [ R10 ] [ idx * 8 ]
+				JB				@@take
+				JA				@@next
+				ENDM
+				JMP				@@next								; equal, keep the first
+@@take:
+				MOV				R8, R9
+				MOV				R10, R11
+@@next:
+				INC				R9
+@@test:
+				CMP				R9, RDX
+				JB				@@loop
+	ENDIF
+				MOV				RAX, R8
+@@exit:
+				RET
+argmin_u_n		ENDP
+				Other_Exit		argmin_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		max_u_n:PROC				; s16 max_u_n( u64* maximum, u64* values, u64 count)
+;			max_u_n			-	copy the largest of an array of 512 bit values
+;			Prototype:		-	s16 max_u_n( u64* maximum, u64* values, u64 count);
+;			maximum			-	Address of 8 QWORDS to store the largest (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			returns			-	(0) for success, (-1) for count of zero (maximum unchanged), (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		max_u_n, ui512
+max_u_n			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD, savedR8 : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+				MOV				savedR8, R8
+
+				CheckAlign		RCX, @@exit							; (out) Maximum
+
+				MOV				RCX, RDX
+				MOV				RDX, R8
+				CALL			argmax_u_n
+				CMP				RAX, savedR8						; an index only if below count: (-1) for empty and GP_Fault are not,
+				JAE				@@exit								;	and are returned as they are
+				MOV				RCX, savedRCX
+				ElemAddr		RDX, savedRDX, RAX
+				Copy512			RCX, RDX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+max_u_n			ENDP
+				Other_Exit		max_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		min_u_n:PROC				; s16 min_u_n( u64* minimum, u64* values, u64 count)
+;			min_u_n			-	copy the smallest of an array of 512 bit values
+;			Prototype:		-	s16 min_u_n( u64* minimum, u64* values, u64 count);
+;			minimum			-	Address of 8 QWORDS to store the smallest (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			returns			-	(0) for success, (-1) for count of zero (minimum unchanged), (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		min_u_n, ui512
+min_u_n			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD, savedR8 : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+				MOV				savedR8, R8
+
+				CheckAlign		RCX, @@exit							; (out) Minimum
+
+				MOV				RCX, RDX
+				MOV				RDX, R8
+				CALL			argmin_u_n
+				CMP				RAX, savedR8						; an index only if below count: (-1) for empty and GP_Fault are not,
+				JAE				@@exit								;	and are returned as they are
+				MOV				RCX, savedRCX
+				ElemAddr		RDX, savedRDX, RAX
+				Copy512			RCX, RDX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+min_u_n			ENDP
+				Other_Exit		min_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		cmp_u_n:PROC				; u64 cmp_u_n( u64* masks, u64* values, u64* bounds, u64 count, u64 predicate)
+;			cmp_u_n			-	compare an array of 512 bit values to a threshold (or to an array of bounds), packing the results as a bitmask
+;			Prototype:		-	u64 cmp_u_n( u64* masks, u64* values, u64* bounds, u64 count, u64 predicate);
+;			masks			-	Address of ( count + 63 ) / 64 QWORDS to receive the bits; bit ( i mod 64 ) of QWORD ( i / 64 ) for value i (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			bounds			-	Address of 8 QWORDS threshold, or count * 8 QWORDS bounds if predicate includes cmp_each (in R8)
+;			count			-	Nr of 512 bit elements (in R9)
+;			predicate		-	CPEQ, CPLT, CPLE, CPNE, CPGE, CPGT (the VPCMPUQ codes), plus cmp_each for per element bounds (stack)
+;			returns			-	Nr of elements for which the predicate holds, (GP_Fault) for mis-aligned values or bounds address
+;
+;			Each element is resolved without a branch on the outcome: greater and less lane masks (most significant qword is the lowest
+;			bit) are reduced to the lowest differing lane, giving less / equal / greater as 0 / 1 / 2, which indexes a three bit truth
+;			table for the predicate. AVX-512 uses VPCMPUQ; AVX2 flips sign bits and uses VPCMPGTQ with VMOVMSKPD; the scalar form compares
+;			most significant qword first.
+;
+				Other_Entry		cmp_u_n, ui512
+cmp_u_n			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+cmpn_pred		EQU				8 + 5 * 8							; stack parameter, as offset from saved RBP
+
+				CreateFrame		100h, savedRBP, < RBX, RSI, RDI, R12, R13, R14 >
+
+				CheckAlign		RDX, @@exit							; (in) Values
+				CheckAlign		R8, @@exit							; (in) Bounds
+
+				MOV				RAX, savedRBP
+				MOV				RAX, Q_PTR [ RAX ] [ cmpn_pred ]
+				XOR				EBX, EBX							; bounds stride: zero for a threshold
+				TEST			EAX, cmp_each
+				JZ				@@threshold
+				MOV				EBX, 64								; or one element per value
+@@threshold:
+				AND				EAX, 7
+				LEA				R10, cmp_truth
+				MOVZX			EDI, B_PTR [ R10 + RAX ]			; truth table bits: less, equal, greater
+				XOR				ESI, ESI							; mask being built
+				XOR				R12D, R12D							; bits in mask
+				XOR				R14D, R14D							; count of true
+				TEST			R9, R9
+				JZ				@@done
+	IF		__UseY
+				MOV				RAX, 8000000000000000h
+				MOVQ			XMM5, RAX
+				VPBROADCASTQ	YMM5, XMM5							; sign bits, for unsigned compare by VPCMPGTQ
+	ENDIF
+
+@@element:
+	IF		__UseZ
+				VMOVDQA64		ZMM0, ZM_PTR [ R8 ]
+				VMOVDQA64		ZMM1, ZM_PTR [ RDX ]
+				VPCMPUQ			K1, ZMM1, ZMM0, CPGT				; lanes greater
+				VPCMPUQ			K2, ZMM1, ZMM0, CPLT				; lanes less
+				KMOVB			EAX, K1
+				KMOVB			R10D, K2
+	ELSEIF	__UseY
+				VPXOR			YMM2, YMM5, YM_PTR [ R8 ] [ 0 * 8 ]	; bound, sign flipped
+				VPXOR			YMM3, YMM5, YM_PTR [ R8 ] [ 4 * 8 ]
+				VPXOR			YMM0, YMM5, YM_PTR [ RDX ] [ 0 * 8 ]	; value, sign flipped
+				VPXOR			YMM1, YMM5, YM_PTR [ RDX ] [ 4 * 8 ]
+				VPCMPGTQ		YMM4, YMM1, YMM3					; lanes greater, qwords 4 - 7
+				VMOVMSKPD		EAX, YMM4
+				SHL				EAX, 4
+				VPCMPGTQ		YMM4, YMM0, YMM2					; lanes greater, qwords 0 - 3
+				VMOVMSKPD		R11D, YMM4
+				OR				EAX, R11D
+				VPCMPGTQ		YMM4, YMM3, YMM1					; lanes less, qwords 4 - 7
+				VMOVMSKPD		R10D, YMM4
+				SHL				R10D, 4
+				VPCMPGTQ		YMM4, YMM2, YMM0					; lanes less, qwords 0 - 3
+				VMOVMSKPD		R11D, YMM4
+				OR				R10D, R11D
+	ENDIF
+	IF		__UseZ OR __UseY
+				MOV				R11D, EAX
+				OR				R11D, R10D							; lanes that differ
+				MOV				R13D, R11D
+				NEG				R13D
+				AND				R11D, R13D							; isolate the most significant differing lane
+				AND				EAX, R11D							; greater: EAX non-zero
+				AND				R10D, R11D							; less: R10D non-zero (at most one of them)
+				CMP				EAX, R10D							; above, below, or equal
+	ELSE
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				RAX, Q_PTR [ RDX ] [ idx * 8 ]
+				CMP				RAX, Q_PTR [ R8 ] [ idx * 8 ]
+				JNE				@@decided
+				ENDM
+	ENDIF
+@@decided:
+				SETA			AL
+				SETB			R10B
+				MOVZX			EAX, AL
+				MOVZX			R10D, R10B
+				SUB				EAX, R10D
+				INC				EAX									; 0 less, 1 equal, 2 greater
+				BT				EDI, EAX
+				SETC			AL
+				MOVZX			EAX, AL
+				ADD				R14, RAX
+				SHR				EAX, 1								; result bit to carry
+				RCR				RSI, 1								; into the top of the mask; 64 of these leave element 0 at bit 0
+				INC				R12D
+				CMP				R12D, 64
+				JNE				@@next
+				MOV				Q_PTR [ RCX ], RSI
+				ADD				RCX, 8
+				XOR				R12D, R12D
+@@next:
+				ADD				RDX, 64
+				ADD				R8, RBX
+				DEC				R9
+				JNZ				@@element
+
+@@done:
+				TEST			R12D, R12D
+				JZ				@@finish
+				MOV				R10, RCX							; partial last mask: shift it down into place
+				MOV				ECX, 64
+				SUB				ECX, R12D
+				SHR				RSI, CL
+				MOV				Q_PTR [ R10 ], RSI
+@@finish:
+				MOV				RAX, R14							; return count of true
+@@exit:
+				ReleaseFrame
+				RET
+
+cmp_u_n			ENDP
+				Other_Exit		cmp_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		msb_uZ:PROC					; s16 msb_uZ( u64* source)
+;			msb_uZ			-	as msb_u: index of the most significant set bit (0 to 511), branch free using VPLZCNTQ (AVX-512 CD)
+;			Prototype:		-	s16 msb_uZ( u64* source);
+;			source			-	Address of 8 QWORDS to examine (in RCX)
+;			returns			-	bit index, (-1) for zero, (GP_Fault) for mis-aligned parameter address
+;
+;			Other than RAX, only R10 and R11 are changed (msb_u callers may rely on R8, R9). Without __UseZ, this is msb_u.
+;
+				Other_Entry		msb_uZ, ui512
+msb_uZ			PROC			PUBLIC
+	IF		__UseZ
+				CheckAlign		RCX, @@exit							; (in) Source
+				MsbZ512			RCX
+@@exit:
+				RET
+	ELSE
+				JMP				msb_u
+	ENDIF
+msb_uZ			ENDP
+				Other_Exit		msb_uZ, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		lsb_uZ:PROC					; s16 lsb_uZ( u64* source)
+;			lsb_uZ			-	as lsb_u: index of the least significant set bit (0 to 511), branch free using VPLZCNTQ (AVX-512 CD)
+;			Prototype:		-	s16 lsb_uZ( u64* source);
+;			source			-	Address of 8 QWORDS to examine (in RCX)
+;			returns			-	bit index, (-1) for zero, (GP_Fault) for mis-aligned parameter address
+;
+;			Other than RAX, only R10 and R11 are changed. Without __UseZ, this is lsb_u.
+;
+				Other_Entry		lsb_uZ, ui512
+lsb_uZ			PROC			PUBLIC
+	IF		__UseZ
+				CheckAlign		RCX, @@exit							; (in) Source
+				LsbZ512			RCX
+@@exit:
+				RET
+	ELSE
+				JMP				lsb_u
+	ENDIF
+lsb_uZ			ENDP
+				Other_Exit		lsb_uZ, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		msb_u_n:PROC				; s16 msb_u_n( s16* results, u64* values, u64 count)
+;			msb_u_n			-	most significant bit index (as msb_u) of each of an array of 512 bit values
+;			Prototype:		-	s16 msb_u_n( s16* results, u64* values, u64 count);
+;			results			-	Address of count WORDS to receive the indexes, -1 for a zero value (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		msb_u_n, ui512
+	IF		__UseZ
+msb_u_n			PROC			PUBLIC
+				CheckAlign		RDX, @@exit							; (in) Values
+				TEST			R8, R8
+				JZ				@@done
+@@:
+				MsbZ512			RDX
+				MOV				W_PTR [ RCX ], AX
+				ADD				RCX, 2
+				ADD				RDX, 64
+				DEC				R8
+				JNZ				@B
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				RET
+	ELSE
+msb_u_n			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < R12, R13, R14 >
+				CheckAlign		RDX, @@exit							; (in) Values
+				MOV				R12, RCX
+				MOV				R13, RDX
+				MOV				R14, R8
+				TEST			R14, R14
+				JZ				@@done
+@@element:
+				MOV				RCX, R13
+				CALL			msb_u
+				MOV				W_PTR [ R12 ], AX
+				ADD				R12, 2
+				ADD				R13, 64
+				DEC				R14
+				JNZ				@@element
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+	ENDIF
+msb_u_n			ENDP
+				Other_Exit		msb_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		lsb_u_n:PROC				; s16 lsb_u_n( s16* results, u64* values, u64 count)
+;			lsb_u_n			-	least significant bit index (as lsb_u) of each of an array of 512 bit values
+;			Prototype:		-	s16 lsb_u_n( s16* results, u64* values, u64 count);
+;			results			-	Address of count WORDS to receive the indexes, -1 for a zero value (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		lsb_u_n, ui512
+	IF		__UseZ
+lsb_u_n			PROC			PUBLIC
+				CheckAlign		RDX, @@exit							; (in) Values
+				TEST			R8, R8
+				JZ				@@done
+@@:
+				LsbZ512			RDX
+				MOV				W_PTR [ RCX ], AX
+				ADD				RCX, 2
+				ADD				RDX, 64
+				DEC				R8
+				JNZ				@B
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				RET
+	ELSE
+lsb_u_n			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < R12, R13, R14 >
+				CheckAlign		RDX, @@exit							; (in) Values
+				MOV				R12, RCX
+				MOV				R13, RDX
+				MOV				R14, R8
+				TEST			R14, R14
+				JZ				@@done
+@@element:
+				MOV				RCX, R13
+				CALL			lsb_u
+				MOV				W_PTR [ R12 ], AX
+				ADD				R12, 2
+				ADD				R13, 64
+				DEC				R14
+				JNZ				@@element
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+	ENDIF
+lsb_u_n			ENDP
+				Other_Exit		lsb_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		limbs_u_n:PROC				; s16 limbs_u_n( s16* results, u64* values, u64 count)
+;			limbs_u_n		-	number of significant qwords (0 to 8) of each of an array of 512 bit values
+;			Prototype:		-	s16 limbs_u_n( s16* results, u64* values, u64 count);
+;			results			-	Address of count WORDS to receive the qword counts, 0 for a zero value (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		limbs_u_n, ui512
+limbs_u_n		PROC			PUBLIC
+				CheckAlign		RDX, @@exit							; (in) Values
+				TEST			R8, R8
+				JZ				@@done
+@@element:
+	IF		__UseZ
+				LimbsZ512		RDX
+	ELSE
+				MOV				EAX, 8
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				CMP				Q_PTR [ RDX ] [ idx * 8 ], 0
+				JNE				@@found
+				DEC				EAX
+				ENDM
+@@found:
+	ENDIF
+				MOV				W_PTR [ RCX ], AX
+				ADD				RCX, 2
+				ADD				RDX, 64
+				DEC				R8
+				JNZ				@@element
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				RET
+limbs_u_n		ENDP
+				Other_Exit		limbs_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			Compact codec: each value packs as a length byte L (0 to 64), then its L significant bytes, least significant byte first.
+;			Zero packs as the single byte 0; a value under 2^128 takes at most 17 bytes. An optional index holds the byte offset of every
+;			K-th entry (entries 0, K, 2K, ...) so one value can be found without decoding from the start (see unpack_at_u).
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		pack_u_n:PROC				; u64 pack_u_n( u8* packed, u64* values, u64 count, u64* index, u64 k)
+;			pack_u_n		-	pack an array of 512 bit values into the compact byte encoding
+;			Prototype:		-	u64 pack_u_n( u8* packed, u64* values, u64 count, u64* index, u64 k);
+;			packed			-	Address of the packed buffer, room for up to count * 65 bytes (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			index			-	Address of ( count + k - 1 ) / k QWORDS to receive entry offsets, or null for no index (in R9)
+;			k				-	index spacing, entries per index QWORD; zero for no index (stack)
+;			returns			-	Nr of bytes packed, (GP_Fault) for mis-aligned values address
+;
+;			Under __UseZ the length is from MsbZ512 and the bytes are stored by one masked VMOVDQU8 after a qword reverse; otherwise
+;			through a little endian copy in the frame and REP MOVSB.
+;
+				Other_Entry		pack_u_n, ui512
+pack_u_n		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			le [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+pack_k			EQU				8 + 5 * 8							; stack parameter, as offset from saved RBP
+
+				CreateFrame		180h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+				MOV				savedRCX, RCX
+
+				CheckAlign		RDX, @@exit							; (in) Values
+
+				MOV				RDI, RCX							; packed cursor
+				MOV				R15, RDX							; values cursor
+				MOV				R12, R8								; remaining
+				MOV				R13, R9								; index cursor
+				MOV				RAX, savedRBP
+				MOV				R14, Q_PTR [ RAX ] [ pack_k ]
+				TEST			R14, R14
+				CMOVZ			R13, R14							; no spacing, no index
+				XOR				EBX, EBX							; entries until the next index QWORD
+	IF		__UseZ
+				VMOVDQA64		ZMM3, ZM_PTR qrev					; qword reversal, for little endian byte order
+	ENDIF
+				TEST			R12, R12
+				JZ				@@done
+
+@@element:
+				TEST			R13, R13
+				JZ				@@packit
+				TEST			RBX, RBX
+				JNZ				@@noentry
+				MOV				RAX, RDI
+				SUB				RAX, savedRCX
+				MOV				Q_PTR [ R13 ], RAX					; offset of this entry
+				ADD				R13, 8
+				MOV				RBX, R14
+@@noentry:
+				DEC				RBX
+@@packit:
+	IF		__UseZ
+				MsbZ512			R15									; msb, and the value in ZMM0
+				ADD				EAX, 8
+				SHR				EAX, 3								; significant bytes: ( msb + 8 ) / 8, zero for zero
+				MOV				B_PTR [ RDI ], AL
+				MOV				ECX, 64
+				SUB				ECX, EAX
+				MOV				R10, -1
+				SHR				R10, CL								; low L bits set ...
+				TEST			EAX, EAX
+				CMOVZ			R10, RAX							; ... none for L of zero
+				KMOVQ			K2, R10
+				VPERMQ			ZMM0, ZMM3, ZMM0					; least significant qword first
+				VMOVDQU8		ZM_PTR [ RDI + 1 ] {k2}, ZMM0
+				LEA				RDI, [ RDI + RAX + 1 ]
+	ELSE
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				RAX, Q_PTR [ R15 ] [ idx * 8 ]
+				MOV				le [ ( 7 - idx ) * 8 ], RAX
+				ENDM
+				MOV				RCX, R15
+				CALL			msb_u
+				MOVSX			EAX, AX
+				ADD				EAX, 8
+				SHR				EAX, 3								; significant bytes: ( msb + 8 ) / 8, zero for zero
+				MOV				B_PTR [ RDI ], AL
+				INC				RDI
+				MOV				ECX, EAX
+				LEA				RSI, le
+				REP MOVSB
+	ENDIF
+				ADD				R15, 64
+				DEC				R12
+				JNZ				@@element
+
+@@done:
+				MOV				RAX, RDI
+				SUB				RAX, savedRCX						; return bytes packed
+@@exit:
+				ReleaseFrame
+				RET
+
+pack_u_n		ENDP
+				Other_Exit		pack_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		unpack_u_n:PROC				; s64 unpack_u_n( u64* values, u8* packed, u64 count)
+;			unpack_u_n		-	unpack count values from the compact byte encoding into an array of 512 bit values
+;			Prototype:		-	s64 unpack_u_n( u64* values, u8* packed, u64 count);
+;			values			-	Address of count * 8 QWORDS to receive the values (in RCX)
+;			packed			-	Address of the first packed entry to decode (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			returns			-	Nr of bytes consumed, (-1) for a length byte over 64, (GP_Fault) for mis-aligned values address
+;
+;			Under __UseZ each entry is one zero masked VMOVDQU8 load (bytes past the entry are not read, so no fault at the buffer end)
+;			and a qword reverse.
+;
+				Other_Entry		unpack_u_n, ui512
+unpack_u_n		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			le [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRDX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		140h, savedRBP, < RSI, RDI, R15 >
+				MOV				savedRDX, RDX
+
+				CheckAlign		RCX, @@exit							; (out) Values
+
+				MOV				R15, RCX							; values cursor
+				MOV				RSI, RDX							; packed cursor
+				MOV				R9, R8								; remaining
+	IF		__UseZ
+				VMOVDQA64		ZMM3, ZM_PTR qrev
+	ENDIF
+				TEST			R9, R9
+				JZ				@@done
+
+@@element:
+				MOVZX			EAX, B_PTR [ RSI ]					; significant bytes
+				CMP				EAX, 64
+				JA				@@corrupt
+	IF		__UseZ
+				MOV				ECX, 64
+				SUB				ECX, EAX
+				MOV				R10, -1
+				SHR				R10, CL
+				TEST			EAX, EAX
+				CMOVZ			R10, RAX
+				KMOVQ			K2, R10
+				VMOVDQU8		ZMM0 {k2}{z}, ZM_PTR [ RSI + 1 ]
+				VPERMQ			ZMM0, ZMM3, ZMM0					; most significant qword first
+				VMOVDQA64		ZM_PTR [ R15 ], ZMM0
+				LEA				RSI, [ RSI + RAX + 1 ]
+	ELSE
+				INC				RSI
+				LEA				RDI, le
+				MOV				ECX, EAX
+				XOR				EAX, EAX
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				le [ idx * 8 ], RAX
+				ENDM
+				REP MOVSB
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				RAX, le [ ( 7 - idx ) * 8 ]
+				MOV				Q_PTR [ R15 ] [ idx * 8 ], RAX
+				ENDM
+	ENDIF
+				ADD				R15, 64
+				DEC				R9
+				JNZ				@@element
+
+@@done:
+				MOV				RAX, RSI
+				SUB				RAX, savedRDX						; return bytes consumed
+				JMP				@@exit
+@@corrupt:
+				MOV				RAX, -1
+@@exit:
+				ReleaseFrame
+				RET
+
+unpack_u_n		ENDP
+				Other_Exit		unpack_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		unpack_at_u:PROC			; s64 unpack_at_u( u64* value, u8* packed, u64* index, u64 k, u64 entry)
+;			unpack_at_u		-	unpack one value from the compact byte encoding, by entry number, using the index from pack_u_n
+;			Prototype:		-	s64 unpack_at_u( u64* value, u8* packed, u64* index, u64 k, u64 entry);
+;			value			-	Address of 8 QWORDS to receive the value (in RCX)
+;			packed			-	Address of the packed buffer (in RDX)
+;			index			-	Address of the index from pack_u_n (in R8)
+;			k				-	index spacing given to pack_u_n, non-zero (in R9)
+;			entry			-	Nr of the entry to unpack (stack)
+;			returns			-	byte offset of the entry, (-1) for k of zero or a bad length byte, (GP_Fault) for mis-aligned value address
+;
+;			Starts at the indexed entry at or before the one wanted and skips at most k - 1 entries by their length bytes alone.
+;
+				Other_Entry		unpack_at_u, ui512
+unpack_at_u		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+unpk_entry		EQU				8 + 5 * 8							; stack parameter, as offset from saved RBP
+
+				CreateFrame		100h, savedRBP, < R12 >
+				MOV				savedRCX, RCX
+
+				CheckAlign		RCX, @@exit							; (out) Value
+
+				MOV				R12, RDX
+				MOV				RAX, -1
+				TEST			R9, R9
+				JZ				@@exit
+				MOV				R10, RDX
+				MOV				RAX, savedRBP
+				MOV				RAX, Q_PTR [ RAX ] [ unpk_entry ]
+				XOR				EDX, EDX
+				DIV				R9									; RAX: index entry, RDX: entries to skip past it
+				MOV				RAX, Q_PTR [ R8 + RAX * 8 ]
+				ADD				R10, RAX
+				TEST			RDX, RDX
+				JZ				@@found
+@@skip:
+				MOVZX			EAX, B_PTR [ R10 ]
+				LEA				R10, [ R10 + RAX + 1 ]
+				DEC				RDX
+				JNZ				@@skip
+@@found:
+				SUB				R12, R10
+				NEG				R12									; offset of the entry
+				MOV				RCX, savedRCX
+				MOV				RDX, R10
+				MOV				R8D, 1
+				CALL			unpack_u_n
+				TEST			RAX, RAX
+				JS				@@exit								; bad length byte
+				MOV				RAX, R12							; return offset of the entry
+@@exit:
+				ReleaseFrame
+				RET
+
+unpack_at_u		ENDP
+				Other_Exit		unpack_at_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			Delta (frame of reference) codec for sorted arrays. Values are cut into blocks of dtab_block entries; each block packs its first
+;			value in full, then each difference from the one before, all in the pack_u_n form. A table (dtab_*, 8 QWORDS) holds the
+;			caller's buffers: packed bytes, one byte offset per block, and optionally the min and max of each block (2 x 8 QWORDS per block)
+;			used to skip blocks when searching. Only the block holding a searched value is decoded.
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		delta_pack_u:PROC			; s64 delta_pack_u( u64* tab, u64* values, u64 count)
+;			delta_pack_u	-	pack a sorted (non-decreasing) array of 512 bit values as blocks of differences
+;			Prototype:		-	s64 delta_pack_u( u64* tab, u64* values, u64 count);
+;			tab				-	Address of delta table, dtab_packed, dtab_offsets, dtab_bounds (or null) and dtab_block set by caller (in RCX)
+;			values			-	Address of count * 8 QWORDS sorted values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			returns			-	Nr of bytes packed (also set in dtab_bytes, with dtab_count), (-1) for block of zero or values out of order,
+;								(GP_Fault) for mis-aligned values or bounds address
+;
+				Other_Entry		delta_pack_u, ui512
+delta_pack_u	PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			diff [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		180h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+
+				CheckAlign		RDX, @@exit							; (in) Values
+
+				MOV				RBX, RCX
+				MOV				R12, RDX							; values cursor
+				MOV				R13, R8								; remaining
+				MOV				RAX, -1
+				CMP				Q_PTR [ RBX ] [ dtab_block ], 0
+				JE				@@exit
+				MOV				Q_PTR [ RBX ] [ dtab_count ], R13
+				MOV				R14, Q_PTR [ RBX ] [ dtab_packed ]	; packed cursor
+				MOV				RDI, Q_PTR [ RBX ] [ dtab_offsets ]	; offsets cursor
+				MOV				RSI, Q_PTR [ RBX ] [ dtab_bounds ]	; bounds cursor, or null
+				CheckAlign		RSI, @@exit							; (out) Bounds
+				XOR				R15, R15							; position in block
+				TEST			R13, R13
+				JZ				@@done
+
+@@element:
+				TEST			R15, R15
+				JNZ				@@delta
+				MOV				RAX, R14							; block start: offset, min, and the value in full
+				SUB				RAX, Q_PTR [ RBX ] [ dtab_packed ]
+				MOV				Q_PTR [ RDI ], RAX
+				ADD				RDI, 8
+				TEST			RSI, RSI
+				JZ				@@base
+				Copy512			RSI, R12
+@@base:
+				MOV				RDX, R12
+				JMP				@@pack
+@@delta:
+				LEA				RCX, diff							; difference from the one before
+				MOV				RDX, R12
+				LEA				R8, [ R12 - 64 ]
+				CALL			sub_u
+				TEST			AX, AX
+				JNZ				@@unsorted
+				LEA				RDX, diff
+@@pack:
+				MOV				RCX, R14
+				MOV				R8D, 1
+				XOR				R9D, R9D							; no index
+				MOV				Q_PTR [ RSP ] [ 4 * 8 ], R9
+				CALL			pack_u_n
+				ADD				R14, RAX
+
+				INC				R15
+				CMP				R15, Q_PTR [ RBX ] [ dtab_block ]
+				JE				@@blockend
+				CMP				R13, 1
+				JNE				@@advance
+@@blockend:
+				TEST			RSI, RSI							; block end: max
+				JZ				@@nobounds
+				LEA				RCX, [ RSI + 64 ]
+				Copy512			RCX, R12
+				ADD				RSI, 128
+@@nobounds:
+				XOR				R15, R15
+@@advance:
+				ADD				R12, 64
+				DEC				R13
+				JNZ				@@element
+
+@@done:
+				MOV				RAX, R14
+				SUB				RAX, Q_PTR [ RBX ] [ dtab_packed ]
+				MOV				Q_PTR [ RBX ] [ dtab_bytes ], RAX	; return bytes packed
+				JMP				@@exit
+@@unsorted:
+				MOV				RAX, -1
+@@exit:
+				ReleaseFrame
+				RET
+
+delta_pack_u	ENDP
+				Other_Exit		delta_pack_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		delta_unpack_block_u:PROC	; s64 delta_unpack_block_u( u64* values, u64* tab, u64 block)
+;			delta_unpack_block_u	-	decode one block of a delta table: unpack, then a running (prefix) add
+;			Prototype:		-	s64 delta_unpack_block_u( u64* values, u64* tab, u64 block);
+;			values			-	Address of up to dtab_block * 8 QWORDS to receive the values (in RCX)
+;			tab				-	Address of delta table from delta_pack_u (in RDX)
+;			block			-	Nr of the block to decode (in R8)
+;			returns			-	Nr of values decoded, (-1) for a block number out of range or a bad packed length byte,
+;								(GP_Fault) for mis-aligned values address
+;
+				Other_Entry		delta_unpack_block_u, ui512
+delta_unpack_block_u	PROC	PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < RBX, R12, R13 >
+
+				CheckAlign		RCX, @@exit							; (out) Values
+
+				MOV				R12, RCX
+				MOV				RBX, RDX
+				MOV				RAX, Q_PTR [ RBX ] [ dtab_block ]
+				MUL				R8									; first entry of the block
+				MOV				R13, Q_PTR [ RBX ] [ dtab_count ]
+				SUB				R13, RAX							; entries from there to the end
+				MOV				RAX, -1
+				JBE				@@exit								; none: out of range
+				CMP				R13, Q_PTR [ RBX ] [ dtab_block ]
+				CMOVA			R13, Q_PTR [ RBX ] [ dtab_block ]	; entries in this block
+				MOV				RDX, Q_PTR [ RBX ] [ dtab_offsets ]
+				MOV				RDX, Q_PTR [ RDX + R8 * 8 ]
+				ADD				RDX, Q_PTR [ RBX ] [ dtab_packed ]
+				MOV				RCX, R12
+				MOV				R8, R13
+				CALL			unpack_u_n
+				TEST			RAX, RAX
+				JS				@@exit
+
+; Running add: values [ i ] += values [ i - 1 ]
+				MOV				R10, R12
+				MOV				R11, R13
+				DEC				R11
+				JZ				@@done
+@@:
+				ADD				R10, 64
+				MOV				RAX, Q_PTR [ R10 ] [ 7 * 8 ]
+				ADD				RAX, Q_PTR [ R10 ] [ 7 * 8 - 64 ]
+				MOV				Q_PTR [ R10 ] [ 7 * 8 ], RAX
+				FOR				idx, < 6, 5, 4, 3, 2, 1, 0 >
+				MOV				RAX, Q_PTR [ R10 ] [ idx * 8 ]
+				ADC				RAX, Q_PTR [ R10 ] [ idx * 8 - 64 ]
+				MOV				Q_PTR [ R10 ] [ idx * 8 ], RAX
+				ENDM
+				DEC				R11
+				JNZ				@B
+@@done:
+				MOV				RAX, R13							; return values decoded
+@@exit:
+				ReleaseFrame
+				RET
+
+delta_unpack_block_u	ENDP
+				Other_Exit		delta_unpack_block_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		delta_lower_bound_u:PROC	; s64 delta_lower_bound_u( u64* result, u64* tab, u64* key, u64* scratch)
+;			delta_lower_bound_u	-	find the first value not less than key in a delta table, decoding only the block that holds it
+;			Prototype:		-	s64 delta_lower_bound_u( u64* result, u64* tab, u64* key, u64* scratch);
+;			result			-	Address of 8 QWORDS to receive the value found (unchanged if none) (in RCX)
+;			tab				-	Address of delta table from delta_pack_u, with bounds (in RDX)
+;			key				-	Address of 8 QWORDS key (in R8)
+;			scratch			-	Address of dtab_block * 8 QWORDS work area (in R9)
+;			returns			-	index of the value found, dtab_count if all are less than key, (-1) if the table has no bounds,
+;								(GP_Fault) for mis-aligned parameter address
+;
+;			Binary search of the block maxima picks the block; it is decoded and scanned.
+;
+				Other_Entry		delta_lower_bound_u, ui512
+delta_lower_bound_u	PROC		PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			mid : QWORD, blocks : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		140h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+
+				CheckAlign		RCX, @@exit							; (out) Result
+				CheckAlign		R8, @@exit							; (in) Key
+				CheckAlign		R9, @@exit							; (in) Scratch
+
+				MOV				R12, RCX
+				MOV				RBX, RDX
+				MOV				R13, R8
+				MOV				R14, R9
+				MOV				RSI, Q_PTR [ RBX ] [ dtab_bounds ]
+				MOV				RAX, -1
+				TEST			RSI, RSI
+				JZ				@@exit
+
+				MOV				RAX, Q_PTR [ RBX ] [ dtab_count ]	; number of blocks: ( count + block - 1 ) / block
+				ADD				RAX, Q_PTR [ RBX ] [ dtab_block ]
+				DEC				RAX
+				XOR				EDX, EDX
+				DIV				Q_PTR [ RBX ] [ dtab_block ]
+				MOV				blocks, RAX
+				MOV				RDI, RAX							; hi
+				XOR				R15, R15							; lo
+@@search:
+				CMP				R15, RDI
+				JAE				@@searched
+				LEA				RAX, [ R15 + RDI ]
+				SHR				RAX, 1
+				MOV				mid, RAX
+				SHL				RAX, 7
+				LEA				RCX, [ RSI + RAX + 64 ]				; max of block mid
+				MOV				RDX, R13
+				CALL			compare_u
+				CMP				AX, 0
+				MOV				RAX, mid							; (MOV leaves the flags alone)
+				JGE				@@upper
+				LEA				R15, [ RAX + 1 ]					; max less than key: look above
+				JMP				@@search
+@@upper:
+				MOV				RDI, RAX							; else this block or one below
+				JMP				@@search
+@@searched:
+				MOV				RAX, Q_PTR [ RBX ] [ dtab_count ]	; past the last block: none
+				CMP				R15, blocks
+				JE				@@exit
+				MOV				RCX, R14
+				MOV				RDX, RBX
+				MOV				R8, R15
+				CALL			delta_unpack_block_u
+				TEST			RAX, RAX
+				JS				@@exit
+				MOV				RDI, R14							; scan the block: its max is not less than key, so one will be found
+@@scan:
+				MOV				RCX, RDI
+				MOV				RDX, R13
+				CALL			compare_u
+				CMP				AX, 0
+				JGE				@@found
+				ADD				RDI, 64
+				JMP				@@scan
+@@found:
+				Copy512			R12, RDI
+				MOV				RAX, R15
+				MUL				Q_PTR [ RBX ] [ dtab_block ]
+				SUB				RDI, R14
+				SHR				RDI, 6
+				ADD				RAX, RDI							; return index
+@@exit:
+				ReleaseFrame
+				RET
+
+delta_lower_bound_u	ENDP
+				Other_Exit		delta_lower_bound_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		store_u:PROC				; s16 store_u( u64* cell, u64* value)
+;			store_u			-	publish value into a seqlock cell (one writer per cell; readers use load_u)
+;			Prototype:		-	s16 store_u( u64* cell, u64* value);
+;			cell			-	Address of 16 QWORDS cell, aligned 64 (in RCX): sequence in the first cache line, value in the second
+;			value			-	Address of 8 QWORDS value (in RDX)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			The sequence is made odd, the value stored, then the sequence made even. x64 does not reorder stores with other stores,
+;			so a reader that sees an even sequence before and after its copy has seen no part of a store. No fence is needed;
+;			two writers to one cell must be serialized by the caller.
+;
+				Other_Entry		store_u, ui512
+store_u			PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Cell
+				CheckAlign		RDX, @@exit							; (in) Value
+				MOV				R8, Q_PTR [ RCX ] [ cell_seq ]
+				INC				R8									; odd: store in progress
+				MOV				Q_PTR [ RCX ] [ cell_seq ], R8
+				LEA				R10, [ RCX ] [ cell_value ]
+				Copy512			R10, RDX
+				INC				R8									; even: value published
+				MOV				Q_PTR [ RCX ] [ cell_seq ], R8
+				XOR				EAX, EAX
+@@exit:
+				RET
+store_u			ENDP
+				Other_Exit		store_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		load_u:PROC					; s16 load_u( u64* value, u64* cell)
+;			load_u			-	read a consistent value from a seqlock cell written by store_u, without locking
+;			Prototype:		-	s16 load_u( u64* value, u64* cell);
+;			value			-	Address of 8 QWORDS to receive the value (in RCX)
+;			cell			-	Address of 16 QWORDS cell, aligned 64 (in RDX)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			Reads the sequence, copies the value, reads the sequence again; retries while the sequence is odd or has changed.
+;			x64 does not reorder loads with other loads, so the copy falls between the two reads of the sequence without a fence.
+;
+				Other_Entry		load_u, ui512
+load_u			PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Value
+				CheckAlign		RDX, @@exit							; (in) Cell
+				LEA				R10, [ RDX ] [ cell_value ]
+				JMP				@@read
+@@busy:
+				PAUSE												; store in progress: wait
+@@read:
+				MOV				R8, Q_PTR [ RDX ] [ cell_seq ]
+				TEST			R8, 1
+				JNZ				@@busy
+				Copy512			RCX, R10
+				MOV				R9, Q_PTR [ RDX ] [ cell_seq ]
+				CMP				R8, R9
+				JNE				@@read								; changed during the copy: again
+				XOR				EAX, EAX
+@@exit:
+				RET
+load_u			ENDP
+				Other_Exit		load_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		add_u_idx:PROC				; u64 add_u_idx( u64* sums, u64* res_idx, u64* lh_table, u64* lh_idx, u64* rh_table, u64* rh_idx, u64 count)
+;			add_u_idx		-	add operands selected by index: sums [ i or res_idx [ i ] ] = lh_table [ lh_idx [ i ] ] + rh_table [ rh_idx [ i ] ]
+;			Prototype:		-	u64 add_u_idx( u64* sums, u64* res_idx, u64* lh_table, u64* lh_idx, u64* rh_table, u64* rh_idx, u64 count);
+;			sums			-	Address of 512 bit results (in RCX): dense (count elements), or scattered by res_idx
+;			res_idx			-	Address of count QWORD indexes into sums, or null to store densely (in RDX)
+;			lh_table		-	Address of 512 bit table of left operands (in R8)
+;			lh_idx			-	Address of count QWORD indexes into lh_table (in R9)
+;			rh_table		-	Address of 512 bit table of right operands (stack)
+;			rh_idx			-	Address of count QWORD indexes into rh_table (stack)
+;			count			-	Nr of elements (stack)
+;			returns			-	Nr of sums that carried out, (GP_Fault) for mis-aligned sums or table address
+;
+;			Operands of element i + idx_ahead are prefetched while element i is added (see IdxPrefetch), so table misses overlap
+;			with work rather than stalling it. Tables may be the same, and indexes may repeat.
+;
+				Other_Entry		add_u_idx, ui512
+add_u_idx		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			cnt : QWORD, carries : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+addx_rhtab		EQU				8 + 5 * 8							; stack parameters, as offsets from saved RBP
+addx_rhidx		EQU				8 + 6 * 8
+addx_count		EQU				8 + 7 * 8
+
+				CreateFrame		140h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+
+				MOV				RDI, RCX							; sums
+				MOV				RSI, RDX							; result indexes, or null
+				MOV				R12, R8								; left table
+				MOV				R13, R9								; left indexes
+				MOV				RAX, savedRBP
+				MOV				R14, Q_PTR [ RAX ] [ addx_rhtab ]	; right table
+				MOV				R15, Q_PTR [ RAX ] [ addx_rhidx ]	; right indexes
+				MOV				RAX, Q_PTR [ RAX ] [ addx_count ]
+				MOV				cnt, RAX
+				CheckAlign		RDI, @@exit							; (out) Sums
+				CheckAlign		R12, @@exit							; (in) Left table
+				CheckAlign		R14, @@exit							; (in) Right table
+
+				XOR				EBX, EBX							; element
+				MOV				carries, RBX
+				CMP				RBX, cnt
+				JAE				@@done
+@@element:
+				IdxPrefetch		RBX, cnt, R12, R13, R14, R15, RDI, RSI
+				MOV				RCX, RBX							; dense
+				TEST			RSI, RSI
+				JZ				@@dense
+				MOV				RCX, Q_PTR [ RSI ] [ RBX * 8 ]		; or scattered
+@@dense:
+				SHL				RCX, 6
+				ADD				RCX, RDI
+				ElemAddr		RDX, R12, < Q_PTR [ R13 ] [ RBX * 8 ] >
+				ElemAddr		R8, R14, < Q_PTR [ R15 ] [ RBX * 8 ] >
+				CALL			add_u
+				MOVZX			EAX, AX
+				ADD				carries, RAX
+				INC				RBX
+				CMP				RBX, cnt
+				JB				@@element
+@@done:
+				MOV				RAX, carries
+@@exit:
+				ReleaseFrame
+				RET
+add_u_idx		ENDP
+				Other_Exit		add_u_idx, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mult_u_idx:PROC				; s16 mult_u_idx( u64* products, u64* overflows, u64* res_idx, u64* lh_table, u64* lh_idx, u64* rh_table, u64* rh_idx, u64 count)
+;			mult_u_idx		-	multiply operands selected by index: products (and overflows) [ i or res_idx [ i ] ] = lh_table [ lh_idx [ i ] ] * rh_table [ rh_idx [ i ] ]
+;			Prototype:		-	s16 mult_u_idx( u64* products, u64* overflows, u64* res_idx, u64* lh_table, u64* lh_idx, u64* rh_table, u64* rh_idx, u64 count);
+;			products		-	Address of 512 bit products (in RCX): dense (count elements), or scattered by res_idx
+;			overflows		-	Address of 512 bit overflows (in RDX), placed as the products
+;			res_idx			-	Address of count QWORD indexes into products and overflows, or null to store densely (in R8)
+;			lh_table		-	Address of 512 bit table of multiplicands (in R9)
+;			lh_idx			-	Address of count QWORD indexes into lh_table (stack)
+;			rh_table		-	Address of 512 bit table of multipliers (stack)
+;			rh_idx			-	Address of count QWORD indexes into rh_table (stack)
+;			count			-	Nr of elements (stack)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned products, overflows or table address
+;
+				Other_Entry		mult_u_idx, ui512
+mult_u_idx		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			cnt : QWORD, overflows : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+mulx_lhidx		EQU				8 + 5 * 8							; stack parameters, as offsets from saved RBP
+mulx_rhtab		EQU				8 + 6 * 8
+mulx_rhidx		EQU				8 + 7 * 8
+mulx_count		EQU				8 + 8 * 8
+
+				CreateFrame		140h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+
+				MOV				RDI, RCX							; products
+				MOV				overflows, RDX
+				MOV				RSI, R8								; result indexes, or null
+				MOV				R12, R9								; left table
+				MOV				RAX, savedRBP
+				MOV				R13, Q_PTR [ RAX ] [ mulx_lhidx ]	; left indexes
+				MOV				R14, Q_PTR [ RAX ] [ mulx_rhtab ]	; right table
+				MOV				R15, Q_PTR [ RAX ] [ mulx_rhidx ]	; right indexes
+				MOV				RAX, Q_PTR [ RAX ] [ mulx_count ]
+				MOV				cnt, RAX
+				CheckAlign		RDI, @@exit							; (out) Products
+				CheckAlign		RDX, @@exit							; (out) Overflows
+				CheckAlign		R12, @@exit							; (in) Left table
+				CheckAlign		R14, @@exit							; (in) Right table
+
+				XOR				EBX, EBX							; element
+				CMP				RBX, cnt
+				JAE				@@done
+@@element:
+				IdxPrefetch		RBX, cnt, R12, R13, R14, R15, RDI, RSI
+				MOV				RCX, RBX							; dense
+				TEST			RSI, RSI
+				JZ				@@dense
+				MOV				RCX, Q_PTR [ RSI ] [ RBX * 8 ]		; or scattered
+@@dense:
+				SHL				RCX, 6
+				MOV				RDX, overflows
+				ADD				RDX, RCX
+				ADD				RCX, RDI
+				ElemAddr		R8, R12, < Q_PTR [ R13 ] [ RBX * 8 ] >
+				ElemAddr		R9, R14, < Q_PTR [ R15 ] [ RBX * 8 ] >
+				CALL			mult_u
+				INC				RBX
+				CMP				RBX, cnt
+				JB				@@element
+@@done:
+				XOR				EAX, EAX
+@@exit:
+				ReleaseFrame
+				RET
+mult_u_idx		ENDP
+				Other_Exit		mult_u_idx, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		cmp_u_idx:PROC				; u64 cmp_u_idx( u64* masks, u64* lh_table, u64* lh_idx, u64* rh_table, u64* rh_idx, u64 count, u64 predicate)
+;			cmp_u_idx		-	compare operands selected by index, packing the results as a bitmask (as cmp_u_n)
+;			Prototype:		-	u64 cmp_u_idx( u64* masks, u64* lh_table, u64* lh_idx, u64* rh_table, u64* rh_idx, u64 count, u64 predicate);
+;			masks			-	Address of ( count + 63 ) / 64 QWORDS to receive the bits; bit ( i mod 64 ) of QWORD ( i / 64 ) for element i (in RCX)
+;			lh_table		-	Address of 512 bit table of left operands (in RDX)
+;			lh_idx			-	Address of count QWORD indexes into lh_table (in R8)
+;			rh_table		-	Address of 512 bit table of right operands (in R9)
+;			rh_idx			-	Address of count QWORD indexes into rh_table (stack)
+;			count			-	Nr of elements (stack)
+;			predicate		-	CPEQ, CPLT, CPLE, CPNE, CPGE, CPGT (the VPCMPUQ codes): lh_table [ lh_idx [ i ] ] predicate rh_table [ rh_idx [ i ] ] (stack)
+;			returns			-	Nr of elements for which the predicate holds, (GP_Fault) for mis-aligned table address
+;
+				Other_Entry		cmp_u_idx, ui512
+cmp_u_idx		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			cnt : QWORD, matches : QWORD, truth : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+cmpx_rhidx		EQU				8 + 5 * 8							; stack parameters, as offsets from saved RBP
+cmpx_count		EQU				8 + 6 * 8
+cmpx_pred		EQU				8 + 7 * 8
+
+				CreateFrame		140h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+
+				MOV				RDI, RCX							; masks
+				MOV				R12, RDX							; left table
+				MOV				R13, R8								; left indexes
+				MOV				R14, R9								; right table
+				MOV				RAX, savedRBP
+				MOV				R15, Q_PTR [ RAX ] [ cmpx_rhidx ]	; right indexes
+				MOV				RCX, Q_PTR [ RAX ] [ cmpx_count ]
+				MOV				cnt, RCX
+				MOV				RAX, Q_PTR [ RAX ] [ cmpx_pred ]
+				AND				EAX, 7
+				LEA				R10, cmp_truth
+				MOVZX			EAX, B_PTR [ R10 + RAX ]			; truth table bits: less, equal, greater
+				MOV				truth, RAX
+				CheckAlign		R12, @@exit							; (in) Left table
+				CheckAlign		R14, @@exit							; (in) Right table
+
+				XOR				EBX, EBX							; element
+				XOR				ESI, ESI							; mask being built
+				MOV				matches, RBX
+				CMP				RBX, cnt
+				JAE				@@done
+@@element:
+				IdxPrefetch		RBX, cnt, R12, R13, R14, R15
+				ElemAddr		RCX, R12, < Q_PTR [ R13 ] [ RBX * 8 ] >
+				ElemAddr		RDX, R14, < Q_PTR [ R15 ] [ RBX * 8 ] >
+				CALL			compare_u
+				MOVSX			ECX, AX
+				INC				ECX									; 0 less, 1 equal, 2 greater
+				MOV				RAX, truth
+				SHR				EAX, CL
+				AND				EAX, 1								; predicate holds?
+				ADD				matches, RAX
+				MOV				ECX, EBX
+				AND				ECX, 63
+				SHL				RAX, CL
+				OR				RSI, RAX
+				CMP				ECX, 63
+				JNE				@@next
+				MOV				RAX, RBX
+				SHR				RAX, 6
+				MOV				Q_PTR [ RDI ] [ RAX * 8 ], RSI		; full mask QWORD
+				XOR				ESI, ESI
+@@next:
+				INC				RBX
+				CMP				RBX, cnt
+				JB				@@element
+				TEST			BL, 63
+				JZ				@@done
+				MOV				RAX, RBX
+				SHR				RAX, 6
+				MOV				Q_PTR [ RDI ] [ RAX * 8 ], RSI		; last, partial mask QWORD
+@@done:
+				MOV				RAX, matches
+@@exit:
+				ReleaseFrame
+				RET
+cmp_u_idx		ENDP
+				Other_Exit		cmp_u_idx, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		exp_plan_u:PROC				; s16 exp_plan_u( u64* plan, u64* exponent)
+;			exp_plan_u		-	plan exponentiation by a fixed exponent: choose a sliding window, and record the steps for exp_exec_u
+;			Prototype:		-	s16 exp_plan_u( u64* plan, u64* exponent);
+;			plan			-	Address of eplan_size bytes (144 QWORDS) to receive the plan (in RCX)
+;			exponent		-	Address of 8 QWORDS exponent (in RDX)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			Left to right sliding window recoding: each window is at most w bits and ends in a one, so it is an odd digit d, met by
+;			squaring the accumulator once per bit (and once per zero between windows) then multiplying by base^d from a table of odd
+;			powers. Each width 1 to eplan_maxw is costed (squarings, multiplies, and building its table) and the cheapest recorded.
+;			The plan holds no addresses, so it may be saved and reloaded; layout (offsets in ui512mdMacros.inc):
+;				eplan_tag		QWORD		eplan_magic, checked by exp_exec_u
+;				eplan_window	QWORD		window width w: the table is base^1, base^3, .. base^(2^w - 1)
+;				eplan_steps		QWORD		number of steps (zero for a zero exponent)
+;				eplan_bits		QWORD		bit length of the exponent
+;				eplan_sqrs		QWORD		squarings in the steps
+;				eplan_muls		QWORD		multiplies in the steps and in building the table
+;				eplan_step0		WORDS		the steps: squarings (bits 0 - 9), then table entry to multiply by (bits 10 - 15, eplan_nodigit for none).
+;											The first step loads its entry, with no squaring.
+;
+				Other_Entry		exp_plan_u, ui512
+exp_plan_u		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			top : QWORD, emit : QWORD, sqrs : QWORD, best_cost : QWORD, best_w : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		140h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+
+				MOV				RDI, RCX							; plan
+				MOV				RBX, RDX							; exponent
+				CheckAlign		RDI, @@exit							; (out) Plan
+				CheckAlign		RBX, @@exit							; (in) Exponent
+
+				XOR				EAX, EAX
+				FOR				idx, < 1, 2, 3, 4, 5, 6, 7 >
+				MOV				Q_PTR [ RDI ] [ idx * 8 ], RAX
+				ENDM
+				MOV				RAX, eplan_magic
+				MOV				Q_PTR [ RDI ] [ eplan_tag ], RAX
+				MOV				Q_PTR [ RDI ] [ eplan_window ], 1
+				MOV				RCX, RBX
+				CALL			msb_u								; leading bit of exponent
+				MOVSX			RAX, AX
+				MOV				top, RAX
+				INC				RAX
+				MOV				Q_PTR [ RDI ] [ eplan_bits ], RAX
+				JZ				@@done								; exponent zero? no steps, result is one
+
+; Recode once per width, counting; then again with the cheapest width, writing the steps
+				MOV				emit, 0
+				MOV				best_cost, -1
+				MOV				best_w, 1
+				MOV				R13, 1								; window width
+@@window:
+				XOR				ESI, ESI							; windows (digits)
+				XOR				R14D, R14D							; zeros since the last window
+				XOR				R15D, R15D							; steps
+				MOV				sqrs, R15
+				MOV				R12, top							; bit i
+@@scan:
+				TEST			R12, R12
+				JS				@@scanned
+				BitCF512		RBX, R12
+				JC				@@open
+				INC				R14									; zero: one more squaring
+				DEC				R12
+				JMP				@@scan
+@@open:
+				MOV				R11, R12							; window i .. j: j = max( i - w + 1, 0 ), raised to a one bit
+				SUB				R11, R13
+				INC				R11
+				XOR				EAX, EAX
+				TEST			R11, R11
+				CMOVS			R11, RAX
+@@trim:
+				BitCF512		RBX, R11
+				JC				@@digit
+				INC				R11
+				JMP				@@trim
+@@digit:
+				XOR				R8D, R8D							; d = bits i .. j
+				MOV				R9, R12
+@@dbits:
+				BitCF512		RBX, R9
+				ADC				R8, R8
+				DEC				R9
+				CMP				R9, R11
+				JGE				@@dbits
+				MOV				RAX, R12
+				SUB				RAX, R11
+				INC				RAX									; squarings: the window's bits
+				ADD				RAX, R14							; and the zeros before it
+				TEST			RSI, RSI
+				JNZ				@@squares
+				XOR				EAX, EAX							; first window: loaded from the table
+@@squares:
+				ADD				sqrs, RAX
+				CMP				emit, 0
+				JE				@@counted
+				SHR				R8, 1								; table entry of odd digit d
+				SHL				R8, eplan_dshift
+				OR				RAX, R8
+				MOV				W_PTR [ RDI ] [ R15 * 2 ] [ eplan_step0 ], AX
+@@counted:
+				INC				R15
+				INC				RSI
+				XOR				R14D, R14D
+				LEA				R12, [ R11 - 1 ]
+				JMP				@@scan
+
+@@scanned:
+				TEST			R14, R14							; trailing zeros: squarings only
+				JZ				@@tally
+				ADD				sqrs, R14
+				CMP				emit, 0
+				JE				@@trailing
+				MOV				RAX, R14
+				OR				RAX, eplan_nodigit
+				MOV				W_PTR [ RDI ] [ R15 * 2 ] [ eplan_step0 ], AX
+@@trailing:
+				INC				R15
+@@tally:
+				XOR				EAX, EAX							; table: none for w = 1,
+				CMP				R13, 1
+				JE				@@muls
+				LEA				RCX, [ R13 - 1 ]
+				MOV				EAX, 1
+				SHL				RAX, CL								; else base^2 and 2^(w-1) - 1 multiplies
+@@muls:
+				LEA				RAX, [ RAX + RSI - 1 ]				; plus one multiply per window after the first
+				CMP				emit, 0
+				JNE				@@emitted
+				MOV				RCX, RAX
+				ADD				RCX, sqrs
+				CMP				RCX, best_cost
+				JAE				@@wider
+				MOV				best_cost, RCX
+				MOV				best_w, R13
+@@wider:
+				INC				R13
+				CMP				R13, eplan_maxw
+				JBE				@@window
+				MOV				R13, best_w
+				MOV				emit, 1
+				JMP				@@window
+
+@@emitted:
+				MOV				Q_PTR [ RDI ] [ eplan_muls ], RAX
+				MOV				RAX, sqrs
+				MOV				Q_PTR [ RDI ] [ eplan_sqrs ], RAX
+				MOV				Q_PTR [ RDI ] [ eplan_window ], R13
+				MOV				Q_PTR [ RDI ] [ eplan_steps ], R15
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+exp_plan_u		ENDP
+				Other_Exit		exp_plan_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		exp_exec_u:PROC				; s16 exp_exec_u( u64* result, u64* base, u64* plan, u64* ctx)
+;			exp_exec_u		-	raise base (Montgomery form) to the exponent of a plan from exp_plan_u, giving result (Montgomery form)
+;			Prototype:		-	s16 exp_exec_u( u64* result, u64* base, u64* plan, u64* ctx);
+;			result			-	Address of 8 QWORDS to store result (in RCX)
+;			base			-	Address of 8 QWORDS base, Montgomery form (in RDX)
+;			plan			-	Address of plan from exp_plan_u (in R8)
+;			ctx				-	Address of Montgomery context from mont_setup_u (in R9)
+;			returns			-	(0) for success, -1 for a plan that is not from exp_plan_u (result unchanged), (GP_Fault) for mis-aligned parameter address
+;
+;			Same result as mont_pow_u with the plan's exponent; a plan may serve any base and any modulus.
+;
+				Other_Entry		exp_exec_u, ui512
+exp_exec_u		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			tbl [ 256 ] : QWORD, acc [ 8 ] : QWORD	; odd powers of base, up to 32
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedR9 : QWORD
+				LOCAL			entries : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		0A00h, savedRBP, < RBX, R12, R13, R14, R15 >
+				MOV				savedRCX, RCX
+				MOV				savedR9, R9
+
+				CheckAlign		RCX, @@exit							; (out) Result
+				CheckAlign		RDX, @@exit							; (in) Base
+				CheckAlign		R8, @@exit							; (in) Plan
+
+				MOV				R15, R8								; plan
+				MOV				RAX, eplan_magic
+				CMP				Q_PTR [ R15 ] [ eplan_tag ], RAX
+				JNE				@@badplan
+				MOV				R13, Q_PTR [ R15 ] [ eplan_steps ]
+				CMP				R13, eplan_maxsteps
+				JA				@@badplan
+				MOV				RCX, Q_PTR [ R15 ] [ eplan_window ]
+				DEC				RCX
+				CMP				RCX, eplan_maxw - 1
+				JA				@@badplan
+				MOV				EBX, 1
+				SHL				RBX, CL								; table entries: 2^(w-1)
+				MOV				entries, RBX
+				LEA				RCX, tbl							; entry 0: base (caller may use result as base)
+				Copy512			RCX, RDX
+				TEST			R13, R13
+				JNZ				@@table
+				MOV				RCX, savedRCX						; no steps: exponent zero, result is one
+				LEA				RDX, [ R9 ] [ mctx_rmodn ]
+				Copy512			RCX, RDX
+				JMP				@@done
+
+; Odd powers: entry k = entry k-1 * base^2, base^2 held in acc
+@@table:
+				CMP				RBX, 1
+				JE				@@first
+				LEA				RCX, acc
+				LEA				RDX, tbl
+				LEA				R8, tbl
+				MOV				R9, savedR9
+				CALL			mont_mul_u							; base^2
+				MOV				R12, 1
+@@odd:
+				MOV				RCX, R12
+				SHL				RCX, 6
+				LEA				RDX, tbl
+				ADD				RCX, RDX							; entry k
+				LEA				RDX, [ RCX - 64 ]					; entry k-1
+				LEA				R8, acc
+				MOV				R9, savedR9
+				CALL			mont_mul_u
+				INC				R12
+				CMP				R12, entries
+				JB				@@odd
+
+; First step loads its entry; each later step squares, then multiplies by its entry (if any)
+@@first:
+				MOVZX			EAX, W_PTR [ R15 ] [ eplan_step0 ]
+				SHR				EAX, eplan_dshift
+				CMP				RAX, entries
+				JAE				@@badplan
+				SHL				EAX, 6
+				LEA				RDX, tbl
+				ADD				RDX, RAX
+				LEA				RCX, acc
+				Copy512			RCX, RDX
+				MOV				R12, 1
+				CMP				R12, R13
+				JAE				@@finish
+@@step:
+				MOVZX			R14D, W_PTR [ R15 ] [ R12 * 2 ] [ eplan_step0 ]
+				MOV				EBX, R14D
+				SHR				EBX, eplan_dshift					; table entry
+				AND				R14D, eplan_sqrmask					; squarings
+				JZ				@@multiply
+@@square:
+				LEA				RCX, acc
+				LEA				RDX, acc
+				LEA				R8, acc
+				MOV				R9, savedR9
+				CALL			mont_mul_u
+				DEC				R14
+				JNZ				@@square
+@@multiply:
+				CMP				EBX, eplan_nodigit SHR eplan_dshift
+				JE				@@nextstep
+				CMP				RBX, entries
+				JAE				@@badplan
+				SHL				RBX, 6
+				LEA				R8, tbl
+				ADD				R8, RBX
+				LEA				RCX, acc
+				LEA				RDX, acc
+				MOV				R9, savedR9
+				CALL			mont_mul_u
+@@nextstep:
+				INC				R12
+				CMP				R12, R13
+				JB				@@step
+@@finish:
+				MOV				RCX, savedRCX
+				LEA				RDX, acc
+				Copy512			RCX, RDX
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+@@badplan:
+				LEA				EAX, [ retcode_neg_one ]
+				JMP				@@exit
+
+exp_exec_u		ENDP
+				Other_Exit		exp_exec_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mult_lo_u:PROC				; s16 mult_lo_u( u64* product, u64* multiplicand, u64* multiplier)
+;			mult_lo_u		-	truncated multiply: product = low 512 bits of multiplicand * multiplier (the overflow is not formed)
+;			Prototype:		-	s16 mult_lo_u( u64* product, u64* multiplicand, u64* multiplier);
+;			product			-	Address of 8 QWORDS to store resulting product (in RCX)
+;			multiplicand	-	Address of 8 QWORDS multiplicand (in RDX)
+;			multiplier		-	Address of 8 QWORDS multiplier (in R8)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			Only the 36 qword products that land in the low half are formed (mult_u forms 64). For callers that know the product fits,
+;			or want it mod 2^512. Product may be the same variable as either operand.
+;
+				Other_Entry		mult_lo_u, ui512
+mult_lo_u		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			lo [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < RBX, R12 >
+				MOV				savedRCX, RCX
+
+				CheckAlign		RCX, @@exit							; (out) Product
+				CheckAlign		RDX, @@exit							; (in) Multiplicand
+				CheckAlign		R8, @@exit							; (in) Multiplier
+
+				MOV				R10, RDX							; multiplicand (RDX is needed by MUL)
+				LEA				RCX, lo
+				Zero512			RCX
+				MOV				R11, 7								; i: multiplier qword, low order first (index 7)
+
+; Row for each multiplier qword i: multiplicand qwords j = 7 down to 7 - i, into lo [ i + j - 7 ]; the carry out of qword 0 is dropped
+@@row:
+				MOV				R9, Q_PTR [ R8 ] [ R11 * 8 ]
+				TEST			R9, R9
+				JZ				@@nextrow							; zero qword: nothing to add
+				XOR				EBX, EBX							; carry
+				MOV				R12, 7								; j
+@@col:
+				LEA				RCX, [ R11 + R12 - 7 ]				; position in lo
+				MOV				RAX, Q_PTR [ R10 ] [ R12 * 8 ]
+				MUL				R9
+				ADD				RAX, RBX
+				ADC				RDX, 0
+				ADD				lo [ RCX * 8 ], RAX
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				DEC				R12
+				TEST			RCX, RCX
+				JNZ				@@col
+@@nextrow:
+				DEC				R11
+				JGE				@@row
+
+				MOV				RCX, savedRCX
+				LEA				RDX, lo
+				Copy512			RCX, RDX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+mult_lo_u		ENDP
+				Other_Exit		mult_lo_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		pow_u:PROC					; s16 pow_u( u64* result, u64* x, u64 k)
+;			pow_u			-	integer power (not modular): result = x ^ k, if it fits in 512 bits
+;			Prototype:		-	s16 pow_u( u64* result, u64* x, u64 k);
+;			result			-	Address of 8 QWORDS to store result (in RCX)
+;			x				-	Address of 8 QWORDS base (in RDX)
+;			k				-	exponent QWORD (in R8)
+;			returns			-	zero for an exact result, 1 for overflow (result zero), (GP_Fault) for mis-aligned parameter address
+;
+;			With b the bit length of x (x > 1), x ^ k has between ( b - 1 ) * k + 1 and b * k bits. From msb_u, before any multiply:
+;				( b - 1 ) * k + 1 > 512		overflow, returned at once
+;				b * k <= 512				fits: left to right square and multiply with truncated products (mult_lo_u)
+;				otherwise					square and multiply with mult_u, stopping at the first overflow (every partial
+;											power divides x ^ k, so if one overflows, so does the result)
+;			x ^ 0 is one (including 0 ^ 0). Result may be the same variable as x.
+;
+				Other_Entry		pow_u, ui512
+pow_u			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			base [ 8 ] : QWORD, acc [ 8 ] : QWORD, overflow [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		200h, savedRBP, < R12, R13 >
+				MOV				savedRCX, RCX
+
+				CheckAlign		RCX, @@exit							; (out) Result
+				CheckAlign		RDX, @@exit							; (in) X
+
+				MOV				R13, R8								; k
+				LEA				RCX, base							; local copy: caller may use result as x
+				Copy512			RCX, RDX
+				TEST			R13, R13
+				JZ				@@one								; x ^ 0
+				LEA				RCX, base
+				CALL			msb_u
+				MOVSX			RAX, AX
+				TEST			RAX, RAX
+				JS				@@zero								; 0 ^ k
+				JZ				@@one								; 1 ^ k
+
+; Bounds on the bit length of the result: RAX is b - 1
+				MUL				R13									; ( b - 1 ) * k
+				JC				@@overflow							; (beyond 64 bits)
+				CMP				RAX, 512
+				JAE				@@overflow							; at least 513 bits
+				ADD				RAX, R13							; b * k
+				JC				@@checked
+				CMP				RAX, 512
+				JA				@@checked
+
+; Fits: truncated products
+				LEA				RCX, acc
+				LEA				RDX, base
+				Copy512			RCX, RDX
+				BSR				R12, R13							; leading bit of k (accounted for by acc = x)
+@@fitloop:
+				DEC				R12
+				JS				@@done
+				LEA				RCX, acc
+				LEA				RDX, acc
+				LEA				R8, acc
+				CALL			mult_lo_u							; square
+				BT				R13, R12
+				JNC				@@fitloop
+				LEA				RCX, acc
+				LEA				RDX, acc
+				LEA				R8, base
+				CALL			mult_lo_u							; and multiply if bit is set
+				JMP				@@fitloop
+
+; May or may not fit: full products, checking each overflow
+@@checked:
+				LEA				RCX, acc
+				LEA				RDX, base
+				Copy512			RCX, RDX
+				BSR				R12, R13
+@@chkloop:
+				DEC				R12
+				JS				@@done
+				LEA				RCX, acc
+				LEA				RDX, overflow
+				LEA				R8, acc
+				LEA				R9, acc
+				CALL			mult_u								; square
+				LEA				RDX, overflow
+				TestZero512		RDX
+				JNZ				@@overflow
+				BT				R13, R12
+				JNC				@@chkloop
+				LEA				RCX, acc
+				LEA				RDX, overflow
+				LEA				R8, acc
+				LEA				R9, base
+				CALL			mult_u								; and multiply if bit is set
+				LEA				RDX, overflow
+				TestZero512		RDX
+				JNZ				@@overflow
+				JMP				@@chkloop
+
+@@done:
+				MOV				RCX, savedRCX
+				LEA				RDX, acc
+				Copy512			RCX, RDX
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+@@one:
+				MOV				RCX, savedRCX
+				LEA				RDX, one512
+				Copy512			RCX, RDX
+				XOR				EAX, EAX
+				JMP				@@exit
+
+@@zero:
+				MOV				RCX, savedRCX
+				Zero512			RCX
+				XOR				EAX, EAX
+				JMP				@@exit
+
+@@overflow:
+				MOV				RCX, savedRCX
+				Zero512			RCX
+				MOV				EAX, retcode_one
+				JMP				@@exit
+
+pow_u			ENDP
+				Other_Exit		pow_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		ilog_setup_u:PROC			; s16 ilog_setup_u( u64* table, u64 base)
+;			ilog_setup_u	-	build the table for integer logarithms to a base (ilog_u, ilog_u_n)
+;			Prototype:		-	s16 ilog_setup_u( u64* table, u64 base);
+;			table			-	Address of iltab_size bytes (4232 QWORDS) to receive the table (in RCX)
+;			base			-	base, 2 or more (in RDX)
+;			returns			-	(0) for success, -1 for a base less than two, (GP_Fault) for mis-aligned parameter address
+;
+;			Table layout (offsets in ui512mdMacros.inc):
+;				iltab_base		QWORD		base
+;				iltab_count		QWORD		powers held: base^0 .. base^(count - 1), all that fit in 512 bits
+;				iltab_guess		512 WORDS	for each msb b: g, the largest k with msb of base^k below b (or zero)
+;				iltab_pows		8 QWORDS each, the powers
+;			For x with msb_u b, 2^b <= x < 2^(b+1), so base^g <= x < base^(g+2): floor ( log x ) is g or g + 1, one compare.
+;
+				Other_Entry		ilog_setup_u, ui512
+ilog_setup_u	PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			overflow : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < RBX, R12, R13, R14, R15 >
+
+				CheckAlign		RCX, @@exit							; (out) Table
+				CMP				RDX, 2
+				JB				@@badbase
+				MOV				R12, RCX							; table
+				MOV				R13, RDX							; base
+				XOR				EAX, EAX
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				Q_PTR [ R12 ] [ idx * 8 ], RAX
+				ENDM
+				MOV				Q_PTR [ R12 ] [ iltab_base ], R13
+
+; Powers: base^0 = 1, then multiply by base until the overflow is non-zero
+				LEA				RCX, [ R12 + iltab_pows ]
+				LEA				RDX, one512
+				Copy512			RCX, RDX
+				MOV				R14, 1								; powers so far
+@@power:
+				CMP				R14, iltab_maxpows
+				JAE				@@powered
+				MOV				RCX, R14
+				SHL				RCX, 6
+				LEA				RCX, [ R12 + RCX + iltab_pows ]		; power k
+				LEA				R8, [ RCX - 64 ]					; power k - 1
+				LEA				RDX, overflow
+				MOV				R9, R13
+				CALL			mult_uT64
+				CMP				overflow, 0
+				JNE				@@powered							; base^k does not fit
+				INC				R14
+				JMP				@@power
+@@powered:
+				MOV				Q_PTR [ R12 ] [ iltab_count ], R14
+
+; Guesses: for each bit index b, advance k while msb of power k + 1 is below b
+				XOR				R15D, R15D							; b
+				XOR				R13D, R13D							; k
+@@nextmsb:
+				MOV				EBX, 512							; msb of power k + 1 (512: none)
+				LEA				RAX, [ R13 + 1 ]
+				CMP				RAX, Q_PTR [ R12 ] [ iltab_count ]
+				JAE				@@guess
+				SHL				RAX, 6
+				LEA				RCX, [ R12 + RAX + iltab_pows ]
+				CALL			msb_u
+				MOVSX			RBX, AX
+@@guess:
+				CMP				RBX, R15
+				JAE				@@store
+				INC				R13
+				JMP				@@nextmsb
+@@store:
+				MOV				W_PTR [ R12 ] [ R15 * 2 ] [ iltab_guess ], R13W
+				INC				R15
+				CMP				R15, 512
+				JB				@@guess
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+
+@@badbase:
+				LEA				EAX, [ retcode_neg_one ]
+				JMP				@@exit
+
+ilog_setup_u	ENDP
+				Other_Exit		ilog_setup_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		ilog_u:PROC					; s16 ilog_u( u64* x, u64* table)
+;			ilog_u			-	integer logarithm: floor ( log x ) to the base of the table, by msb_u, a guess table lookup and one compare_u
+;			Prototype:		-	s16 ilog_u( u64* x, u64* table);
+;			x				-	Address of 8 QWORDS value (in RCX)
+;			table			-	Address of table from ilog_setup_u (in RDX)
+;			returns			-	the logarithm, -1 for zero, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		ilog_u, ui512
+ilog_u			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRCX : QWORD, savedRDX : QWORD, guess : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP
+				MOV				savedRCX, RCX
+				MOV				savedRDX, RDX
+
+				CheckAlign		RCX, @@exit							; (in) X
+				CheckAlign		RDX, @@exit							; (in) Table
+
+				CALL			msb_u
+				MOVSX			RAX, AX
+				TEST			RAX, RAX
+				JS				@@exit								; zero: -1
+				MOV				RDX, savedRDX
+				MOVZX			EAX, W_PTR [ RDX ] [ RAX * 2 ] [ iltab_guess ]	; g: base^g <= x
+				MOV				guess, RAX
+				INC				RAX
+				CMP				RAX, Q_PTR [ RDX ] [ iltab_count ]
+				JAE				@@done								; no higher power fits
+				SHL				RAX, 6
+				LEA				RDX, [ RDX + RAX + iltab_pows ]
+				MOV				RCX, savedRCX
+				CALL			compare_u							; x against base^(g+1)
+				CMP				AX, 0
+				JL				@@done
+				INC				guess
+@@done:
+				MOV				RAX, guess
+@@exit:
+				ReleaseFrame
+				RET
+ilog_u			ENDP
+				Other_Exit		ilog_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		ilog_u_n:PROC				; s16 ilog_u_n( s16* results, u64* values, u64 count, u64* table)
+;			ilog_u_n		-	integer logarithm (as ilog_u) of each of an array of 512 bit values
+;			Prototype:		-	s16 ilog_u_n( s16* results, u64* values, u64 count, u64* table);
+;			results			-	Address of count WORDS to receive the logarithms, -1 for a zero value (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			table			-	Address of table from ilog_setup_u (in R9)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		ilog_u_n, ui512
+ilog_u_n		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < RBX, R12, R13, R14, R15 >
+
+				CheckAlign		RDX, @@exit							; (in) Values
+				CheckAlign		R9, @@exit							; (in) Table
+				MOV				R12, RCX							; results
+				MOV				R13, RDX							; values
+				MOV				R14, R8								; count
+				MOV				R15, R9								; table
+				TEST			R14, R14
+				JZ				@@done
+@@element:
+				MOV				RCX, R13
+				CALL			msb_u
+				MOVSX			RAX, AX
+				TEST			RAX, RAX
+				JS				@@store								; zero: -1
+				MOVZX			EBX, W_PTR [ R15 ] [ RAX * 2 ] [ iltab_guess ]	; g
+				LEA				RAX, [ RBX + 1 ]
+				CMP				RAX, Q_PTR [ R15 ] [ iltab_count ]
+				JAE				@@have
+				SHL				RAX, 6
+				LEA				RDX, [ R15 + RAX + iltab_pows ]
+				MOV				RCX, R13
+				CALL			compare_u							; x against base^(g+1)
+				CMP				AX, 0
+				JL				@@have
+				INC				EBX
+@@have:
+				MOV				EAX, EBX
+@@store:
+				MOV				W_PTR [ R12 ], AX
+				ADD				R12, 2
+				ADD				R13, 64
+				DEC				R14
+				JNZ				@@element
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+ilog_u_n		ENDP
+				Other_Exit		ilog_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		ilog10_u:PROC				; s16 ilog10_u( u64* x)
+;			ilog10_u		-	decimal logarithm: floor ( log10 x ), so x has ilog10_u + 1 decimal digits
+;			Prototype:		-	s16 ilog10_u( u64* x);
+;			x				-	Address of 8 QWORDS value (in RCX)
+;			returns			-	the logarithm, -1 for zero, (GP_Fault) for mis-aligned parameter address
+;
+;			ilog_u with the base 10 table built in (ilog10_tab): no division, no setup.
+;
+				Other_Entry		ilog10_u, ui512
+ilog10_u		PROC			PUBLIC
+				LEA				RDX, ilog10_tab
+				JMP				ilog_u
+ilog10_u		ENDP
+				Other_Exit		ilog10_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		ilog10_u_n:PROC				; s16 ilog10_u_n( s16* results, u64* values, u64 count)
+;			ilog10_u_n		-	decimal logarithm (as ilog10_u) of each of an array of 512 bit values
+;			Prototype:		-	s16 ilog10_u_n( s16* results, u64* values, u64 count);
+;			results			-	Address of count WORDS to receive the logarithms, -1 for a zero value (in RCX)
+;			values			-	Address of count * 8 QWORDS values (in RDX)
+;			count			-	Nr of 512 bit elements (in R8)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+				Other_Entry		ilog10_u_n, ui512
+ilog10_u_n		PROC			PUBLIC
+				LEA				R9, ilog10_tab
+				JMP				ilog_u_n
+ilog10_u_n		ENDP
+				Other_Exit		ilog10_u_n, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		div_round_u:PROC			; s16 div_round_u( u64* quotient, u64* dividend, u64* divisor, u64 mode)
+;			div_round_u		-	divide 512 bit dividend by 512 bit divisor, giving the quotient rounded by mode (no remainder returned)
+;			Prototype:		-	s16 div_round_u( u64* quotient, u64* dividend, u64* divisor, u64 mode);
+;			quotient		-	Address of 8 QWORDS to store resulting quotient (in RCX), not overlapping dividend or divisor (as div_u)
+;			dividend		-	Address of 8 QWORDS dividend (in RDX)
+;			divisor			-	Address of 8 QWORDs divisor (in R8)
+;			mode			-	rnd_floor, rnd_ceil, rnd_half_even, or rnd_half_up (nearest, ties up) (in R9)
+;			returns			-	0 for success, -1 for attempt to divide by zero or an unknown mode, (GP_Fault) for mis-aligned parameter address
+;
+;			The rounding is decided in div_core_u's tail, on the remainder limbs as they stand when the division completes (still normalized):
+;			r against divisor - r, rather than 2r against divisor, so no shift and no bit lost to it. The remainder is never stored.
+;
+				Other_Entry		div_round_u, ui512
+div_round_u		PROC			PUBLIC
+				CMP				R9, rnd_half_up
+				JA				@@badmode
+				MOV				Q_PTR [ RSP ] [ 4 * 8 ], R9			; mode, in the home slot of R9
+				MOV				R9, R8								; divisor
+				MOV				R8, RDX								; dividend
+				XOR				EDX, EDX							; no remainder
+				JMP				div_core_u
+
+@@badmode:
+				LEA				EAX, [ retcode_neg_one ]
+				RET
+
+div_round_u		ENDP
+				Other_Exit		div_round_u, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		div_round_uT64:PROC			; s16 div_round_uT64( u64* quotient, u64* dividend, u64 divisor, u64 mode)
+;			div_round_uT64	-	divide 512 bit dividend by 64 bit divisor, giving the quotient rounded by mode (no remainder returned)
+;			Prototype:		-	s16 div_round_uT64( u64* quotient, u64* dividend, u64 divisor, u64 mode);
+;			quotient		-	Address of 8 QWORDS to store resulting quotient (in RCX), may be the dividend
+;			dividend		-	Address of 8 QWORDS dividend (in RDX)
+;			divisor			-	Value of 64 bit divisor (in R8)
+;			mode			-	rnd_floor, rnd_ceil, rnd_half_even, or rnd_half_up (nearest, ties up) (in R9)
+;			returns			-	0 for success, -1 for attempt to divide by zero (quotient zero) or an unknown mode, (GP_Fault) for mis-aligned parameter address
+;
+;			The divide of div_uT64, then rounding decided from the remainder left in RDX, and applied as a carry chain on the quotient.
+;			Regs with contents destroyed, not restored: RAX, RDX, R10, R11 (each considered volitile)
+;
+				Other_Entry		div_round_uT64, ui512
+div_round_uT64	PROC			PUBLIC
+				CheckAlign		RCX									; (out) Quotient
+				CheckAlign		RDX									; (in) Dividend
+				CMP				R9, rnd_half_up
+				JA				@@badmode
+				TEST			R8, R8
+				JZ				@@DivByZero
+
+				MOV				R10, RDX							; dividend, DIV needs RDX
+				XOR				EDX, EDX
+				FOR				idx, < 0, 1, 2, 3, 4, 5, 6, 7 >
+				MOV				RAX, Q_PTR [ R10 ] [ idx * 8 ]		; dividend [ idx ] -> RAX
+				DIV				R8									; remainder in RDX for next divide
+				MOV				Q_PTR [ RCX ] [ idx * 8 ], RAX		; quotient [ idx ] <- RAX
+				ENDM
+
+				XOR				EAX, EAX							; return zero
+				TEST			RDX, RDX
+				JZ				@@exit								; exact: no rounding in any mode
+				CMP				R9D, rnd_ceil
+				JB				@@exit								; floor
+				JE				@@up
+				MOV				R11, R8
+				SUB				R11, RDX							; divisor - r
+				CMP				RDX, R11
+				JA				@@up
+				JB				@@exit
+				CMP				R9D, rnd_half_up
+				JE				@@up
+				TEST			B_PTR [ RCX ] [ 7 * 8 ], 1			; half even: up only from an odd quotient
+				JZ				@@exit
+@@up:
+				ADD				Q_PTR [ RCX ] [ 7 * 8 ], 1
+				FOR				idx, < 6, 5, 4, 3, 2, 1, 0 >
+				ADC				Q_PTR [ RCX ] [ idx * 8 ], 0
+				ENDM
+@@exit:
+				RET
+
+@@DivByZero:
+				Zero512			RCX									; zero quotient, as div_uT64
+@@badmode:
+				LEA				EAX, [ retcode_neg_one ]
+				JMP				@@exit
+
+div_round_uT64	ENDP
+				Other_Exit		div_round_uT64, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mult_uT128:PROC				;	s16 mult_uT128( u64* product, u64* overflow, u64* multiplicand, u64* multiplier);
+;			mult_uT128		-	multiply 512 bit multiplicand by 128 bit multiplier, giving 512 product, 128 bit overflow
+;			Prototype:		-	s16 mult_uT128( u64* product, u64* overflow, u64* multiplicand, u64* multiplier);
+;			product			-	Address of 8 QWORDS to store resulting product (in RCX)
+;			overflow		-	Address of 2 QWORDS for resulting overflow (in RDX), most significant first; aligned 8
+;			multiplicand	-	Address of 8 QWORDS multiplicand (in R8)
+;			multiplier		-	Address of 2 QWORDS multiplier (in R9), most significant first; aligned 8
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			Fully unrolled, no msb_u and no loop: one row per multiplier qword, the 10 result qwords held in registers.
+;			With BMI2 and ADX, MULX leaves the flags alone, so each row after the first adds its low halves on the CF chain (ADCX)
+;			and its high halves on the OF chain (ADOX) together. Without, MUL and a carry qword. Product may be the multiplicand or multiplier.
+;
+				Other_Entry		mult_uT128, ui512
+mult_uT128		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			cand [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRDX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		180h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+				MOV				savedRDX, RDX
+
+				CheckAlign		RCX, @@exit							; (out) Product
+				CheckAlign		R8, @@exit							; (in) Multiplicand
+
+; copy the multiplicand: the product may be the same memory, and is written a qword at a time as rows complete
+				LEA				RAX, cand
+				Copy512			RAX, R8
+
+	IF		__UseBMI2 AND __UseADX
+; row 0: multiplicand times the low qword of the multiplier, one carry chain
+				MOV				RDX, Q_PTR [ R9 ] [ 1 * 8 ]			; multiplier qword 0 (least significant)
+				MULX			RBX, RAX, cand [ 7 * 8 ]
+				MULX			RDI, RSI, cand [ 6 * 8 ]
+				ADD				RBX, RSI
+				MULX			R8, RSI, cand [ 5 * 8 ]
+				ADC				RDI, RSI
+				MULX			R10, RSI, cand [ 4 * 8 ]
+				ADC				R8, RSI
+				MULX			R11, RSI, cand [ 3 * 8 ]
+				ADC				R10, RSI
+				MULX			R12, RSI, cand [ 2 * 8 ]
+				ADC				R11, RSI
+				MULX			R13, RSI, cand [ 1 * 8 ]
+				ADC				R12, RSI
+				MULX			R14, RSI, cand [ 0 * 8 ]
+				ADC				R13, RSI
+				ADC				R14, 0
+				MOV				Q_PTR [ RCX ] [ 7 * 8 ], RAX		; product qword 0 is final
+; row 1: add multiplicand times multiplier qword 1, one qword up: low halves on the CF chain (ADCX), high halves on the OF chain (ADOX)
+				MOV				RDX, Q_PTR [ R9 ] [ 0 * 8 ]
+				XOR				RAX, RAX							; new top qword, and clears CF and OF
+				MULX			R15, RSI, cand [ 7 * 8 ]
+				ADCX			RBX, RSI
+				ADOX			RDI, R15
+				MULX			R15, RSI, cand [ 6 * 8 ]
+				ADCX			RDI, RSI
+				ADOX			R8, R15
+				MULX			R15, RSI, cand [ 5 * 8 ]
+				ADCX			R8, RSI
+				ADOX			R10, R15
+				MULX			R15, RSI, cand [ 4 * 8 ]
+				ADCX			R10, RSI
+				ADOX			R11, R15
+				MULX			R15, RSI, cand [ 3 * 8 ]
+				ADCX			R11, RSI
+				ADOX			R12, R15
+				MULX			R15, RSI, cand [ 2 * 8 ]
+				ADCX			R12, RSI
+				ADOX			R13, R15
+				MULX			R15, RSI, cand [ 1 * 8 ]
+				ADCX			R13, RSI
+				ADOX			R14, R15
+				MULX			R15, RSI, cand [ 0 * 8 ]
+				ADCX			R14, RSI
+				ADOX			RAX, R15
+				ADC				RAX, 0								; last CF (the OF chain ends with no carry: the sum fits)
+				MOV				Q_PTR [ RCX ] [ 6 * 8 ], RBX		; product qword 1 is final
+; remaining qwords to product and overflow
+				MOV				RDX, savedRDX
+				MOV				Q_PTR [ RCX ] [ 5 * 8 ], RDI
+				MOV				Q_PTR [ RCX ] [ 4 * 8 ], R8
+				MOV				Q_PTR [ RCX ] [ 3 * 8 ], R10
+				MOV				Q_PTR [ RCX ] [ 2 * 8 ], R11
+				MOV				Q_PTR [ RCX ] [ 1 * 8 ], R12
+				MOV				Q_PTR [ RCX ] [ 0 * 8 ], R13
+				MOV				Q_PTR [ RDX ] [ 1 * 8 ], R14
+				MOV				Q_PTR [ RDX ] [ 0 * 8 ], RAX
+	ELSE
+; row 0: multiplicand times the low qword of the multiplier
+				MOV				RAX, cand [ 7 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				MOV				RBX, RAX
+				MOV				RSI, RDX
+				MOV				RAX, cand [ 6 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				RSI, RAX
+				ADC				RDX, 0
+				MOV				RDI, RDX
+				MOV				RAX, cand [ 5 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				RDI, RAX
+				ADC				RDX, 0
+				MOV				R8, RDX
+				MOV				RAX, cand [ 4 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R8, RAX
+				ADC				RDX, 0
+				MOV				R10, RDX
+				MOV				RAX, cand [ 3 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R10, RAX
+				ADC				RDX, 0
+				MOV				R11, RDX
+				MOV				RAX, cand [ 2 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R11, RAX
+				ADC				RDX, 0
+				MOV				R12, RDX
+				MOV				RAX, cand [ 1 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R12, RAX
+				ADC				RDX, 0
+				MOV				R13, RDX
+				MOV				RAX, cand [ 0 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R13, RAX
+				ADC				RDX, 0
+				MOV				R14, RDX
+				MOV				Q_PTR [ RCX ] [ 7 * 8 ], RBX		; product qword 0 is final
+; row 1: add multiplicand times multiplier qword 1, one qword up; the carry qword becomes the new top qword
+				MOV				RAX, cand [ 7 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				RSI, RAX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 6 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				RDI, RAX
+				ADC				RDX, 0
+				ADD				RDI, R15
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				MOV				RAX, cand [ 5 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R8, RAX
+				ADC				RDX, 0
+				ADD				R8, RBX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 4 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R10, RAX
+				ADC				RDX, 0
+				ADD				R10, R15
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				MOV				RAX, cand [ 3 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R11, RAX
+				ADC				RDX, 0
+				ADD				R11, RBX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 2 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R12, RAX
+				ADC				RDX, 0
+				ADD				R12, R15
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				MOV				RAX, cand [ 1 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R13, RAX
+				ADC				RDX, 0
+				ADD				R13, RBX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 0 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R14, RAX
+				ADC				RDX, 0
+				ADD				R14, R15
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				MOV				Q_PTR [ RCX ] [ 6 * 8 ], RSI		; product qword 1 is final
+; remaining qwords to product and overflow
+				MOV				RDX, savedRDX
+				MOV				Q_PTR [ RCX ] [ 5 * 8 ], RDI
+				MOV				Q_PTR [ RCX ] [ 4 * 8 ], R8
+				MOV				Q_PTR [ RCX ] [ 3 * 8 ], R10
+				MOV				Q_PTR [ RCX ] [ 2 * 8 ], R11
+				MOV				Q_PTR [ RCX ] [ 1 * 8 ], R12
+				MOV				Q_PTR [ RCX ] [ 0 * 8 ], R13
+				MOV				Q_PTR [ RDX ] [ 1 * 8 ], R14
+				MOV				Q_PTR [ RDX ] [ 0 * 8 ], RBX
+	ENDIF
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+mult_uT128		ENDP
+				Other_Exit		mult_uT128, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		mult_uT256:PROC				;	s16 mult_uT256( u64* product, u64* overflow, u64* multiplicand, u64* multiplier);
+;			mult_uT256		-	multiply 512 bit multiplicand by 256 bit multiplier, giving 512 product, 256 bit overflow
+;			Prototype:		-	s16 mult_uT256( u64* product, u64* overflow, u64* multiplicand, u64* multiplier);
+;			product			-	Address of 8 QWORDS to store resulting product (in RCX)
+;			overflow		-	Address of 4 QWORDS for resulting overflow (in RDX), most significant first; aligned 8
+;			multiplicand	-	Address of 8 QWORDS multiplicand (in R8)
+;			multiplier		-	Address of 4 QWORDS multiplier (in R9), most significant first; aligned 8
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			Fully unrolled, no msb_u and no loop: one row per multiplier qword, the 12 result qwords held in registers.
+;			With BMI2 and ADX, MULX leaves the flags alone, so each row after the first adds its low halves on the CF chain (ADCX)
+;			and its high halves on the OF chain (ADOX) together. Without, MUL and a carry qword. Product may be the multiplicand or multiplier.
+;
+				Other_Entry		mult_uT256, ui512
+mult_uT256		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			cand [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD, savedRDX : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		180h, savedRBP, < RBX, RSI, RDI, R12, R13, R14, R15 >
+				MOV				savedRDX, RDX
+
+				CheckAlign		RCX, @@exit							; (out) Product
+				CheckAlign		R8, @@exit							; (in) Multiplicand
+
+; copy the multiplicand: the product may be the same memory, and is written a qword at a time as rows complete
+				LEA				RAX, cand
+				Copy512			RAX, R8
+
+	IF		__UseBMI2 AND __UseADX
+; row 0: multiplicand times the low qword of the multiplier, one carry chain
+				MOV				RDX, Q_PTR [ R9 ] [ 3 * 8 ]			; multiplier qword 0 (least significant)
+				MULX			RBX, RAX, cand [ 7 * 8 ]
+				MULX			RDI, RSI, cand [ 6 * 8 ]
+				ADD				RBX, RSI
+				MULX			R8, RSI, cand [ 5 * 8 ]
+				ADC				RDI, RSI
+				MULX			R10, RSI, cand [ 4 * 8 ]
+				ADC				R8, RSI
+				MULX			R11, RSI, cand [ 3 * 8 ]
+				ADC				R10, RSI
+				MULX			R12, RSI, cand [ 2 * 8 ]
+				ADC				R11, RSI
+				MULX			R13, RSI, cand [ 1 * 8 ]
+				ADC				R12, RSI
+				MULX			R14, RSI, cand [ 0 * 8 ]
+				ADC				R13, RSI
+				ADC				R14, 0
+				MOV				Q_PTR [ RCX ] [ 7 * 8 ], RAX		; product qword 0 is final
+; row 1: add multiplicand times multiplier qword 1, one qword up: low halves on the CF chain (ADCX), high halves on the OF chain (ADOX)
+				MOV				RDX, Q_PTR [ R9 ] [ 2 * 8 ]
+				XOR				RAX, RAX							; new top qword, and clears CF and OF
+				MULX			R15, RSI, cand [ 7 * 8 ]
+				ADCX			RBX, RSI
+				ADOX			RDI, R15
+				MULX			R15, RSI, cand [ 6 * 8 ]
+				ADCX			RDI, RSI
+				ADOX			R8, R15
+				MULX			R15, RSI, cand [ 5 * 8 ]
+				ADCX			R8, RSI
+				ADOX			R10, R15
+				MULX			R15, RSI, cand [ 4 * 8 ]
+				ADCX			R10, RSI
+				ADOX			R11, R15
+				MULX			R15, RSI, cand [ 3 * 8 ]
+				ADCX			R11, RSI
+				ADOX			R12, R15
+				MULX			R15, RSI, cand [ 2 * 8 ]
+				ADCX			R12, RSI
+				ADOX			R13, R15
+				MULX			R15, RSI, cand [ 1 * 8 ]
+				ADCX			R13, RSI
+				ADOX			R14, R15
+				MULX			R15, RSI, cand [ 0 * 8 ]
+				ADCX			R14, RSI
+				ADOX			RAX, R15
+				ADC				RAX, 0								; last CF (the OF chain ends with no carry: the sum fits)
+				MOV				Q_PTR [ RCX ] [ 6 * 8 ], RBX		; product qword 1 is final
+; row 2: add multiplicand times multiplier qword 2, one qword up: low halves on the CF chain (ADCX), high halves on the OF chain (ADOX)
+				MOV				RDX, Q_PTR [ R9 ] [ 1 * 8 ]
+				XOR				RBX, RBX							; new top qword, and clears CF and OF
+				MULX			R15, RSI, cand [ 7 * 8 ]
+				ADCX			RDI, RSI
+				ADOX			R8, R15
+				MULX			R15, RSI, cand [ 6 * 8 ]
+				ADCX			R8, RSI
+				ADOX			R10, R15
+				MULX			R15, RSI, cand [ 5 * 8 ]
+				ADCX			R10, RSI
+				ADOX			R11, R15
+				MULX			R15, RSI, cand [ 4 * 8 ]
+				ADCX			R11, RSI
+				ADOX			R12, R15
+				MULX			R15, RSI, cand [ 3 * 8 ]
+				ADCX			R12, RSI
+				ADOX			R13, R15
+				MULX			R15, RSI, cand [ 2 * 8 ]
+				ADCX			R13, RSI
+				ADOX			R14, R15
+				MULX			R15, RSI, cand [ 1 * 8 ]
+				ADCX			R14, RSI
+				ADOX			RAX, R15
+				MULX			R15, RSI, cand [ 0 * 8 ]
+				ADCX			RAX, RSI
+				ADOX			RBX, R15
+				ADC				RBX, 0								; last CF (the OF chain ends with no carry: the sum fits)
+				MOV				Q_PTR [ RCX ] [ 5 * 8 ], RDI		; product qword 2 is final
+; row 3: add multiplicand times multiplier qword 3, one qword up: low halves on the CF chain (ADCX), high halves on the OF chain (ADOX)
+				MOV				RDX, Q_PTR [ R9 ] [ 0 * 8 ]
+				XOR				RDI, RDI							; new top qword, and clears CF and OF
+				MULX			R15, RSI, cand [ 7 * 8 ]
+				ADCX			R8, RSI
+				ADOX			R10, R15
+				MULX			R15, RSI, cand [ 6 * 8 ]
+				ADCX			R10, RSI
+				ADOX			R11, R15
+				MULX			R15, RSI, cand [ 5 * 8 ]
+				ADCX			R11, RSI
+				ADOX			R12, R15
+				MULX			R15, RSI, cand [ 4 * 8 ]
+				ADCX			R12, RSI
+				ADOX			R13, R15
+				MULX			R15, RSI, cand [ 3 * 8 ]
+				ADCX			R13, RSI
+				ADOX			R14, R15
+				MULX			R15, RSI, cand [ 2 * 8 ]
+				ADCX			R14, RSI
+				ADOX			RAX, R15
+				MULX			R15, RSI, cand [ 1 * 8 ]
+				ADCX			RAX, RSI
+				ADOX			RBX, R15
+				MULX			R15, RSI, cand [ 0 * 8 ]
+				ADCX			RBX, RSI
+				ADOX			RDI, R15
+				ADC				RDI, 0								; last CF (the OF chain ends with no carry: the sum fits)
+				MOV				Q_PTR [ RCX ] [ 4 * 8 ], R8			; product qword 3 is final
+; remaining qwords to product and overflow
+				MOV				RDX, savedRDX
+				MOV				Q_PTR [ RCX ] [ 3 * 8 ], R10
+				MOV				Q_PTR [ RCX ] [ 2 * 8 ], R11
+				MOV				Q_PTR [ RCX ] [ 1 * 8 ], R12
+				MOV				Q_PTR [ RCX ] [ 0 * 8 ], R13
+				MOV				Q_PTR [ RDX ] [ 3 * 8 ], R14
+				MOV				Q_PTR [ RDX ] [ 2 * 8 ], RAX
+				MOV				Q_PTR [ RDX ] [ 1 * 8 ], RBX
+				MOV				Q_PTR [ RDX ] [ 0 * 8 ], RDI
+	ELSE
+; row 0: multiplicand times the low qword of the multiplier
+				MOV				RAX, cand [ 7 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 3 * 8 ]
+				MOV				RBX, RAX
+				MOV				RSI, RDX
+				MOV				RAX, cand [ 6 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 3 * 8 ]
+				ADD				RSI, RAX
+				ADC				RDX, 0
+				MOV				RDI, RDX
+				MOV				RAX, cand [ 5 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 3 * 8 ]
+				ADD				RDI, RAX
+				ADC				RDX, 0
+				MOV				R8, RDX
+				MOV				RAX, cand [ 4 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 3 * 8 ]
+				ADD				R8, RAX
+				ADC				RDX, 0
+				MOV				R10, RDX
+				MOV				RAX, cand [ 3 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 3 * 8 ]
+				ADD				R10, RAX
+				ADC				RDX, 0
+				MOV				R11, RDX
+				MOV				RAX, cand [ 2 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 3 * 8 ]
+				ADD				R11, RAX
+				ADC				RDX, 0
+				MOV				R12, RDX
+				MOV				RAX, cand [ 1 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 3 * 8 ]
+				ADD				R12, RAX
+				ADC				RDX, 0
+				MOV				R13, RDX
+				MOV				RAX, cand [ 0 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 3 * 8 ]
+				ADD				R13, RAX
+				ADC				RDX, 0
+				MOV				R14, RDX
+				MOV				Q_PTR [ RCX ] [ 7 * 8 ], RBX		; product qword 0 is final
+; row 1: add multiplicand times multiplier qword 1, one qword up; the carry qword becomes the new top qword
+				MOV				RAX, cand [ 7 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 2 * 8 ]
+				ADD				RSI, RAX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 6 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 2 * 8 ]
+				ADD				RDI, RAX
+				ADC				RDX, 0
+				ADD				RDI, R15
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				MOV				RAX, cand [ 5 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 2 * 8 ]
+				ADD				R8, RAX
+				ADC				RDX, 0
+				ADD				R8, RBX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 4 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 2 * 8 ]
+				ADD				R10, RAX
+				ADC				RDX, 0
+				ADD				R10, R15
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				MOV				RAX, cand [ 3 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 2 * 8 ]
+				ADD				R11, RAX
+				ADC				RDX, 0
+				ADD				R11, RBX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 2 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 2 * 8 ]
+				ADD				R12, RAX
+				ADC				RDX, 0
+				ADD				R12, R15
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				MOV				RAX, cand [ 1 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 2 * 8 ]
+				ADD				R13, RAX
+				ADC				RDX, 0
+				ADD				R13, RBX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 0 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 2 * 8 ]
+				ADD				R14, RAX
+				ADC				RDX, 0
+				ADD				R14, R15
+				ADC				RDX, 0
+				MOV				RBX, RDX
+				MOV				Q_PTR [ RCX ] [ 6 * 8 ], RSI		; product qword 1 is final
+; row 2: add multiplicand times multiplier qword 2, one qword up; the carry qword becomes the new top qword
+				MOV				RAX, cand [ 7 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				RDI, RAX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 6 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R8, RAX
+				ADC				RDX, 0
+				ADD				R8, R15
+				ADC				RDX, 0
+				MOV				RSI, RDX
+				MOV				RAX, cand [ 5 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R10, RAX
+				ADC				RDX, 0
+				ADD				R10, RSI
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 4 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R11, RAX
+				ADC				RDX, 0
+				ADD				R11, R15
+				ADC				RDX, 0
+				MOV				RSI, RDX
+				MOV				RAX, cand [ 3 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R12, RAX
+				ADC				RDX, 0
+				ADD				R12, RSI
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 2 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R13, RAX
+				ADC				RDX, 0
+				ADD				R13, R15
+				ADC				RDX, 0
+				MOV				RSI, RDX
+				MOV				RAX, cand [ 1 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				R14, RAX
+				ADC				RDX, 0
+				ADD				R14, RSI
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 0 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 1 * 8 ]
+				ADD				RBX, RAX
+				ADC				RDX, 0
+				ADD				RBX, R15
+				ADC				RDX, 0
+				MOV				RSI, RDX
+				MOV				Q_PTR [ RCX ] [ 5 * 8 ], RDI		; product qword 2 is final
+; row 3: add multiplicand times multiplier qword 3, one qword up; the carry qword becomes the new top qword
+				MOV				RAX, cand [ 7 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R8, RAX
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 6 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R10, RAX
+				ADC				RDX, 0
+				ADD				R10, R15
+				ADC				RDX, 0
+				MOV				RDI, RDX
+				MOV				RAX, cand [ 5 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R11, RAX
+				ADC				RDX, 0
+				ADD				R11, RDI
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 4 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R12, RAX
+				ADC				RDX, 0
+				ADD				R12, R15
+				ADC				RDX, 0
+				MOV				RDI, RDX
+				MOV				RAX, cand [ 3 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R13, RAX
+				ADC				RDX, 0
+				ADD				R13, RDI
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 2 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				R14, RAX
+				ADC				RDX, 0
+				ADD				R14, R15
+				ADC				RDX, 0
+				MOV				RDI, RDX
+				MOV				RAX, cand [ 1 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				RBX, RAX
+				ADC				RDX, 0
+				ADD				RBX, RDI
+				ADC				RDX, 0
+				MOV				R15, RDX
+				MOV				RAX, cand [ 0 * 8 ]
+				MUL				Q_PTR [ R9 ] [ 0 * 8 ]
+				ADD				RSI, RAX
+				ADC				RDX, 0
+				ADD				RSI, R15
+				ADC				RDX, 0
+				MOV				RDI, RDX
+				MOV				Q_PTR [ RCX ] [ 4 * 8 ], R8			; product qword 3 is final
+; remaining qwords to product and overflow
+				MOV				RDX, savedRDX
+				MOV				Q_PTR [ RCX ] [ 3 * 8 ], R10
+				MOV				Q_PTR [ RCX ] [ 2 * 8 ], R11
+				MOV				Q_PTR [ RCX ] [ 1 * 8 ], R12
+				MOV				Q_PTR [ RCX ] [ 0 * 8 ], R13
+				MOV				Q_PTR [ RDX ] [ 3 * 8 ], R14
+				MOV				Q_PTR [ RDX ] [ 2 * 8 ], RBX
+				MOV				Q_PTR [ RDX ] [ 1 * 8 ], RSI
+				MOV				Q_PTR [ RDX ] [ 0 * 8 ], RDI
+	ENDIF
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+mult_uT256		ENDP
+				Other_Exit		mult_uT256, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		add_uZ:PROC					; s16 add_uZ( u64* sum, u64* addend1, u64* addend2)
+;			add_uZ			-	as add_u: sum = addend1 + addend2, in one ZMM with the carries resolved on the mask registers (AddZ512)
+;			Prototype:		-	s16 add_uZ( u64* sum, u64* addend1, u64* addend2);
+;			sum				-	Address of 8 QWORDS to store the sum (in RCX), may be either addend
+;			addend1			-	Address of 8 QWORDS (in RDX)
+;			addend2			-	Address of 8 QWORDS (in R8)
+;			returns			-	carry (0 or 1), (GP_Fault) for mis-aligned parameter address
+;
+;			Branch free, no carry chain through the flags. Without __UseZ, this is add_u.
+;
+				Other_Entry		add_uZ, ui512
+add_uZ			PROC			PUBLIC
+	IF		__UseZ
+				CheckAlign		RCX, @@exit							; (out) Sum
+				CheckAlign		RDX, @@exit							; (in) Addend1
+				CheckAlign		R8, @@exit							; (in) Addend2
+				CarryZSetup
+				AddZ512			RCX, RDX, R8
+@@exit:
+				RET
+	ELSE
+				JMP				add_u
+	ENDIF
+add_uZ			ENDP
+				Other_Exit		add_uZ, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		sub_uZ:PROC					; s16 sub_uZ( u64* difference, u64* left, u64* right)
+;			sub_uZ			-	as sub_u: difference = left - right, in one ZMM with the borrows resolved on the mask registers (SubZ512)
+;			Prototype:		-	s16 sub_uZ( u64* difference, u64* left, u64* right);
+;			difference		-	Address of 8 QWORDS to store the difference (in RCX), may be either operand
+;			left			-	Address of 8 QWORDS (in RDX)
+;			right			-	Address of 8 QWORDS (in R8)
+;			returns			-	borrow (0 or 1), (GP_Fault) for mis-aligned parameter address
+;
+;			Branch free, no borrow chain through the flags. Without __UseZ, this is sub_u.
+;
+				Other_Entry		sub_uZ, ui512
+sub_uZ			PROC			PUBLIC
+	IF		__UseZ
+				CheckAlign		RCX, @@exit							; (out) Difference
+				CheckAlign		RDX, @@exit							; (in) Left
+				CheckAlign		R8, @@exit							; (in) Right
+				CarryZSetup
+				SubZ512			RCX, RDX, R8
+@@exit:
+				RET
+	ELSE
+				JMP				sub_u
+	ENDIF
+sub_uZ			ENDP
+				Other_Exit		sub_uZ, ui512
+
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		compare_uZ:PROC				; s16 compare_uZ( u64* lh_op, u64* rh_op)
+;			compare_uZ		-	as compare_u: -1, 0, 1 as lh_op is below, equal to, or above rh_op, from two lane compares (CmpZ512)
+;			Prototype:		-	s16 compare_uZ( u64* lh_op, u64* rh_op);
+;			lh_op			-	Address of 8 QWORDS (in RCX)
+;			rh_op			-	Address of 8 QWORDS (in RDX)
+;			returns			-	-1, 0, 1, (GP_Fault) for mis-aligned parameter address
+;
+;			Branch free. Other than RAX, only R10 is changed. Without __UseZ, this is compare_u.
+;
+				Other_Entry		compare_uZ, ui512
+compare_uZ		PROC			PUBLIC
+	IF		__UseZ
+				CheckAlign		RCX, @@exit							; (in) lh_op
+				CheckAlign		RDX, @@exit							; (in) rh_op
+				CmpZ512			RCX, RDX
+@@exit:
+				RET
+	ELSE
+				JMP				compare_u
+	ENDIF
+compare_uZ		ENDP
+				Other_Exit		compare_uZ, ui512
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		add_u_n:PROC				; u64 add_u_n( u64* sums, u64* addends1, u64* addends2, u64 count)
+;			add_u_n			-	sum of each of two arrays of 512 bit values (sums [ i ] as add_u of element i), returning the number of carries out
+;			Prototype:		-	u64 add_u_n( u64* sums, u64* addends1, u64* addends2, u64 count);
+;			sums			-	Address of count * 8 QWORDS to receive the results (in RCX), may be either operand array
+;			addends1		-	Address of count * 8 QWORDS (in RDX)
+;			addends2		-	Address of count * 8 QWORDS (in R8)
+;			count			-	Nr of 512 bit elements (in R9)
+;			returns			-	number of elements with a carry out, (GP_Fault) for mis-aligned parameter address
+;
+;			Under __UseZ, AddZ512 per element, the setup done once. Otherwise a loop of add_u.
+;
+				Other_Entry		add_u_n, ui512
+	IF		__UseZ
+add_u_n			PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Results
+				CheckAlign		RDX, @@exit							; (in) Operands
+				CheckAlign		R8, @@exit							; (in) Operands
+				XOR				R11D, R11D							; carries out
+				TEST			R9, R9
+				JZ				@@done
+				CarryZSetup
+@@:
+				AddZ512			RCX, RDX, R8
+				ADD				R11, RAX
+				ADD				RCX, 64
+				ADD				RDX, 64
+				ADD				R8, 64
+				DEC				R9
+				JNZ				@B
+@@done:
+				MOV				RAX, R11
+@@exit:
+				RET
+	ELSE
+add_u_n			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < RBX, R12, R13, R14, R15 >
+				CheckAlign		RCX, @@exit							; (out) Results
+				MOV				R12, RCX
+				MOV				R13, RDX
+				MOV				R14, R8
+				MOV				R15, R9
+				XOR				EBX, EBX							; carries out
+				TEST			R15, R15
+				JZ				@@done
+@@element:
+				MOV				RCX, R12
+				MOV				RDX, R13
+				MOV				R8, R14
+				CALL			add_u
+				MOVZX			EAX, AX
+				ADD				RBX, RAX
+				ADD				R12, 64
+				ADD				R13, 64
+				ADD				R14, 64
+				DEC				R15
+				JNZ				@@element
+@@done:
+				MOV				RAX, RBX
+@@exit:
+				ReleaseFrame
+				RET
+	ENDIF
+add_u_n			ENDP
+				Other_Exit		add_u_n, ui512
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		sub_u_n:PROC				; u64 sub_u_n( u64* differences, u64* lefts, u64* rights, u64 count)
+;			sub_u_n			-	difference of each of two arrays of 512 bit values (differences [ i ] as sub_u of element i), returning the number of borrows out
+;			Prototype:		-	u64 sub_u_n( u64* differences, u64* lefts, u64* rights, u64 count);
+;			differences		-	Address of count * 8 QWORDS to receive the results (in RCX), may be either operand array
+;			lefts			-	Address of count * 8 QWORDS (in RDX)
+;			rights			-	Address of count * 8 QWORDS (in R8)
+;			count			-	Nr of 512 bit elements (in R9)
+;			returns			-	number of elements with a borrow out, (GP_Fault) for mis-aligned parameter address
+;
+;			Under __UseZ, SubZ512 per element, the setup done once. Otherwise a loop of sub_u.
+;
+				Other_Entry		sub_u_n, ui512
+	IF		__UseZ
+sub_u_n			PROC			PUBLIC
+				CheckAlign		RCX, @@exit							; (out) Results
+				CheckAlign		RDX, @@exit							; (in) Operands
+				CheckAlign		R8, @@exit							; (in) Operands
+				XOR				R11D, R11D							; borrows out
+				TEST			R9, R9
+				JZ				@@done
+				CarryZSetup
+@@:
+				SubZ512			RCX, RDX, R8
+				ADD				R11, RAX
+				ADD				RCX, 64
+				ADD				RDX, 64
+				ADD				R8, 64
+				DEC				R9
+				JNZ				@B
+@@done:
+				MOV				RAX, R11
+@@exit:
+				RET
+	ELSE
+sub_u_n			PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < RBX, R12, R13, R14, R15 >
+				CheckAlign		RCX, @@exit							; (out) Results
+				MOV				R12, RCX
+				MOV				R13, RDX
+				MOV				R14, R8
+				MOV				R15, R9
+				XOR				EBX, EBX							; borrows out
+				TEST			R15, R15
+				JZ				@@done
+@@element:
+				MOV				RCX, R12
+				MOV				RDX, R13
+				MOV				R8, R14
+				CALL			sub_u
+				MOVZX			EAX, AX
+				ADD				RBX, RAX
+				ADD				R12, 64
+				ADD				R13, 64
+				ADD				R14, 64
+				DEC				R15
+				JNZ				@@element
+@@done:
+				MOV				RAX, RBX
+@@exit:
+				ReleaseFrame
+				RET
+	ENDIF
+sub_u_n			ENDP
+				Other_Exit		sub_u_n, ui512
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;			EXTERNDEF		compare_u_n:PROC			; s16 compare_u_n( s16* results, u64* lh_ops, u64* rh_ops, u64 count)
+;			compare_u_n		-	compare (as compare_u) each of two arrays of 512 bit values: results [ i ] -1, 0, 1
+;			Prototype:		-	s16 compare_u_n( s16* results, u64* lh_ops, u64* rh_ops, u64 count);
+;			results			-	Address of count WORDS to receive the comparisons (in RCX)
+;			lh_ops			-	Address of count * 8 QWORDS (in RDX)
+;			rh_ops			-	Address of count * 8 QWORDS (in R8)
+;			count			-	Nr of 512 bit elements (in R9)
+;			returns			-	(0) for success, (GP_Fault) for mis-aligned parameter address
+;
+;			Under __UseZ, CmpZ512 per element. Otherwise a loop of compare_u. For predicates as bit masks, see cmp_u_n.
+;
+				Other_Entry		compare_u_n, ui512
+	IF		__UseZ
+compare_u_n		PROC			PUBLIC
+				CheckAlign		RDX, @@exit							; (in) lh_ops
+				CheckAlign		R8, @@exit							; (in) rh_ops
+				TEST			R9, R9
+				JZ				@@done
+@@:
+				CmpZ512			RDX, R8
+				MOV				W_PTR [ RCX ], AX
+				ADD				RCX, 2
+				ADD				RDX, 64
+				ADD				R8, 64
+				DEC				R9
+				JNZ				@B
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				RET
+	ELSE
+compare_u_n		PROC			PUBLIC FRAME
+				LOCAL			padding1 [ 8 ] : QWORD
+				LOCAL			savedRBP : QWORD
+				LOCAL			padding2 [ 16 ] : QWORD
+
+				CreateFrame		100h, savedRBP, < R12, R13, R14, R15 >
+				CheckAlign		RDX, @@exit							; (in) lh_ops
+				CheckAlign		R8, @@exit							; (in) rh_ops
+				MOV				R12, RCX
+				MOV				R13, RDX
+				MOV				R14, R8
+				MOV				R15, R9
+				TEST			R15, R15
+				JZ				@@done
+@@element:
+				MOV				RCX, R13
+				MOV				RDX, R14
+				CALL			compare_u
+				MOV				W_PTR [ R12 ], AX
+				ADD				R12, 2
+				ADD				R13, 64
+				ADD				R14, 64
+				DEC				R15
+				JNZ				@@element
+@@done:
+				XOR				EAX, EAX							; return zero
+@@exit:
+				ReleaseFrame
+				RET
+	ENDIF
+compare_u_n		ENDP
+				Other_Exit		compare_u_n, ui512
+
 				END
\ No newline at end of file
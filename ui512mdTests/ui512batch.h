@@ -0,0 +1,324 @@
+#pragma once
+
+#ifndef ui512batch_h
+#define ui512batch_h
+
+//		ui512batch.h
+//
+//		File:			ui512batch.h
+//		Author:			John G.Lynch
+//		Legal:			Copyright @2024, per MIT License below
+//		Date:			October 19, 2026
+//
+//		Deferred batch builder: scattered single calls are gathered per kind and run together.
+//		A call (Add, Sub, Compare, Mult, Div) copies its inputs into the context, marks its BatchRequest pending, and returns at once;
+//		the BatchRequest is the future. A kind is flushed when max_batch calls are pending (full), when its oldest call has waited
+//		max_wait_us (deadline, checked on each call and by Poll), or when a pending result is awaited (forced). A flush runs the gathered
+//		operands through the batch kernels (add_u_n, sub_u_n, compare_u_n), or, for mult_u and div_u which have none, one call per lane
+//		over the contiguous operands; results are then written to the callers' outputs and any suspended coroutines are resumed.
+//		Per kind: flushes by cause, requests, and the wait from call to result (mean and max).
+//		A context belongs to one thread (ThisThread gives each thread its own); outputs must stay valid until the request is done.
+
+#include "CommonTypeDefs.h"
+#include "ui512a.h"
+#include "ui512md.h"
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <vector>
+
+namespace ui512batch
+{
+	enum batch_op : u8 { op_add_u = 0, op_sub_u, op_compare_u, op_mult_u, op_div_u, op_count };
+	inline const char* batch_op_names[op_count] = { "add_u", "sub_u", "compare_u", "mult_u", "div_u" };
+
+	enum flush_cause : u8 { flush_full = 0, flush_deadline, flush_forced, flush_cause_count };
+
+	// The future: the routine's return value once done; a coroutine awaiting it is resumed by the flush
+	struct BatchRequest
+	{
+		s16 ret = 0;
+		bool done = true;
+		batch_op op = op_add_u;
+		std::coroutine_handle<> waiter{};
+	};
+
+	struct BatchStats
+	{
+		u64 requests = 0;
+		u64 flushes[flush_cause_count] = { 0 };
+		double wait_ns_total = 0.0;
+		double wait_ns_max = 0.0;
+
+		u64 Flushes() const
+		{
+			return flushes[flush_full] + flushes[flush_deadline] + flushes[flush_forced];
+		};
+
+		double MeanBatch() const
+		{
+			return (Flushes() == 0) ? 0.0 : double(requests) / double(Flushes());
+		};
+
+		double MeanWait() const
+		{
+			return (requests == 0) ? 0.0 : wait_ns_total / double(requests);
+		};
+	};
+
+	// Fire and forget coroutine: runs until its first co_await on a pending request, and is resumed by the flush
+	struct BatchTask
+	{
+		struct promise_type
+		{
+			BatchTask get_return_object() { return {}; };
+			std::suspend_never initial_suspend() noexcept { return {}; };
+			std::suspend_never final_suspend() noexcept { return {}; };
+			void return_void() {};
+			void unhandled_exception() {};
+		};
+	};
+
+	class BatchContext
+	{
+	public:
+		u64 max_batch = 64;
+		u64 max_wait_us = 50;
+		BatchStats stats[op_count];
+
+		// sum = addend1 + addend2; ret is the carry
+		void Add(BatchRequest& req, u64* sum, const u64* addend1, const u64* addend2)
+		{
+			Enqueue(op_add_u, req, sum, nullptr, addend1, addend2);
+		};
+
+		// difference = left - right; ret is the borrow
+		void Sub(BatchRequest& req, u64* difference, const u64* left, const u64* right)
+		{
+			Enqueue(op_sub_u, req, difference, nullptr, left, right);
+		};
+
+		// ret is -1, 0, 1, as compare_u
+		void Compare(BatchRequest& req, const u64* lh_op, const u64* rh_op)
+		{
+			Enqueue(op_compare_u, req, nullptr, nullptr, lh_op, rh_op);
+		};
+
+		// product, overflow = multiplicand * multiplier, as mult_u
+		void Mult(BatchRequest& req, u64* product, u64* overflow, const u64* multiplicand, const u64* multiplier)
+		{
+			Enqueue(op_mult_u, req, product, overflow, multiplicand, multiplier);
+		};
+
+		// quotient, remainder = dividend / divisor, as div_u
+		void Div(BatchRequest& req, u64* quotient, u64* remainder, const u64* dividend, const u64* divisor)
+		{
+			Enqueue(op_div_u, req, quotient, remainder, dividend, divisor);
+		};
+
+		// Blocking wait: flushes the request's kind if it is still pending
+		s16 Await(BatchRequest& req)
+		{
+			if (!req.done)
+			{
+				Flush(req.op, flush_forced);
+			};
+			return req.ret;
+		};
+
+		// co_await form: suspends until a flush completes the request
+		struct Awaiter
+		{
+			BatchRequest* req;
+			bool await_ready() const noexcept { return req->done; };
+			void await_suspend(std::coroutine_handle<> h) noexcept { req->waiter = h; };
+			s16 await_resume() const noexcept { return req->ret; };
+		};
+
+		Awaiter Async(BatchRequest& req)
+		{
+			return Awaiter{ &req };
+		};
+
+		// Flush every kind whose oldest call is past the deadline. Returns the number of requests completed
+		u64 Poll()
+		{
+			const auto now = std::chrono::steady_clock::now();
+			u64 completed = 0;
+			for (int op = 0; op < op_count; op++)
+			{
+				if (!lanes[op].empty() && Overdue(lanes[op].front(), now))
+				{
+					completed += Flush(batch_op(op), flush_deadline);
+				};
+			};
+			return completed;
+		};
+
+		// Flush everything pending. Returns the number of requests completed
+		u64 Flush()
+		{
+			u64 completed = 0;
+			for (int op = 0; op < op_count; op++)
+			{
+				completed += Flush(batch_op(op), flush_forced);
+			};
+			return completed;
+		};
+
+		u64 Pending(batch_op op) const
+		{
+			return lanes[op].size();
+		};
+
+		~BatchContext()
+		{
+			Flush();
+		};
+
+	private:
+		struct ALIGN64 Value
+		{
+			u64 q[8];
+		};
+
+		struct Lane
+		{
+			BatchRequest* req;
+			u64* out1;
+			u64* out2;
+			std::chrono::steady_clock::time_point submitted;
+		};
+
+		std::vector<Lane> lanes[op_count];
+		std::vector<Value> lhs[op_count];
+		std::vector<Value> rhs[op_count];
+		std::vector<Value> outs1;
+		std::vector<Value> outs2;
+		std::vector<s16> rets;
+
+		bool Overdue(const Lane& oldest, std::chrono::steady_clock::time_point now) const
+		{
+			return u64(std::chrono::duration_cast<std::chrono::microseconds>(now - oldest.submitted).count()) >= max_wait_us;
+		};
+
+		void Enqueue(batch_op op, BatchRequest& req, u64* out1, u64* out2, const u64* lh, const u64* rh)
+		{
+			const auto now = std::chrono::steady_clock::now();
+			req.ret = 0;
+			req.done = false;
+			req.op = op;
+			req.waiter = {};
+			lanes[op].push_back({ &req, out1, out2, now });
+			lhs[op].emplace_back();
+			rhs[op].emplace_back();
+			copy_u(lhs[op].back().q, lh);
+			copy_u(rhs[op].back().q, rh);
+			if (lanes[op].size() >= max_batch)
+			{
+				Flush(op, flush_full);
+			}
+			else if (Overdue(lanes[op].front(), now))
+			{
+				Flush(op, flush_deadline);
+			};
+		};
+
+		u64 Flush(batch_op op, flush_cause cause)
+		{
+			const u64 n = lanes[op].size();
+			if (n == 0)
+			{
+				return 0;
+			};
+			outs1.resize(n);
+			outs2.resize(n);
+			rets.assign(n, 0);
+			const u64* a = lhs[op].data()->q;
+			const u64* b = rhs[op].data()->q;
+			u64* o1 = outs1.data()->q;
+			u64* o2 = outs2.data()->q;
+			switch (op)
+			{
+			case op_add_u:
+				if (add_u_n(o1, a, b, n) != 0)
+				{
+					compare_u_n(rets.data(), o1, a, n);					// carried out iff sum < addend1
+					for (s16& r : rets) r = (r < 0) ? 1 : 0;
+				};
+				break;
+			case op_sub_u:
+				if (sub_u_n(o1, a, b, n) != 0)
+				{
+					compare_u_n(rets.data(), a, b, n);					// borrowed iff left < right
+					for (s16& r : rets) r = (r < 0) ? 1 : 0;
+				};
+				break;
+			case op_compare_u:
+				compare_u_n(rets.data(), a, b, n);
+				break;
+			case op_mult_u:
+				for (u64 k = 0; k < n; k++)
+				{
+					rets[k] = mult_u(o1 + k * 8, o2 + k * 8, a + k * 8, b + k * 8);
+				};
+				break;
+			case op_div_u:
+				for (u64 k = 0; k < n; k++)
+				{
+					rets[k] = div_u(o1 + k * 8, o2 + k * 8, a + k * 8, b + k * 8);
+				};
+				break;
+			default:
+				break;
+			};
+
+			// Results out to the callers, then the context is clear for new calls before any coroutine resumes
+			const auto now = std::chrono::steady_clock::now();
+			BatchStats& s = stats[op];
+			std::vector<std::coroutine_handle<>> ready;
+			for (u64 k = 0; k < n; k++)
+			{
+				const Lane& lane = lanes[op][k];
+				if (lane.out1 != nullptr)
+				{
+					copy_u(lane.out1, o1 + k * 8);
+				};
+				if (lane.out2 != nullptr)
+				{
+					copy_u(lane.out2, o2 + k * 8);
+				};
+				const double wait = std::chrono::duration<double, std::nano>(now - lane.submitted).count();
+				s.wait_ns_total += wait;
+				s.wait_ns_max = std::max(s.wait_ns_max, wait);
+				lane.req->ret = rets[k];
+				lane.req->done = true;
+				if (lane.req->waiter)
+				{
+					ready.push_back(lane.req->waiter);
+					lane.req->waiter = {};
+				};
+			};
+			s.requests += n;
+			s.flushes[cause]++;
+			lanes[op].clear();
+			lhs[op].clear();
+			rhs[op].clear();
+			for (std::coroutine_handle<> h : ready)
+			{
+				h.resume();
+			};
+			return n;
+		};
+	};
+
+	// The calling thread's context
+	inline BatchContext& ThisThread()
+	{
+		thread_local BatchContext context;
+		return context;
+	};
+}
+
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef ui512bsgs_h
+#define ui512bsgs_h
+
+//		ui512bsgs.h
+//
+//		File:			ui512bsgs.h
+//		Author:			John G.Lynch
+//		Legal:			Copyright @2024, per MIT License below
+//		Date:			October 19, 2026
+//
+//		Threaded driver for the baby-step giant-step discrete log (bsgs_log_u, bsgs_range_u).
+//		The table of baby steps is built once, on the calling thread; each of the threads then takes every threads'th giant step
+//		against it (read-only), sharing a limit that stops the threads above the lowest giant step with a find.
+//		The result is the one bsgs_log_u gives: the find at the lowest giant step holds the smallest x.
+
+#include "CommonTypeDefs.h"
+#include "ui512md.h"
+
+#include <thread>
+#include <vector>
+
+namespace ui512bsgs
+{
+	// As bsgs_log_u, over threads. Returns 0 with x, -1 if no x within bound or tblbits out of range (x zero),
+	// or the error return of the table build or of a thread (x zero)
+	inline s16 ThreadedLog(u64* x, const u64* g, const u64* h, const u64* ctx, u64 bound, u64* table, u32 tblbits, u32 threads)
+	{
+		*x = 0;
+		if (tblbits < 2 || tblbits > 40)
+		{
+			return -1;
+		};
+		threads = (threads == 0) ? 1 : threads;
+		u64 unused = 0;
+		u64 build[4] = { u64_Max, 1, 0, 1 };						// first giant step beyond all: build the table only
+		const s16 built = bsgs_range_u(&unused, g, h, ctx, bound, table, tblbits, build);
+		if (built != -1)											// a build alone finds nothing, so -1 is its success
+		{
+			return built;
+		};
+
+		u64 limit = u64_Max;
+		std::vector<u64> found(threads, 0);
+		std::vector<s16> rets(threads, -1);
+		std::vector<std::thread> pool;
+		for (u32 t = 0; t < threads; t++)
+		{
+			pool.emplace_back([&, t]()
+				{
+					u64 range[4] = { t, threads, u64(&limit), 0 };
+					rets[t] = bsgs_range_u(&found[t], g, h, ctx, bound, table, tblbits, range);
+				});
+		};
+		for (std::thread& th : pool)
+		{
+			th.join();
+		};
+
+		s16 ret = -1;
+		for (u32 t = 0; t < threads; t++)
+		{
+			if (rets[t] == 0 && (ret != 0 || found[t] < *x))
+			{
+				*x = found[t];
+				ret = 0;
+			}
+			else if (rets[t] != 0 && rets[t] != -1 && ret == -1)
+			{
+				ret = rets[t];
+			};
+		};
+		return ret;
+	};
+}
+
+#endif
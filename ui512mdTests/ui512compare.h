@@ -0,0 +1,226 @@
+#pragma once
+
+#ifndef ui512compare_h
+#define ui512compare_h
+
+//		ui512compare.h
+//
+//		File:			ui512compare.h
+//		Author:			John G.Lynch
+//		Legal:			Copyright @2024, per MIT License below
+//		Date:			October 18, 2026
+//
+//		Comparators for benchmarking the ui512 kernels against other 512 bit implementations.
+//		A plain C++ reference (64 x 64 -> 128 bit multiply, carries by compare, bitwise shift and subtract division) is always available.
+//		Boost.Multiprecision is used when its header is found (UI512_HAVE_BOOST is then 1). GMP is opt in, as it also needs its library:
+//		define UI512_USE_GMP, with gmp.h on the include path and gmp.lib on the linker path (UI512_HAVE_GMP is then 1, and gmp.lib is linked).
+//		Otherwise the benchmark reports them as skipped.
+//		Values here are ui512 layout: 8 QWORDS, most significant first.
+
+#include "CommonTypeDefs.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#if __has_include(<boost/multiprecision/cpp_int.hpp>)
+#include <boost/multiprecision/cpp_int.hpp>
+#define UI512_HAVE_BOOST 1
+#else
+#define UI512_HAVE_BOOST 0
+#endif
+
+#if defined(UI512_USE_GMP) && __has_include(<gmp.h>)
+#include <gmp.h>
+#define UI512_HAVE_GMP 1
+#if defined(_MSC_VER)
+#pragma comment(lib, "gmp.lib")
+#endif
+#else
+#define UI512_HAVE_GMP 0
+#endif
+
+namespace ui512compare
+{
+	inline u64 Cycles()
+	{
+		return __rdtsc();
+	};
+
+	// Plain C++ reference
+
+	inline u64 Mul64(u64 a, u64 b, u64* high)
+	{
+#if defined(_MSC_VER)
+		return _umul128(a, b, high);
+#else
+		unsigned __int128 p = (unsigned __int128)a * b;
+		*high = u64(p >> 64);
+		return u64(p);
+#endif
+	};
+
+	inline s16 ref_add(u64* sum, const u64* addend1, const u64* addend2)
+	{
+		u64 carry = 0;
+		for (int j = 7; j >= 0; j--)
+		{
+			const u64 s = addend1[j] + carry;
+			const u64 c1 = (s < carry) ? 1 : 0;
+			sum[j] = s + addend2[j];
+			carry = c1 + ((sum[j] < s) ? 1 : 0);
+		};
+		return s16(carry);
+	};
+
+	// Full product: overflow (high 512 bits) and product (low 512 bits), as mult_u
+	inline s16 ref_mul(u64* product, u64* overflow, const u64* multiplicand, const u64* multiplier)
+	{
+		u64 wide[16] = { 0 };										// least significant first
+		for (int i = 0; i < 8; i++)
+		{
+			const u64 a = multiplicand[7 - i];
+			u64 carry = 0;
+			for (int j = 0; j < 8; j++)
+			{
+				u64 high = 0;
+				u64 low = Mul64(a, multiplier[7 - j], &high);
+				low += carry;
+				high += (low < carry) ? 1 : 0;
+				wide[i + j] += low;
+				high += (wide[i + j] < low) ? 1 : 0;
+				carry = high;
+			};
+			wide[i + 8] = carry;
+		};
+		for (int j = 0; j < 8; j++)
+		{
+			product[7 - j] = wide[j];
+			overflow[7 - j] = wide[8 + j];
+		};
+		return 0;
+	};
+
+	// Quotient and remainder, as div_u: one bit per step, most significant first. Returns -1 for divide by zero
+	inline s16 ref_div(u64* quotient, u64* remainder, const u64* dividend, const u64* divisor)
+	{
+		u64 any = 0;
+		for (int j = 0; j < 8; j++)
+		{
+			any |= divisor[j];
+		};
+		if (any == 0)
+		{
+			return -1;
+		};
+		u64 q[8] = { 0 };
+		u64 r[8] = { 0 };
+		for (int bit = 0; bit < 512; bit++)
+		{
+			const u64 top = r[0] >> 63;									// r < divisor, so 2r + 1 may need a 513th bit
+			for (int j = 0; j < 7; j++)
+			{
+				r[j] = (r[j] << 1) | (r[j + 1] >> 63);
+			};
+			r[7] = (r[7] << 1) | ((dividend[bit / 64] >> (63 - bit % 64)) & 1);
+			int cmp = 0;
+			for (int j = 0; j < 8 && cmp == 0; j++)
+			{
+				cmp = (r[j] > divisor[j]) ? 1 : (r[j] < divisor[j]) ? -1 : 0;
+			};
+			if (top != 0 || cmp >= 0)
+			{
+				u64 borrow = 0;
+				for (int j = 7; j >= 0; j--)
+				{
+					const u64 d = divisor[j] + borrow;
+					const u64 b1 = (d < borrow) ? 1 : 0;
+					borrow = b1 + ((r[j] < d) ? 1 : 0);
+					r[j] -= d;
+				};
+				q[bit / 64] |= 1ull << (63 - bit % 64);
+			};
+		};
+		for (int j = 0; j < 8; j++)
+		{
+			quotient[j] = q[j];
+			remainder[j] = r[j];
+		};
+		return 0;
+	};
+
+#if UI512_HAVE_BOOST
+	using boost::multiprecision::uint512_t;
+	using boost::multiprecision::uint1024_t;
+
+	template <class T> inline T ToBoost(const u64* v)
+	{
+		T r = 0;
+		for (int j = 0; j < 8; j++)
+		{
+			r = (r << 64) | T(v[j]);
+		};
+		return r;
+	};
+
+	template <class T> inline void FromBoost(u64* v, T x)
+	{
+		for (int j = 7; j >= 0; j--)
+		{
+			v[j] = u64(x & T(u64_Max));
+			x >>= 64;
+		};
+	};
+#endif
+
+#if UI512_HAVE_GMP
+	// GMP limbs are least significant first
+	inline void ToLimbs(mp_limb_t* limbs, const u64* v)
+	{
+		for (int j = 0; j < 8; j++)
+		{
+			limbs[j] = mp_limb_t(v[7 - j]);
+		};
+	};
+
+	inline void FromLimbs(u64* v, const mp_limb_t* limbs)
+	{
+		for (int j = 0; j < 8; j++)
+		{
+			v[7 - j] = u64(limbs[j]);
+		};
+	};
+
+	// Significant limbs (mpn_tdiv_qr needs the divisor's top limb non-zero)
+	inline mp_size_t Limbs(const mp_limb_t* limbs)
+	{
+		mp_size_t n = 8;
+		while (n > 0 && limbs[n - 1] == 0)
+		{
+			n--;
+		};
+		return n;
+	};
+
+	// Quotient and remainder, as div_u, through mpn_tdiv_qr. Returns -1 for divide by zero
+	inline s16 gmp_div(u64* quotient, u64* remainder, const u64* dividend, const u64* divisor)
+	{
+		mp_limb_t n[8], d[8], q[8] = { 0 }, r[8] = { 0 };
+		ToLimbs(n, dividend);
+		ToLimbs(d, divisor);
+		const mp_size_t dn = Limbs(d);
+		if (dn == 0)
+		{
+			return -1;
+		};
+		mpn_tdiv_qr(q, r, 0, n, 8, d, dn);
+		FromLimbs(quotient, q);
+		FromLimbs(remainder, r);
+		return 0;
+	};
+#endif
+}
+
+#endif
@@ -0,0 +1,268 @@
+#pragma once
+
+#ifndef ui512ctxcache_h
+#define ui512ctxcache_h
+
+//		ui512ctxcache.h
+//
+//		File:			ui512ctxcache.h
+//		Author:			John G.Lynch
+//		Legal:			Copyright @2024, per MIT License below
+//		Date:			October 18, 2026
+//
+//		Montgomery context cache, keyed by modulus.
+//		Get(ctx, modulus) copies out the cached context (mont_setup_u) for the modulus, building and inserting it on a miss.
+//		The table is set associative: a hash of the modulus picks a bucket of eight entries. Reads take no lock: each entry
+//		carries a version that is odd while it is written, and a reader retries until it sees the same even version before and
+//		after its copy. Inserts are serialized by a mutex, and replace within the bucket by CLOCK (a referenced bit per entry,
+//		set by readers, cleared as the hand passes). Hits, misses and evictions are counted.
+//		Save / Load write and read the cached moduli, so a process can start warm; contexts are rebuilt on Load.
+
+#include "CommonTypeDefs.h"
+#include "ui512a.h"
+#include "ui512md.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <immintrin.h>
+#include <mutex>
+#include <vector>
+
+namespace ui512ctxcache
+{
+	inline u64 Hash(const u64* modulus)
+	{
+		u64 h = 0;
+		for (int j = 0; j < 8; j++)
+		{
+			h = (h ^ modulus[j]) * 0x9E3779B97F4A7C15ull;
+			h ^= h >> 29;
+		};
+		return h | 1;												// zero marks an empty entry
+	};
+
+	class ContextCache
+	{
+	public:
+		static const int ways = 8;
+		std::atomic<u64> hits = 0;
+		std::atomic<u64> misses = 0;
+		std::atomic<u64> evictions = 0;
+
+		explicit ContextCache(u64 capacity = 4096)
+			: buckets((capacity + ways - 1) / ways == 0 ? 1 : (capacity + ways - 1) / ways), entries(buckets * ways), hands(buckets, 0) {};
+
+		u64 Capacity() const
+		{
+			return buckets * ways;
+		};
+
+		double HitRate() const
+		{
+			const u64 h = hits.load();
+			const u64 total = h + misses.load();
+			return (total == 0) ? 0.0 : double(h) / double(total);
+		};
+
+		// Copy the context for modulus to ctx (32 QWORDS, aligned 64). Returns 0, or -1 for a bad modulus (not cached)
+		s16 Get(u64* ctx, const u64* modulus)
+		{
+			const u64 h = Hash(modulus);
+			if (Find(ctx, modulus, h))
+			{
+				hits.fetch_add(1, std::memory_order_relaxed);
+				return 0;
+			};
+			misses.fetch_add(1, std::memory_order_relaxed);
+			const s16 ret = mont_setup_u(ctx, modulus);
+			if (ret == 0)
+			{
+				Insert(ctx, modulus, h);
+			};
+			return ret;
+		};
+
+		// Cached fast paths: result = a * b mod N, result = a ^ e mod N (a, b below N)
+		s16 ModMul(u64* result, const u64* a, const u64* b, const u64* modulus)
+		{
+			_MONTCTX(ctx);
+			_UI512(ma) { 0 };
+			const s16 ret = Get(ctx, modulus);
+			if (ret == 0)
+			{
+				mont_to_u(ma, a, ctx);
+				mont_mul_u(result, ma, b, ctx);						// (a R) b R^-1 = a b
+			};
+			return ret;
+		};
+
+		s16 ModExp(u64* result, const u64* a, const u64* e, const u64* modulus)
+		{
+			_MONTCTX(ctx);
+			_UI512(ma) { 0 };
+			_UI512(mr) { 0 };
+			const s16 ret = Get(ctx, modulus);
+			if (ret == 0)
+			{
+				mont_to_u(ma, a, ctx);
+				mont_pow_u(mr, ma, e, ctx);
+				mont_from_u(result, mr, ctx);
+			};
+			return ret;
+		};
+
+		// Warm start file: a count, then the moduli (8 QWORDS each)
+		bool Save(const char* path)
+		{
+			std::vector<u64> moduli;
+			{
+				std::lock_guard<std::mutex> lock(writer);
+				for (const Entry& e : entries)
+				{
+					if (e.key.load(std::memory_order_relaxed) != 0)
+					{
+						moduli.insert(moduli.end(), e.modulus, e.modulus + 8);
+					};
+				};
+			};
+			FILE* f = nullptr;
+			if (fopen_s(&f, path, "wb") != 0 || f == nullptr)
+			{
+				return false;
+			};
+			const u64 count = moduli.size() / 8;
+			bool ok = fwrite(&count, sizeof(count), 1, f) == 1;
+			ok = ok && fwrite(moduli.data(), sizeof(u64), moduli.size(), f) == moduli.size();
+			fclose(f);
+			return ok;
+		};
+
+		// Returns the number of moduli loaded, or -1 if the file cannot be read
+		s64 Load(const char* path)
+		{
+			FILE* f = nullptr;
+			if (fopen_s(&f, path, "rb") != 0 || f == nullptr)
+			{
+				return -1;
+			};
+			u64 count = 0;
+			s64 loaded = 0;
+			_MONTCTX(ctx);
+			_UI512(modulus) { 0 };
+			if (fread(&count, sizeof(count), 1, f) == 1)
+			{
+				for (u64 i = 0; i < count && fread(modulus, sizeof(u64), 8, f) == 8; i++)
+				{
+					if (mont_setup_u(ctx, modulus) == 0)
+					{
+						Insert(ctx, modulus, Hash(modulus));
+						loaded++;
+					};
+				};
+			};
+			fclose(f);
+			return loaded;
+		};
+
+	private:
+		struct ALIGN64 Entry
+		{
+			std::atomic<u64> version = 0;							// odd while being written
+			std::atomic<u64> key = 0;								// hash of the modulus, zero if empty
+			std::atomic<u8> referenced = 0;							// CLOCK bit
+			u64 modulus[8] = { 0 };
+			_MONTCTX(ctx) = { 0 };
+		};
+
+		u64 buckets;
+		std::vector<Entry> entries;
+		std::vector<u8> hands;										// CLOCK hand per bucket (under writer)
+		std::mutex writer;
+
+		// The hash's low bit is always set (see Hash), so it takes no part in the bucket choice
+		u64 Bucket(u64 h) const
+		{
+			return (h >> 1) % buckets;
+		};
+
+		bool Find(u64* ctx, const u64* modulus, u64 h)
+		{
+			Entry* bucket = &entries[Bucket(h) * ways];
+			for (int w = 0; w < ways; w++)
+			{
+				Entry& e = bucket[w];
+				if (e.key.load(std::memory_order_acquire) != h)
+				{
+					continue;
+				};
+				bool same = false;
+				for (;;)
+				{
+					const u64 v1 = e.version.load(std::memory_order_acquire);
+					if ((v1 & 1) != 0)
+					{
+						_mm_pause();
+						continue;
+					};
+					same = e.key.load(std::memory_order_relaxed) == h && memcmp(e.modulus, modulus, 64) == 0;
+					if (same)
+					{
+						memcpy(ctx, e.ctx, sizeof(e.ctx));
+					};
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (e.version.load(std::memory_order_relaxed) == v1)
+					{
+						break;
+					};
+				};
+				if (same)
+				{
+					if (e.referenced.load(std::memory_order_relaxed) == 0)
+					{
+						e.referenced.store(1, std::memory_order_relaxed);
+					};
+					return true;
+				};
+			};
+			return false;
+		};
+
+		void Insert(const u64* ctx, const u64* modulus, u64 h)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+			const u64 b = Bucket(h);
+			Entry* bucket = &entries[b * ways];
+			for (int w = 0; w < ways; w++)
+			{
+				if (bucket[w].key.load(std::memory_order_relaxed) == h && memcmp(bucket[w].modulus, modulus, 64) == 0)
+				{
+					return;												// another writer got here first
+				};
+			};
+			Entry* victim = nullptr;
+			while (victim == nullptr)
+			{
+				Entry& e = bucket[hands[b]];
+				hands[b] = u8((hands[b] + 1) % ways);
+				if (e.key.load(std::memory_order_relaxed) == 0 || e.referenced.exchange(0, std::memory_order_relaxed) == 0)
+				{
+					victim = &e;
+				};
+			};
+			if (victim->key.load(std::memory_order_relaxed) != 0)
+			{
+				evictions.fetch_add(1, std::memory_order_relaxed);
+			};
+			victim->version.fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			victim->key.store(h, std::memory_order_relaxed);
+			memcpy(victim->modulus, modulus, 64);
+			memcpy(victim->ctx, ctx, sizeof(victim->ctx));
+			victim->referenced.store(0, std::memory_order_relaxed);
+			victim->version.fetch_add(1, std::memory_order_release);
+		};
+	};
+}
+
+#endif
@@ -13,6 +13,47 @@
 
 #include "CommonTypeDefs.h"
 
+// Montgomery context (see mont_setup_u): modulus, R mod N, R^2 mod N, N', shape. 32 QWORDS, 64 byte aligned
+#define _MONTCTX(name) ALIGN64 u64 name[32]
+
+// Montgomery context shape, as chosen by mont_setup_u: bit j set for a non-zero qword j of the modulus (low order first), and the flags
+// mshape_nprime1 (low qword all ones, N' = 1) and mshape_sparse (at least half the qwords zero), which select mont_mul_u's reduction
+#define _MONTSHAPE(ctx) ((ctx)[25])
+#define mshape_limbs 0xFF
+#define mshape_nprime1 0x100
+#define mshape_sparse 0x200
+
+// Delta table (see delta_pack_u), 8 QWORDS. Caller sets [0] packed bytes address, [1] block offsets address (one QWORD per block),
+// [2] block bounds address (min then max, 16 QWORDS per block, 64 byte aligned) or null, and [4] values per block.
+// delta_pack_u sets [3] count and [5] bytes packed.
+#define _DELTATAB(name) ALIGN64 u64 name[8]
+
+// Seqlock cell (see store_u, load_u): [0] sequence, [8..15] value, on separate cache lines. 16 QWORDS, 64 byte aligned
+#define _UI512CELL(name) ALIGN64 u64 name[16]
+
+// Exponent plan (see exp_plan_u), 144 QWORDS, 64 byte aligned. No addresses, so it may be saved and reloaded.
+// [0] tag, [1] window width, [2] steps, [3] exponent bit length, [4] squarings, [5] multiplies; steps from [8]
+#define _EXPPLAN(name) ALIGN64 u64 name[144]
+
+// Integer logarithm table (see ilog_setup_u), 4232 QWORDS, 64 byte aligned.
+// [0] base, [1] powers held; from [8] a WORD guess per msb; from [136] the powers base^0, base^1, .. 8 QWORDS each
+#define _ILOGTAB(name) ALIGN64 u64 name[4232]
+
+// cmp_u_n, cmp_u_idx predicates (as VPCMPUQ), optionally or'd with cmp_each to compare to per element bounds rather than one threshold
+#define cmp_eq 0
+#define cmp_lt 1
+#define cmp_le 2
+#define cmp_ne 4
+#define cmp_ge 5
+#define cmp_gt 6
+#define cmp_each 8
+
+// div_round_u, div_round_uT64 rounding modes
+#define rnd_floor 0
+#define rnd_ceil 1
+#define rnd_half_even 2
+#define rnd_half_up 3
+
 extern "C"
 {
 	//			signatures ( from ui512md.asm )
@@ -37,6 +78,322 @@ extern "C"
 	//	Prototype:	s16 div_u ( u64 * quotient, u64 * remainder, u64 * dividend, u64 * divisor );
 	s16 div_u(const u64*, const u64*, const u64*, const u64*);
 
+	//	EXTERNDEF	mont_setup_u : PROC
+	//	mont_setup_u	prepare Montgomery context (N, R mod N, R^2 mod N, N', shape) for odd modulus N, R = 2^512; returns -1 for even modulus
+	//	Prototype:	s16 mont_setup_u ( u64 * ctx, u64 * modulus );
+	s16 mont_setup_u(const u64*, const u64*);
+
+	//	EXTERNDEF	mont_mul_u : PROC
+	//	mont_mul_u	Montgomery multiply, result = lh_op * rh_op * R^-1 mod N (operands in Montgomery form, less than N)
+	//	Prototype:	s16 mont_mul_u ( u64 * result, u64 * lh_op, u64 * rh_op, u64 * ctx );
+	s16 mont_mul_u(const u64*, const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	mont_to_u : PROC
+	//	mont_to_u	convert source (less than N) into Montgomery form, result = source * R mod N
+	//	Prototype:	s16 mont_to_u ( u64 * result, u64 * source, u64 * ctx );
+	s16 mont_to_u(const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	mont_from_u : PROC
+	//	mont_from_u	convert source out of Montgomery form, result = source * R^-1 mod N
+	//	Prototype:	s16 mont_from_u ( u64 * result, u64 * source, u64 * ctx );
+	s16 mont_from_u(const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	mont_pow_uT64 : PROC
+	//	mont_pow_uT64	raise base (Montgomery form) to 64 bit exponent, result in Montgomery form
+	//	Prototype:	s16 mont_pow_uT64 ( u64 * result, u64 * base, u64 exponent, u64 * ctx );
+	s16 mont_pow_uT64(const u64*, const u64*, const u64, const u64*);
+
+	//	EXTERNDEF	bsgs_log_u : PROC
+	//	bsgs_log_u	baby-step giant-step discrete log: find x <= bound with g^x = h mod N. Table is 2^tblbits entries of 16 bytes,
+	//				holding 2^(tblbits-1) baby steps; larger table, fewer giant steps. Returns -1 if not found.
+	//	Prototype:	s16 bsgs_log_u ( u64 * x, u64 * g, u64 * h, u64 * ctx, u64 bound, u64 * table, u32 tblbits );
+	s16 bsgs_log_u(const u64*, const u64*, const u64*, const u64*, const u64, const u64*, const u32);
+
+	//	EXTERNDEF	bsgs_range_u : PROC
+	//	bsgs_range_u	as bsgs_log_u, over one share of the giant steps. range is 4 QWORDS: first giant step, stride, address of a shared limit
+	//				(or null; start it at u64_Max; lowered to the giant step of a find), and build (non-zero to fill the table first, else use it as built).
+	//				Threads share one table (see ui512bsgs.h). Returns -1 if not found in this share.
+	//	Prototype:	s16 bsgs_range_u ( u64 * x, u64 * g, u64 * h, u64 * ctx, u64 bound, u64 * table, u32 tblbits, u64 * range );
+	s16 bsgs_range_u(const u64*, const u64*, const u64*, const u64*, const u64, const u64*, const u32, const u64*);
+
+	//	EXTERNDEF	mont_add_u : PROC
+	//	mont_add_u	modular add, result = lh_op + rh_op mod N (operands less than N, either form)
+	//	Prototype:	s16 mont_add_u ( u64 * result, u64 * lh_op, u64 * rh_op, u64 * ctx );
+	s16 mont_add_u(const u64*, const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	mont_sub_u : PROC
+	//	mont_sub_u	modular subtract, result = lh_op - rh_op mod N (operands less than N, either form)
+	//	Prototype:	s16 mont_sub_u ( u64 * result, u64 * lh_op, u64 * rh_op, u64 * ctx );
+	s16 mont_sub_u(const u64*, const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	mont_pow_u : PROC
+	//	mont_pow_u	raise base (Montgomery form) to 512 bit exponent, result in Montgomery form
+	//	Prototype:	s16 mont_pow_u ( u64 * result, u64 * base, u64 * exponent, u64 * ctx );
+	s16 mont_pow_u(const u64*, const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	mont_inv_u : PROC
+	//	mont_inv_u	modular inverse for prime modulus (Fermat), Montgomery form in and out; returns -1 for zero
+	//	Prototype:	s16 mont_inv_u ( u64 * result, u64 * source, u64 * ctx );
+	s16 mont_inv_u(const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	mont_batchinv_u : PROC
+	//	mont_batchinv_u	invert count values with one modular inverse (Montgomery's trick); results must not be values; returns -1 if any is zero
+	//	Prototype:	s16 mont_batchinv_u ( u64 * results, u64 * values, u64 count, u64 * ctx );
+	s16 mont_batchinv_u(const u64*, const u64*, const u64, const u64*);
+
+	//	EXTERNDEF	shamir_split_u : PROC
+	//	shamir_split_u	Shamir shares: evaluate polynomial of k coefficients (coeffs[0] is the secret) at n points, Montgomery form
+	//	Prototype:	s16 shamir_split_u ( u64 * shares, u64 * coeffs, u64 k, u64 * xs, u64 n, u64 * ctx );
+	s16 shamir_split_u(const u64*, const u64*, const u64, const u64*, const u64, const u64*);
+
+	//	EXTERNDEF	shamir_lagrange_u : PROC
+	//	shamir_lagrange_u	Lagrange coefficients at zero for k share points; keep and reuse for a fixed point set. Returns -1 for repeated points
+	//	Prototype:	s16 shamir_lagrange_u ( u64 * lambdas, u64 * xs, u64 k, u64 * ctx, u64 * scratch );
+	s16 shamir_lagrange_u(const u64*, const u64*, const u64, const u64*, const u64*);
+
+	//	EXTERNDEF	shamir_combine_u : PROC
+	//	shamir_combine_u	Shamir reconstruction: secret = sum of lambda[i] * share[i], Montgomery form
+	//	Prototype:	s16 shamir_combine_u ( u64 * secret, u64 * lambdas, u64 * shares, u64 k, u64 * ctx );
+	s16 shamir_combine_u(const u64*, const u64*, const u64*, const u64, const u64*);
+
+	//	EXTERNDEF	adds_u : PROC
+	//	adds_u	saturating add: sum = addend1 + addend2, clamped at 2^512 - 1. Returns 1 if saturated
+	//	Prototype:	s16 adds_u ( u64 * sum, u64 * addend1, u64 * addend2 );
+	s16 adds_u(const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	subs_u : PROC
+	//	subs_u	saturating subtract: difference = left - right, clamped at zero. Returns 1 if saturated
+	//	Prototype:	s16 subs_u ( u64 * difference, u64 * left operand, u64 * right operand );
+	s16 subs_u(const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	muls_u : PROC
+	//	muls_u	saturating multiply: product = multiplicand * multiplier, clamped at 2^512 - 1. Returns 1 if saturated
+	//	Prototype:	s16 muls_u ( u64 * product, u64 * multiplicand, u64 * multiplier );
+	s16 muls_u(const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	adds_u_n : PROC
+	//	adds_u_n	saturating add of arrays of count 512 bit elements. Returns the number of elements that saturated
+	//	Prototype:	u64 adds_u_n ( u64 * sums, u64 * addends1, u64 * addends2, u64 count );
+	u64 adds_u_n(const u64*, const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	subs_u_n : PROC
+	//	subs_u_n	saturating subtract of arrays of count 512 bit elements. Returns the number of elements that saturated
+	//	Prototype:	u64 subs_u_n ( u64 * differences, u64 * left operands, u64 * right operands, u64 count );
+	u64 subs_u_n(const u64*, const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	muls_u_n : PROC
+	//	muls_u_n	saturating multiply of arrays of count 512 bit elements. Returns the number of elements that saturated
+	//	Prototype:	u64 muls_u_n ( u64 * products, u64 * multiplicands, u64 * multipliers, u64 count );
+	u64 muls_u_n(const u64*, const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	sum_u_n : PROC
+	//	sum_u_n	sum of count 512 bit values; carries are counted per qword lane and resolved once at the end. Returns the bits above 512
+	//	Prototype:	u64 sum_u_n ( u64 * sum, u64 * values, u64 count );
+	u64 sum_u_n(const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	argmax_u_n : PROC
+	//	argmax_u_n	index of the largest of count 512 bit values (first of equals). Returns -1 if count is zero
+	//	Prototype:	s64 argmax_u_n ( u64 * values, u64 count );
+	s64 argmax_u_n(const u64*, const u64);
+
+	//	EXTERNDEF	argmin_u_n : PROC
+	//	argmin_u_n	index of the smallest of count 512 bit values (first of equals). Returns -1 if count is zero
+	//	Prototype:	s64 argmin_u_n ( u64 * values, u64 count );
+	s64 argmin_u_n(const u64*, const u64);
+
+	//	EXTERNDEF	max_u_n : PROC
+	//	max_u_n	copy the largest of count 512 bit values. Returns -1 if count is zero
+	//	Prototype:	s16 max_u_n ( u64 * maximum, u64 * values, u64 count );
+	s16 max_u_n(const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	min_u_n : PROC
+	//	min_u_n	copy the smallest of count 512 bit values. Returns -1 if count is zero
+	//	Prototype:	s16 min_u_n ( u64 * minimum, u64 * values, u64 count );
+	s16 min_u_n(const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	cmp_u_n : PROC
+	//	cmp_u_n	compare count 512 bit values to a threshold (or, with cmp_each, to count bounds); bit i of the packed masks is the result for value i
+	//	masks needs ( count + 63 ) / 64 QWORDS. Returns the number of values for which the predicate holds
+	//	Prototype:	u64 cmp_u_n ( u64 * masks, u64 * values, u64 * bounds, u64 count, u64 predicate );
+	u64 cmp_u_n(const u64*, const u64*, const u64*, const u64, const u64);
+
+	//	EXTERNDEF	msb_uZ : PROC
+	//	msb_uZ	as msb_u, branch free: index of the most significant set bit, -1 for zero
+	//	Prototype:	s16 msb_uZ ( u64 * source );
+	s16 msb_uZ(const u64*);
+
+	//	EXTERNDEF	lsb_uZ : PROC
+	//	lsb_uZ	as lsb_u, branch free: index of the least significant set bit, -1 for zero
+	//	Prototype:	s16 lsb_uZ ( u64 * source );
+	s16 lsb_uZ(const u64*);
+
+	//	EXTERNDEF	msb_u_n : PROC
+	//	msb_u_n	most significant bit index of each of count 512 bit values, -1 for zero
+	//	Prototype:	s16 msb_u_n ( s16 * results, u64 * values, u64 count );
+	s16 msb_u_n(const s16*, const u64*, const u64);
+
+	//	EXTERNDEF	lsb_u_n : PROC
+	//	lsb_u_n	least significant bit index of each of count 512 bit values, -1 for zero
+	//	Prototype:	s16 lsb_u_n ( s16 * results, u64 * values, u64 count );
+	s16 lsb_u_n(const s16*, const u64*, const u64);
+
+	//	EXTERNDEF	limbs_u_n : PROC
+	//	limbs_u_n	number of significant qwords (0 to 8) of each of count 512 bit values
+	//	Prototype:	s16 limbs_u_n ( s16 * results, u64 * values, u64 count );
+	s16 limbs_u_n(const s16*, const u64*, const u64);
+
+	//	EXTERNDEF	pack_u_n : PROC
+	//	pack_u_n	pack count 512 bit values, each as a length byte then its significant bytes (least significant first); zero packs as one byte
+	//	packed needs up to count * 65 bytes. If index is not null and k is not zero, index [ j ] receives the byte offset of entry j * k
+	//	Prototype:	u64 pack_u_n ( u8 * packed, u64 * values, u64 count, u64 * index, u64 k );  returns bytes packed
+	u64 pack_u_n(const u8*, const u64*, const u64, const u64*, const u64);
+
+	//	EXTERNDEF	unpack_u_n : PROC
+	//	unpack_u_n	unpack count values from pack_u_n form. Returns bytes consumed, -1 for a bad length byte
+	//	Prototype:	s64 unpack_u_n ( u64 * values, u8 * packed, u64 count );
+	s64 unpack_u_n(const u64*, const u8*, const u64);
+
+	//	EXTERNDEF	unpack_at_u : PROC
+	//	unpack_at_u	unpack entry number 'entry' from pack_u_n form using its index. Returns the entry's byte offset, -1 for k of zero or a bad length byte
+	//	Prototype:	s64 unpack_at_u ( u64 * value, u8 * packed, u64 * index, u64 k, u64 entry );
+	s64 unpack_at_u(const u64*, const u8*, const u64*, const u64, const u64);
+
+	//	EXTERNDEF	delta_pack_u : PROC
+	//	delta_pack_u	pack a sorted array as blocks: first value in full, then differences, all in pack_u_n form; block offsets and min / max to tab
+	//	Prototype:	s64 delta_pack_u ( u64 * tab, u64 * values, u64 count );  returns bytes packed, -1 for a block size of zero or values out of order
+	s64 delta_pack_u(const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	delta_unpack_block_u : PROC
+	//	delta_unpack_block_u	decode one block of a delta table (unpack, then running add). Returns values decoded, -1 if out of range
+	//	Prototype:	s64 delta_unpack_block_u ( u64 * values, u64 * tab, u64 block );
+	s64 delta_unpack_block_u(const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	delta_lower_bound_u : PROC
+	//	delta_lower_bound_u	index of the first value not less than key (count if none), copied to result; decodes only that block. Needs bounds
+	//	Prototype:	s64 delta_lower_bound_u ( u64 * result, u64 * tab, u64 * key, u64 * scratch );
+	s64 delta_lower_bound_u(const u64*, const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	store_u : PROC
+	//	store_u		publish value into a seqlock cell (_UI512CELL); one writer per cell
+	//	Prototype:	s16 store_u ( u64 * cell, u64 * value );
+	s16 store_u(const u64*, const u64*);
+
+	//	EXTERNDEF	load_u : PROC
+	//	load_u		read a consistent value from a seqlock cell, without locking; retries while a store is in progress
+	//	Prototype:	s16 load_u ( u64 * value, u64 * cell );
+	s16 load_u(const u64*, const u64*);
+
+	//	EXTERNDEF	add_u_idx : PROC
+	//	add_u_idx	sums [ i ] (or sums [ res_idx [ i ] ]) = lh_table [ lh_idx [ i ] ] + rh_table [ rh_idx [ i ] ], for i < count; res_idx null for dense. Returns carries out
+	//	Prototype:	u64 add_u_idx ( u64 * sums, u64 * res_idx, u64 * lh_table, u64 * lh_idx, u64 * rh_table, u64 * rh_idx, u64 count );
+	u64 add_u_idx(const u64*, const u64*, const u64*, const u64*, const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	mult_u_idx : PROC
+	//	mult_u_idx	products and overflows [ i ] (or [ res_idx [ i ] ]) = lh_table [ lh_idx [ i ] ] * rh_table [ rh_idx [ i ] ], for i < count; res_idx null for dense
+	//	Prototype:	s16 mult_u_idx ( u64 * products, u64 * overflows, u64 * res_idx, u64 * lh_table, u64 * lh_idx, u64 * rh_table, u64 * rh_idx, u64 count );
+	s16 mult_u_idx(const u64*, const u64*, const u64*, const u64*, const u64*, const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	cmp_u_idx : PROC
+	//	cmp_u_idx	bit i of masks (as cmp_u_n) = lh_table [ lh_idx [ i ] ] predicate rh_table [ rh_idx [ i ] ], for i < count. Returns the number true
+	//	Prototype:	u64 cmp_u_idx ( u64 * masks, u64 * lh_table, u64 * lh_idx, u64 * rh_table, u64 * rh_idx, u64 count, u64 predicate );
+	u64 cmp_u_idx(const u64*, const u64*, const u64*, const u64*, const u64*, const u64, const u64);
+
+	//	EXTERNDEF	exp_plan_u : PROC
+	//	exp_plan_u	plan exponentiation by a fixed exponent: sliding window of the cheapest width, steps recorded in plan (_EXPPLAN)
+	//	Prototype:	s16 exp_plan_u ( u64 * plan, u64 * exponent );
+	s16 exp_plan_u(const u64*, const u64*);
+
+	//	EXTERNDEF	exp_exec_u : PROC
+	//	exp_exec_u	raise base (Montgomery form) to the plan's exponent, result in Montgomery form; returns -1 for a bad plan
+	//	Prototype:	s16 exp_exec_u ( u64 * result, u64 * base, u64 * plan, u64 * ctx );
+	s16 exp_exec_u(const u64*, const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	mult_lo_u : PROC
+	//	mult_lo_u	truncated multiply, product = low 512 bits of multiplicand * multiplier (product mod 2^512)
+	//	Prototype:	s16 mult_lo_u ( u64 * product, u64 * multiplicand, u64 * multiplier );
+	s16 mult_lo_u(const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	pow_u : PROC
+	//	pow_u		integer power, result = x ^ k; returns 1 for overflow (result zero), decided up front from msb_u ( x ) where it can be
+	//	Prototype:	s16 pow_u ( u64 * result, u64 * x, u64 k );
+	s16 pow_u(const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	ilog_setup_u : PROC
+	//	ilog_setup_u	build table (_ILOGTAB) for logarithms to base: the powers that fit in 512 bits, and a guess per msb. Returns -1 for base < 2
+	//	Prototype:	s16 ilog_setup_u ( u64 * table, u64 base );
+	s16 ilog_setup_u(const u64*, const u64);
+
+	//	EXTERNDEF	ilog_u : PROC
+	//	ilog_u		integer logarithm, floor ( log x ) to the table's base, by msb_u, the guess and one compare_u; returns -1 for zero
+	//	Prototype:	s16 ilog_u ( u64 * x, u64 * table );
+	s16 ilog_u(const u64*, const u64*);
+
+	//	EXTERNDEF	ilog_u_n : PROC
+	//	ilog_u_n	results [ i ] = ilog_u ( values [ i ], table ), for i < count
+	//	Prototype:	s16 ilog_u_n ( s16 * results, u64 * values, u64 count, u64 * table );
+	s16 ilog_u_n(const s16*, const u64*, const u64, const u64*);
+
+	//	EXTERNDEF	ilog10_u : PROC
+	//	ilog10_u	decimal logarithm, floor ( log10 x ): x has ilog10_u + 1 digits. Built in table, no setup; returns -1 for zero
+	//	Prototype:	s16 ilog10_u ( u64 * x );
+	s16 ilog10_u(const u64*);
+
+	//	EXTERNDEF	ilog10_u_n : PROC
+	//	ilog10_u_n	results [ i ] = ilog10_u ( values [ i ] ), for i < count
+	//	Prototype:	s16 ilog10_u_n ( s16 * results, u64 * values, u64 count );
+	s16 ilog10_u_n(const s16*, const u64*, const u64);
+
+	//	EXTERNDEF	div_round_u : PROC
+	//	div_round_u	quotient = dividend / divisor, rounded by mode (rnd_floor, rnd_ceil, rnd_half_even, rnd_half_up); no remainder returned.
+	//				Quotient may not overlap dividend or divisor. Returns -1 for divide by zero or an unknown mode
+	//	Prototype:	s16 div_round_u ( u64 * quotient, u64 * dividend, u64 * divisor, u64 mode );
+	s16 div_round_u(const u64*, const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	div_round_uT64 : PROC
+	//	div_round_uT64	quotient = dividend / divisor, rounded by mode, for a 64 bit divisor; quotient may be the dividend. Returns -1 as div_round_u
+	//	Prototype:	s16 div_round_uT64 ( u64 * quotient, u64 * dividend, u64 divisor, u64 mode );
+	s16 div_round_uT64(const u64*, const u64*, const u64, const u64);
+
+	//	EXTERNDEF	mult_uT128 : PROC
+	//	mult_uT128	multiply by a 128 bit multiplier (2 QWORDS, most significant first), product 8 QWORDS, overflow 2 QWORDS. Unrolled, MULX / ADX
+	//	Prototype:	s16 mult_uT128 ( u64 * product, u64 * overflow, u64 * multiplicand, u64 * multiplier );
+	s16 mult_uT128(const u64*, const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	mult_uT256 : PROC
+	//	mult_uT256	multiply by a 256 bit multiplier (4 QWORDS, most significant first), product 8 QWORDS, overflow 4 QWORDS. Unrolled, MULX / ADX
+	//	Prototype:	s16 mult_uT256 ( u64 * product, u64 * overflow, u64 * multiplicand, u64 * multiplier );
+	s16 mult_uT256(const u64*, const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	add_uZ : PROC
+	//	add_uZ		as add_u, sum = addend1 + addend2, returns the carry; one ZMM, carries resolved on the mask registers (add_u without __UseZ)
+	//	Prototype:	s16 add_uZ ( u64 * sum, u64 * addend1, u64 * addend2 );
+	s16 add_uZ(const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	sub_uZ : PROC
+	//	sub_uZ		as sub_u, difference = left - right, returns the borrow; one ZMM, borrows resolved on the mask registers (sub_u without __UseZ)
+	//	Prototype:	s16 sub_uZ ( u64 * difference, u64 * left, u64 * right );
+	s16 sub_uZ(const u64*, const u64*, const u64*);
+
+	//	EXTERNDEF	compare_uZ : PROC
+	//	compare_uZ	as compare_u, -1, 0, 1; branch free from two lane compares (compare_u without __UseZ)
+	//	Prototype:	s16 compare_uZ ( u64 * lh_op, u64 * rh_op );
+	s16 compare_uZ(const u64*, const u64*);
+
+	//	EXTERNDEF	add_u_n : PROC
+	//	add_u_n		sums [ i ] = addends1 [ i ] + addends2 [ i ], for i < count. Returns the number of carries out
+	//	Prototype:	u64 add_u_n ( u64 * sums, u64 * addends1, u64 * addends2, u64 count );
+	u64 add_u_n(const u64*, const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	sub_u_n : PROC
+	//	sub_u_n		differences [ i ] = lefts [ i ] - rights [ i ], for i < count. Returns the number of borrows out
+	//	Prototype:	u64 sub_u_n ( u64 * differences, u64 * lefts, u64 * rights, u64 count );
+	u64 sub_u_n(const u64*, const u64*, const u64*, const u64);
+
+	//	EXTERNDEF	compare_u_n : PROC
+	//	compare_u_n	results [ i ] = compare_u ( lh_ops [ i ], rh_ops [ i ] ), for i < count
+	//	Prototype:	s16 compare_u_n ( s16 * results, u64 * lh_ops, u64 * rh_ops, u64 count );
+	s16 compare_u_n(const s16*, const u64*, const u64*, const u64);
+
 	// void reg_verify(u64* regstruct);
 	// reg_verify - copy non-volatile regs into callers struct of nine qwords) intended for unit tests to verify non-volatile regs are not changed
 	void reg_verify(const u64*);
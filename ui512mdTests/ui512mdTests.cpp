@@ -17,12 +17,27 @@
 #include "ui512a.h"
 #include "ui512b.h"
 #include "ui512md.h"
+#include "ui512trace.h"
+#include "ui512compare.h"
+#include "ui512variants.h"
+#include "ui512service.h"
+#include "ui512ctxcache.h"
+#include "ui512sweep.h"
+#include "ui512batch.h"
+#include "ui512bsgs.h"
 #include "CommonTypeDefs.h"
 
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
 #include <cstring>
 #include <sstream>
 #include <format>
 #include <chrono>
+#include <mutex>
+#include <filesystem>
+#include <thread>
 
 using namespace std;
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -2414,5 +2429,3569 @@ namespace ui512mdTests
 				outliers.clear();
 			};
 		}
+
+		TEST_METHOD(ui512md_05_mont)
+		{
+			// Montgomery context, multiply, conversions, and 64 bit power
+			// Note: a modulus of 256 bits keeps products within 512 bits, so mult_u and div_u can build "expected"
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_MONTCTX(ctx);
+			_UI512(modulus) { 0 };
+			_UI512(num1) { 0 };
+			_UI512(num2) { 0 };
+			_UI512(mnum1) { 0 };
+			_UI512(mnum2) { 0 };
+			_UI512(result) { 0 };
+			_UI512(product) { 0 };
+			_UI512(overflow) { 0 };
+			_UI512(quotient) { 0 };
+			_UI512(expected) { 0 };
+
+			// random odd modulus of 256 bits, and random operands reduced below it
+			auto RandomModulus256 = [&]()
+				{
+					zero_u(modulus);
+					for (int j = 4; j < 8; j++)
+					{
+						modulus[j] = RandomU64(&seed);
+					};
+					modulus[4] |= 0x8000000000000000ull;
+					modulus[7] |= 1ull;
+				};
+			auto RandomBelow = [&](u64* var)
+				{
+					RandomFill(product, &seed);
+					div_u(quotient, var, product, modulus);
+				};
+
+			// 1. even modulus, and one, are rejected
+			set_uT64(modulus, 2ull);
+			Assert::AreEqual(s16(-1), mont_setup_u(ctx, modulus), L"Return code failed even modulus test.");
+			set_uT64(modulus, 1ull);
+			Assert::AreEqual(s16(-1), mont_setup_u(ctx, modulus), L"Return code failed modulus of one test.");
+
+			// 2. multiply, compared to mult_u then div_u
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomModulus256();
+				RandomBelow(num1);
+				RandomBelow(num2);
+				reg_verify((u64*)&r_before);
+				s16 ret = mont_setup_u(ctx, modulus);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Return code failed Montgomery setup test.");
+				mult_u(product, overflow, num1, num2);
+				div_u(quotient, expected, product, modulus);
+				mont_to_u(mnum1, num1, ctx);
+				mont_to_u(mnum2, num2, ctx);
+				reg_verify((u64*)&r_before);
+				ret = mont_mul_u(result, mnum1, mnum2, ctx);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Return code failed Montgomery multiply test.");
+				mont_from_u(result, result, ctx);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Product at word #" << j << " failed Montgomery multiply on run #" << i));
+				};
+			};
+
+			// 3. full 512 bit modulus: into and out of Montgomery form gives back the original
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomFill(modulus, &seed);
+				modulus[0] |= 0x8000000000000000ull;
+				modulus[7] |= 1ull;
+				RandomFill(num1, &seed);
+				num1[0] &= 0x7FFFFFFFFFFFFFFFull;
+				Assert::AreEqual(s16(0), mont_setup_u(ctx, modulus), L"Return code failed Montgomery setup test.");
+				mont_to_u(mnum1, num1, ctx);
+				mont_from_u(result, mnum1, ctx);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(num1[j], result[j], _MSGW(L"Round trip at word #" << j << " failed on run #" << i));
+				};
+			};
+
+			// 4. power, 64 bit exponent, compared to square and multiply using mult_u then div_u
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomModulus256();
+				RandomBelow(num1);
+				u64 exponent = RandomU64(&seed);
+				set_uT64(expected, 1ull);
+				for (int b = 63; b >= 0; b--)
+				{
+					mult_u(product, overflow, expected, expected);
+					div_u(quotient, expected, product, modulus);
+					if ((exponent >> b) & 1ull)
+					{
+						mult_u(product, overflow, expected, num1);
+						div_u(quotient, expected, product, modulus);
+					};
+				};
+				mont_setup_u(ctx, modulus);
+				mont_to_u(mnum1, num1, ctx);
+				reg_verify((u64*)&r_before);
+				s16 ret = mont_pow_uT64(result, mnum1, exponent, ctx);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Return code failed Montgomery power test.");
+				mont_from_u(result, result, ctx);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Power at word #" << j << " failed on run #" << i));
+				};
+			};
+
+			string test_message = _MSGA("Montgomery function testing.\n\tsetup: rejects even modulus,\n\tmultiply: compared to multiply then divide,"
+				"\n\tconversion into and out of Montgomery form,\n\tpower by 64 bit exponent: compared to square and multiply.\n"
+				<< test_run_count << " times each, with pseudo random values.\n");
+			Logger::WriteMessage(test_message.c_str());
+			Logger::WriteMessage(L"Passed. Tested expected values, return value, and volatile register integrity: each via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_06_bsgs)
+		{
+			// Baby-step giant-step discrete log: build h = g^x with a random x under the bound, recover an exponent for h
+			// Note: if g has small order, the recovered exponent may differ from x, so the test confirms g^found = h
+			// Then the giant steps split over threads (bsgs_range_u, via ui512bsgs.h) must recover the serial result
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			const s32 bsgs_run_count = 100;
+			const u32 tblbits = 12;
+			const u64 bound = 1ull << 20;
+			const u32 bsgs_threads = 4;
+			std::vector<u64> table(2ull << tblbits);
+			_MONTCTX(ctx);
+			_UI512(modulus) { 0 };
+			_UI512(g) { 0 };
+			_UI512(h) { 0 };
+			_UI512(work) { 0 };
+			_UI512(quotient) { 0 };
+
+			for (int i = 0; i < bsgs_run_count; i++)
+			{
+				zero_u(modulus);
+				for (int j = 4; j < 8; j++)
+				{
+					modulus[j] = RandomU64(&seed);
+				};
+				modulus[4] |= 0x8000000000000000ull;
+				modulus[7] |= 1ull;
+				RandomFill(work, &seed);
+				div_u(quotient, g, work, modulus);
+				mont_setup_u(ctx, modulus);
+
+				u64 x = RandomU64(&seed) % bound;
+				mont_to_u(work, g, ctx);
+				mont_pow_uT64(work, work, x, ctx);
+				mont_from_u(h, work, ctx);
+
+				u64 found = 0;
+				reg_verify((u64*)&r_before);
+				s16 ret = bsgs_log_u(&found, g, h, ctx, bound, table.data(), tblbits);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, _MSGW(L"Return code failed discrete log on run #" << i));
+				Assert::IsTrue(found <= bound, _MSGW(L"Exponent beyond bound on run #" << i));
+				mont_to_u(work, g, ctx);
+				mont_pow_uT64(work, work, found, ctx);
+				mont_from_u(work, work, ctx);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(h[j], work[j], _MSGW(L"g^x at word #" << j << " failed on run #" << i));
+				};
+
+				u64 threaded = 1;
+				ret = ui512bsgs::ThreadedLog(&threaded, g, h, ctx, bound, table.data(), tblbits, bsgs_threads);
+				Assert::AreEqual(s16(0), ret, _MSGW(L"Return code failed threaded discrete log on run #" << i));
+				Assert::AreEqual(found, threaded, _MSGW(L"Threaded exponent differs from serial on run #" << i));
+			};
+
+			// Not found: h unrelated to g, with a tiny bound
+			RandomFill(work, &seed);
+			div_u(quotient, h, work, modulus);
+			u64 found = 1;
+			s16 ret = bsgs_log_u(&found, g, h, ctx, 100ull, table.data(), tblbits);
+			Assert::AreEqual(s16(-1), ret, L"Return code failed not found test.");
+			Assert::AreEqual(0ull, found, L"Exponent not zeroed on not found test.");
+			found = 1;
+			ret = ui512bsgs::ThreadedLog(&found, g, h, ctx, 100ull, table.data(), tblbits, bsgs_threads);
+			Assert::AreEqual(s16(-1), ret, L"Return code failed threaded not found test.");
+			Assert::AreEqual(0ull, found, L"Exponent not zeroed on threaded not found test.");
+			found = 1;
+			ret = ui512bsgs::ThreadedLog(&found, g, h, ctx, 100ull, table.data(), 1, bsgs_threads);
+			Assert::AreEqual(s16(-1), ret, L"Return code failed threaded table size out of range test.");
+			Assert::AreEqual(0ull, found, L"Exponent not zeroed on threaded table size out of range test.");
+
+			string test_message = _MSGA("Discrete log (baby-step giant-step) testing.\n\tbound " << bound << ", table of " << (1ull << tblbits)
+				<< " entries,\n\t" << bsgs_run_count << " times with pseudo random base and exponent, then once not found;\n\tthe same split over "
+				<< bsgs_threads << " threads, compared to the serial result.\n");
+			Logger::WriteMessage(test_message.c_str());
+			Logger::WriteMessage(L"Passed. Tested expected values, return value, and volatile register integrity: each via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_07_shamir)
+		{
+			// Modular add, subtract, inverse, batch inverse, and Shamir secret sharing over the prime 2^255 - 19
+			// Note: the ui512md_05_mont tests must pass first, as setup, multiply and conversions are used here
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_MONTCTX(ctx);
+			_UI512(prime) { 0, 0, 0, 0, 0x7FFFFFFFFFFFFFFFull, u64_Max, u64_Max, 0xFFFFFFFFFFFFFFEDull };
+			_UI512(num1) { 0 };
+			_UI512(num2) { 0 };
+			_UI512(result) { 0 };
+			_UI512(expected) { 0 };
+			_UI512(work) { 0 };
+			_UI512(quotient) { 0 };
+			_UI512(one) { 0 };
+
+			set_uT64(one, 1ull);
+			Assert::AreEqual(s16(0), mont_setup_u(ctx, prime), L"Return code failed Montgomery setup.");
+			auto RandomBelow = [&](u64* var)
+				{
+					RandomFill(work, &seed);
+					div_u(quotient, var, work, prime);
+				};
+
+			// 1. add and subtract, compared to add_u / sub_u with explicit reduction
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomBelow(num1);
+				RandomBelow(num2);
+				add_u(expected, num1, num2);
+				if (compare_u(expected, prime) >= 0)
+				{
+					sub_u(expected, expected, prime);
+				};
+				reg_verify((u64*)&r_before);
+				s16 ret = mont_add_u(result, num1, num2, ctx);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Return code failed modular add test.");
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Sum at word #" << j << " failed on run #" << i));
+				};
+				mont_sub_u(result, result, num2, ctx);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(num1[j], result[j], _MSGW(L"Difference at word #" << j << " failed on run #" << i));
+				};
+			};
+
+			// 2. inverse: a * a^-1 = 1, and zero has no inverse
+			for (int i = 0; i < test_run_count / 10; i++)
+			{
+				RandomBelow(num1);
+				mont_to_u(num1, num1, ctx);
+				reg_verify((u64*)&r_before);
+				s16 ret = mont_inv_u(result, num1, ctx);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Return code failed modular inverse test.");
+				mont_mul_u(result, result, num1, ctx);
+				mont_from_u(result, result, ctx);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(one[j], result[j], _MSGW(L"Inverse at word #" << j << " failed on run #" << i));
+				};
+			};
+			zero_u(num1);
+			Assert::AreEqual(s16(-1), mont_inv_u(result, num1, ctx), L"Return code failed inverse of zero test.");
+
+			// 3. batch inverse
+			{
+				const u64 count = 33;
+				std::vector<u64> values(count * 8 + 8);
+				std::vector<u64> inverses(count * 8 + 8);
+				u64* v = (u64*)((uintptr_t(values.data()) + 63) & ~uintptr_t(63));
+				u64* inv = (u64*)((uintptr_t(inverses.data()) + 63) & ~uintptr_t(63));
+				for (u64 i = 0; i < count; i++)
+				{
+					RandomBelow(num1);
+					mont_to_u(&v[i * 8], num1, ctx);
+				};
+				reg_verify((u64*)&r_before);
+				s16 ret = mont_batchinv_u(inv, v, count, ctx);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Return code failed batch inverse test.");
+				for (u64 i = 0; i < count; i++)
+				{
+					mont_mul_u(result, &v[i * 8], &inv[i * 8], ctx);
+					mont_from_u(result, result, ctx);
+					for (int j = 0; j < 8; j++)
+					{
+						Assert::AreEqual(one[j], result[j], _MSGW(L"Batch inverse #" << i << " at word #" << j << " failed"));
+					};
+				};
+			};
+
+			// 4. split and reconstruct: k of n shares recover the secret; cached coefficients recover a second secret
+			{
+				const u64 maxk = 8;
+				const u64 maxn = maxk + 2;
+				std::vector<u64> area((4 * maxn + maxk) * 8 + 8);
+				u64* coeffs = (u64*)((uintptr_t(area.data()) + 63) & ~uintptr_t(63));
+				u64* xs = coeffs + maxk * 8;
+				u64* shares = xs + maxn * 8;
+				u64* lambdas = shares + maxn * 8;
+				u64* scratch = lambdas + maxn * 8;
+				_UI512(secret) { 0 };
+
+				for (int i = 0; i < test_run_count / 10; i++)
+				{
+					u64 k = (RandomU64(&seed) % maxk) + 1;
+					u64 n = k + 2;
+					for (u64 c = 0; c < k; c++)
+					{
+						RandomBelow(num1);
+						mont_to_u(&coeffs[c * 8], num1, ctx);
+					};
+					for (u64 p = 0; p < n; p++)
+					{
+						set_uT64(num1, p + 1);
+						mont_to_u(&xs[p * 8], num1, ctx);
+					};
+					reg_verify((u64*)&r_before);
+					s16 ret = shamir_split_u(shares, coeffs, k, xs, n, ctx);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s16(0), ret, L"Return code failed share split test.");
+
+					// use the last k shares
+					u64* kxs = &xs[(n - k) * 8];
+					u64* kshares = &shares[(n - k) * 8];
+					reg_verify((u64*)&r_before);
+					ret = shamir_lagrange_u(lambdas, kxs, k, ctx, scratch);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s16(0), ret, L"Return code failed Lagrange coefficient test.");
+					reg_verify((u64*)&r_before);
+					ret = shamir_combine_u(secret, lambdas, kshares, k, ctx);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s16(0), ret, L"Return code failed reconstruct test.");
+					for (int j = 0; j < 8; j++)
+					{
+						Assert::AreEqual(coeffs[j], secret[j], _MSGW(L"Secret at word #" << j << " failed on run #" << i << " k = " << k));
+					};
+
+					// second secret, same share points: reuse lambdas
+					RandomBelow(num1);
+					mont_to_u(coeffs, num1, ctx);
+					shamir_split_u(shares, coeffs, k, xs, n, ctx);
+					shamir_combine_u(secret, lambdas, kshares, k, ctx);
+					for (int j = 0; j < 8; j++)
+					{
+						Assert::AreEqual(coeffs[j], secret[j], _MSGW(L"Second secret at word #" << j << " failed on run #" << i << " k = " << k));
+					};
+				};
+
+				// repeated share point
+				copy_u(&xs[8], &xs[0]);
+				Assert::AreEqual(s16(-1), shamir_lagrange_u(lambdas, xs, 2, ctx, scratch), L"Return code failed repeated share point test.");
+			};
+
+			string test_message = _MSGA("Modular arithmetic and Shamir secret sharing testing, prime 2^255 - 19.\n\tadd and subtract,"
+				"\n\tinverse, and inverse of zero,\n\tbatch inverse,\n\tsplit, Lagrange coefficients, reconstruct, with reuse of coefficients.\n"
+				<< test_run_count << " times for add and subtract, " << test_run_count / 10 << " times for the others, with pseudo random values.\n");
+			Logger::WriteMessage(test_message.c_str());
+			Logger::WriteMessage(L"Passed. Tested expected values, return value, and volatile register integrity: each via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_08_saturating)
+		{
+			// Saturating add, subtract, multiply, and their batch forms
+			// Expected values come from add_u / sub_u / mult_u and their carry, borrow or overflow
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(num1) { 0 };
+			_UI512(num2) { 0 };
+			_UI512(result) { 0 };
+			_UI512(expected) { 0 };
+			_UI512(overflow) { 0 };
+			_UI512(ones) { 0 };
+
+			for (int j = 0; j < 8; j++)
+			{
+				ones[j] = u64_Max;
+			};
+
+			// 1. random operands: about half of the adds and subtracts saturate; most full width multiplies do
+			//	  every fourth run uses a small multiplier so the non-saturating multiply path is exercised too
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomFill(num1, &seed);
+				RandomFill(num2, &seed);
+
+				s16 carry = add_u(expected, num1, num2);
+				if (carry != 0)
+				{
+					copy_u(expected, ones);
+				};
+				reg_verify((u64*)&r_before);
+				s16 ret = adds_u(result, num1, num2);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(carry, ret, _MSGW(L"Return code failed saturating add on run #" << i));
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Saturating sum at word #" << j << " failed on run #" << i));
+				};
+
+				s16 borrow = sub_u(expected, num1, num2);
+				if (borrow != 0)
+				{
+					zero_u(expected);
+				};
+				reg_verify((u64*)&r_before);
+				ret = subs_u(result, num1, num2);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(borrow, ret, _MSGW(L"Return code failed saturating subtract on run #" << i));
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Saturating difference at word #" << j << " failed on run #" << i));
+				};
+
+				if (i % 4 == 0)
+				{
+					zero_u(num2);
+					set_uT64(num2, RandomU64(&seed) >> 48);
+					for (int j = 0; j < 2; j++)
+					{
+						num1[j] = 0;
+					};
+				};
+				mult_u(expected, overflow, num1, num2);
+				s16 over = s16(compare_uT64(overflow, 0ull) == 0 ? 0 : 1);
+				if (over != 0)
+				{
+					copy_u(expected, ones);
+				};
+				reg_verify((u64*)&r_before);
+				ret = muls_u(result, num1, num2);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(over, ret, _MSGW(L"Return code failed saturating multiply on run #" << i));
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Saturating product at word #" << j << " failed on run #" << i));
+				};
+			};
+
+			// 2. edges: ones + 1 saturates, ones + 0 does not; 0 - 1 saturates, x - x does not
+			zero_u(num2);
+			Assert::AreEqual(s16(0), adds_u(result, ones, num2), L"Return code failed ones + 0.");
+			set_uT64(num2, 1ull);
+			Assert::AreEqual(s16(1), adds_u(result, ones, num2), L"Return code failed ones + 1.");
+			zero_u(overflow);
+			Assert::AreEqual(s16(1), subs_u(result, overflow, num2), L"Return code failed 0 - 1.");
+			Assert::AreEqual(s16(0), compare_uT64(result, 0ull), L"Saturated difference is not zero.");
+			Assert::AreEqual(s16(0), subs_u(result, num2, num2), L"Return code failed x - x.");
+
+			// 3. batch forms, compared element by element to the single forms
+			{
+				const u64 count = 37;
+				std::vector<u64> buffers(4 * count * 8 + 8);
+				u64* base = (u64*)((uintptr_t(buffers.data()) + 63) & ~uintptr_t(63));
+				u64* lhs = base;
+				u64* rhs = base + count * 8;
+				u64* outs = base + 2 * count * 8;
+				u64* singles = base + 3 * count * 8;
+				for (u64 e = 0; e < count; e++)
+				{
+					RandomFill(lhs + e * 8, &seed);
+					RandomFill(rhs + e * 8, &seed);
+					if (e % 3 == 0)
+					{
+						for (int j = 0; j < 5; j++)
+						{
+							rhs[e * 8 + j] = 0;
+							lhs[e * 8 + j] = 0;
+						};
+					};
+				};
+
+				using single_fn = s16(*)(const u64*, const u64*, const u64*);
+				using batch_fn = u64(*)(const u64*, const u64*, const u64*, const u64);
+				const single_fn singlefns[3] = { adds_u, subs_u, muls_u };
+				const batch_fn batchfns[3] = { adds_u_n, subs_u_n, muls_u_n };
+				const wchar_t* names[3] = { L"adds_u_n", L"subs_u_n", L"muls_u_n" };
+				for (int f = 0; f < 3; f++)
+				{
+					u64 expected_count = 0;
+					for (u64 e = 0; e < count; e++)
+					{
+						expected_count += u64(singlefns[f](singles + e * 8, lhs + e * 8, rhs + e * 8));
+					};
+					reg_verify((u64*)&r_before);
+					u64 saturated = batchfns[f](outs, lhs, rhs, count);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(expected_count, saturated, _MSGW(names[f] << L" saturated count failed"));
+					for (u64 w = 0; w < count * 8; w++)
+					{
+						Assert::AreEqual(singles[w], outs[w], _MSGW(names[f] << L" at word #" << w << " failed"));
+					};
+					Assert::AreEqual(0ull, batchfns[f](outs, lhs, rhs, 0), _MSGW(names[f] << L" empty batch failed"));
+				};
+			};
+
+			string runmsg = "Saturating add, subtract, multiply, single and batch forms: " + to_string(test_run_count) + " random runs plus edge cases.\n";
+			Logger::WriteMessage(runmsg.c_str());
+			Logger::WriteMessage(L"Passed. Tested expected values, return value, and volatile register integrity: each via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_09_reductions)
+		{
+			// Array reductions: sum with deferred carries, min / max, argmin / argmax
+			// Expected values come from a running add_u (counting carries) and a compare_u scan
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(result) { 0 };
+			_UI512(expected) { 0 };
+
+			const u64 max_count = 67;
+			std::vector<u64> buffer(max_count * 8 + 8);
+			u64* values = (u64*)((uintptr_t(buffer.data()) + 63) & ~uintptr_t(63));
+
+			for (int i = 0; i < test_run_count / 10; i++)
+			{
+				const u64 count = 1 + RandomU64(&seed) % max_count;
+				for (u64 e = 0; e < count; e++)
+				{
+					RandomFill(values + e * 8, &seed);
+					if (i % 2 == 0)
+					{
+						// every other run: share the top qwords so compares must look further down
+						for (int j = 0; j < 6; j++)
+						{
+							values[e * 8 + j] = (j == 5) ? values[e * 8 + j] % 3 : u64_Max;
+						};
+					};
+				};
+				if (count > 4)
+				{
+					copy_u(values + 3 * 8, values + 1 * 8);		// at least one exact duplicate
+				};
+
+				// 1. sum
+				zero_u(expected);
+				u64 expected_overflow = 0;
+				for (u64 e = 0; e < count; e++)
+				{
+					expected_overflow += u64(add_u(expected, expected, values + e * 8));
+				};
+				reg_verify((u64*)&r_before);
+				u64 overflow = sum_u_n(result, values, count);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(expected_overflow, overflow, _MSGW(L"Sum overflow failed on run #" << i));
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Sum at word #" << j << " failed on run #" << i));
+				};
+
+				// 2. argmax / argmin: first of equals
+				s64 expected_max = 0;
+				s64 expected_min = 0;
+				for (u64 e = 1; e < count; e++)
+				{
+					if (compare_u(values + e * 8, values + expected_max * 8) > 0)
+					{
+						expected_max = s64(e);
+					};
+					if (compare_u(values + e * 8, values + expected_min * 8) < 0)
+					{
+						expected_min = s64(e);
+					};
+				};
+				reg_verify((u64*)&r_before);
+				s64 argmax = argmax_u_n(values, count);
+				s64 argmin = argmin_u_n(values, count);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(expected_max, argmax, _MSGW(L"Argmax failed on run #" << i));
+				Assert::AreEqual(expected_min, argmin, _MSGW(L"Argmin failed on run #" << i));
+
+				// 3. max / min copy the element
+				reg_verify((u64*)&r_before);
+				s16 ret = max_u_n(result, values, count);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Return code failed max test.");
+				Assert::AreEqual(s16(0), compare_u(result, values + expected_max * 8), _MSGW(L"Max failed on run #" << i));
+				ret = min_u_n(result, values, count);
+				Assert::AreEqual(s16(0), ret, L"Return code failed min test.");
+				Assert::AreEqual(s16(0), compare_u(result, values + expected_min * 8), _MSGW(L"Min failed on run #" << i));
+			};
+
+			// 4. all ones: every lane carries on every add after the first
+			for (u64 e = 0; e < max_count; e++)
+			{
+				for (int j = 0; j < 8; j++)
+				{
+					values[e * 8 + j] = u64_Max;
+				};
+			};
+			zero_u(expected);
+			u64 expected_overflow = 0;
+			for (u64 e = 0; e < max_count; e++)
+			{
+				expected_overflow += u64(add_u(expected, expected, values + e * 8));
+			};
+			u64 overflow = sum_u_n(result, values, max_count);
+			Assert::AreEqual(expected_overflow, overflow, L"Sum overflow failed for all ones.");
+			for (int j = 0; j < 8; j++)
+			{
+				Assert::AreEqual(expected[j], result[j], _MSGW(L"Sum of all ones at word #" << j << " failed"));
+			};
+
+			// 5. empty arrays
+			Assert::AreEqual(0ull, sum_u_n(result, values, 0), L"Sum of empty array failed.");
+			Assert::AreEqual(0ull, result[0] | result[7], L"Sum of empty array is not zero.");
+			Assert::AreEqual(s64(-1), argmax_u_n(values, 0), L"Argmax of empty array failed.");
+			Assert::AreEqual(s64(-1), argmin_u_n(values, 0), L"Argmin of empty array failed.");
+			Assert::AreEqual(s16(-1), max_u_n(result, values, 0), L"Max of empty array failed.");
+			Assert::AreEqual(s16(-1), min_u_n(result, values, 0), L"Min of empty array failed.");
+
+			string runmsg = "Array reductions: sum, argmax, argmin, max, min: " + to_string(test_run_count / 10) + " random arrays plus edge cases.\n";
+			Logger::WriteMessage(runmsg.c_str());
+			Logger::WriteMessage(L"Passed. Tested expected values, return value, and volatile register integrity: each via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_10_cmp_n)
+		{
+			// Batch compare to a threshold, and to per element bounds, producing packed bitmasks
+			// Expected bits come from compare_u, per element
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(threshold) { 0 };
+
+			const u64 max_count = 200;
+			std::vector<u64> buffer(2 * max_count * 8 + 8);
+			u64* values = (u64*)((uintptr_t(buffer.data()) + 63) & ~uintptr_t(63));
+			u64* bounds = values + max_count * 8;
+			u64 masks[(max_count + 63) / 64 + 1] = { 0 };
+
+			const u64 predicates[6] = { cmp_eq, cmp_lt, cmp_le, cmp_ne, cmp_ge, cmp_gt };
+			auto Holds = [](u64 predicate, s16 cmp) -> bool
+				{
+					switch (predicate & 7)
+					{
+					case cmp_eq: return cmp == 0;
+					case cmp_lt: return cmp < 0;
+					case cmp_le: return cmp <= 0;
+					case cmp_ne: return cmp != 0;
+					case cmp_ge: return cmp >= 0;
+					case cmp_gt: return cmp > 0;
+					};
+					return false;
+				};
+
+			for (int i = 0; i < test_run_count / 10; i++)
+			{
+				const u64 count = 1 + RandomU64(&seed) % max_count;
+				RandomFill(threshold, &seed);
+				for (u64 e = 0; e < count; e++)
+				{
+					RandomFill(values + e * 8, &seed);
+					RandomFill(bounds + e * 8, &seed);
+					// mix in values equal to, or differing only low down from, the bound so every lane decides some compares
+					const u64 shape = RandomU64(&seed) % 4;
+					const u64* bound = (i % 2 == 0) ? threshold : bounds + e * 8;
+					for (int j = 0; j < 8 && shape != 0; j++)
+					{
+						if (shape == 1 || j < int(RandomU64(&seed) % 8))
+						{
+							values[e * 8 + j] = bound[j];
+						};
+					};
+				};
+				const u64 each = (i % 2 == 0) ? 0 : cmp_each;
+				const u64* bound_arg = (each != 0) ? bounds : threshold;
+
+				for (u64 predicate : predicates)
+				{
+					u64 expected_count = 0;
+					for (u64 w = 0; w <= (count + 63) / 64; w++)
+					{
+						masks[w] = 0xA5A5A5A5A5A5A5A5ull;
+					};
+					reg_verify((u64*)&r_before);
+					u64 matched = cmp_u_n(masks, values, bound_arg, count, predicate | each);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					for (u64 e = 0; e < count; e++)
+					{
+						const u64* bound = (each != 0) ? bounds + e * 8 : threshold;
+						const bool expected = Holds(predicate, compare_u(values + e * 8, bound));
+						expected_count += expected ? 1 : 0;
+						const bool bit = ((masks[e / 64] >> (e % 64)) & 1) != 0;
+						Assert::AreEqual(expected, bit, _MSGW(L"Predicate " << predicate << L" element #" << e << " failed on run #" << i));
+					};
+					if (count % 64 != 0)
+					{
+						Assert::AreEqual(0ull, masks[count / 64] >> (count % 64), _MSGW(L"Bits past count set on run #" << i));
+					};
+					Assert::AreEqual(0xA5A5A5A5A5A5A5A5ull, masks[(count + 63) / 64], _MSGW(L"Wrote past the masks on run #" << i));
+					Assert::AreEqual(expected_count, matched, _MSGW(L"Predicate " << predicate << L" count failed on run #" << i));
+				};
+			};
+
+			// empty array: nothing written, nothing counted
+			masks[0] = 0xA5A5A5A5A5A5A5A5ull;
+			Assert::AreEqual(0ull, cmp_u_n(masks, values, threshold, 0, cmp_eq), L"Empty array count failed.");
+			Assert::AreEqual(0xA5A5A5A5A5A5A5A5ull, masks[0], L"Empty array wrote a mask.");
+
+			string runmsg = "Batch compare to bitmask, six predicates, threshold and per element bounds: " + to_string(test_run_count / 10) + " random arrays.\n";
+			Logger::WriteMessage(runmsg.c_str());
+			Logger::WriteMessage(L"Passed. Tested expected values, return value, and volatile register integrity: each via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_11_bitlength)
+		{
+			// Branch free msb / lsb, and batch msb / lsb / significant qword counts
+			// Expected values come from msb_u and lsb_u
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(num1) { 0 };
+
+			const u64 max_count = 97;
+			std::vector<u64> buffer(max_count * 8 + 8);
+			u64* values = (u64*)((uintptr_t(buffer.data()) + 63) & ~uintptr_t(63));
+			std::vector<s16> results(max_count + 1);
+
+			// Random value with a random number of zero qwords at each end, and random zero bits within the end qwords
+			auto RandomShaped = [&](u64* var)
+				{
+					RandomFill(var, &seed);
+					const u64 lead = RandomU64(&seed) % 9;
+					const u64 trail = RandomU64(&seed) % 9;
+					for (u64 j = 0; j < 8; j++)
+					{
+						if (j < lead || 7 - j < trail)
+						{
+							var[j] = 0;
+						};
+					};
+					var[0] >>= RandomU64(&seed) % 64;
+					var[7] <<= RandomU64(&seed) % 64;
+				};
+
+			// 1. single value forms, including zero, one, and the top bit
+			for (int i = 0; i < test_run_count + 3; i++)
+			{
+				if (i < test_run_count)
+				{
+					RandomShaped(num1);
+				}
+				else
+				{
+					zero_u(num1);
+					if (i == test_run_count + 1) num1[7] = 1;
+					if (i == test_run_count + 2) num1[0] = 0x8000000000000000ull;
+				};
+				s16 expected_msb = msb_u(num1);
+				s16 expected_lsb = lsb_u(num1);
+				reg_verify((u64*)&r_before);
+				s16 msb = msb_uZ(num1);
+				s16 lsb = lsb_uZ(num1);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(expected_msb, msb, _MSGW(L"msb_uZ failed on run #" << i));
+				Assert::AreEqual(expected_lsb, lsb, _MSGW(L"lsb_uZ failed on run #" << i));
+			};
+
+			// 2. batch forms
+			for (int i = 0; i < test_run_count / 10; i++)
+			{
+				const u64 count = 1 + RandomU64(&seed) % max_count;
+				for (u64 e = 0; e < count; e++)
+				{
+					RandomShaped(values + e * 8);
+				};
+				results[count] = 0x5A5A;
+
+				reg_verify((u64*)&r_before);
+				s16 ret = msb_u_n(results.data(), values, count);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Return code failed msb_u_n.");
+				for (u64 e = 0; e < count; e++)
+				{
+					Assert::AreEqual(msb_u(values + e * 8), results[e], _MSGW(L"msb_u_n element #" << e << " failed on run #" << i));
+				};
+
+				ret = lsb_u_n(results.data(), values, count);
+				Assert::AreEqual(s16(0), ret, L"Return code failed lsb_u_n.");
+				for (u64 e = 0; e < count; e++)
+				{
+					Assert::AreEqual(lsb_u(values + e * 8), results[e], _MSGW(L"lsb_u_n element #" << e << " failed on run #" << i));
+				};
+
+				ret = limbs_u_n(results.data(), values, count);
+				Assert::AreEqual(s16(0), ret, L"Return code failed limbs_u_n.");
+				for (u64 e = 0; e < count; e++)
+				{
+					s16 msb = msb_u(values + e * 8);
+					s16 expected = (msb < 0) ? s16(0) : s16(msb / 64 + 1);
+					Assert::AreEqual(expected, results[e], _MSGW(L"limbs_u_n element #" << e << " failed on run #" << i));
+				};
+				Assert::AreEqual(s16(0x5A5A), results[count], _MSGW(L"Wrote past the results on run #" << i));
+			};
+
+			string runmsg = "Branch free msb / lsb: " + to_string(test_run_count + 3) + " values; batch msb, lsb, limbs: " + to_string(test_run_count / 10) + " random arrays.\n";
+			Logger::WriteMessage(runmsg.c_str());
+			Logger::WriteMessage(L"Passed. Tested expected values, return value, and volatile register integrity: each via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_12_pack)
+		{
+			// Compact codec: pack, unpack, and random access through the index
+			// Values are mostly small, as in use, with some zero and some full width
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(num1) { 0 };
+
+			const u64 max_count = 300;
+			std::vector<u64> buffer(2 * max_count * 8 + 8);
+			u64* values = (u64*)((uintptr_t(buffer.data()) + 63) & ~uintptr_t(63));
+			u64* unpacked = values + max_count * 8;
+			std::vector<u8> packed(max_count * 65 + 64);
+			std::vector<u64> index(max_count + 1);
+
+			for (int i = 0; i < test_run_count / 20; i++)
+			{
+				const u64 count = 1 + RandomU64(&seed) % max_count;
+				const u64 k = 1 + RandomU64(&seed) % 16;
+				u64 expected_bytes = 0;
+				for (u64 e = 0; e < count; e++)
+				{
+					u64* v = values + e * 8;
+					RandomFill(v, &seed);
+					const u64 shape = RandomU64(&seed) % 8;
+					const u64 keep = (shape == 0) ? 0 : (shape == 1) ? 8 : 1 + shape % 2;	// zero, full width, or one or two qwords
+					for (u64 j = 0; j < 8 - keep; j++)
+					{
+						v[j] = 0;
+					};
+					if (keep != 0)
+					{
+						v[8 - keep] >>= RandomU64(&seed) % 64;
+					};
+					expected_bytes += 1 + (msb_u(v) + 8) / 8;
+				};
+				const u64 index_count = (count + k - 1) / k;
+				index[index_count] = 0x5A5A5A5A5A5A5A5Aull;
+				packed[expected_bytes] = u8(0x5A);
+
+				reg_verify((u64*)&r_before);
+				u64 bytes = pack_u_n(packed.data(), values, count, index.data(), k);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(expected_bytes, bytes, _MSGW(L"Packed size failed on run #" << i));
+				Assert::AreEqual(u8(0x5A), packed[expected_bytes], _MSGW(L"Wrote past the packed bytes on run #" << i));
+				Assert::AreEqual(0x5A5A5A5A5A5A5A5Aull, index[index_count], _MSGW(L"Wrote past the index on run #" << i));
+
+				reg_verify((u64*)&r_before);
+				s64 consumed = unpack_u_n(unpacked, packed.data(), count);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s64(expected_bytes), consumed, _MSGW(L"Unpacked size failed on run #" << i));
+				for (u64 w = 0; w < count * 8; w++)
+				{
+					Assert::AreEqual(values[w], unpacked[w], _MSGW(L"Unpack at word #" << w << " failed on run #" << i));
+				};
+
+				// Random access: offsets agree with a walk of the length bytes
+				for (int r = 0; r < 10; r++)
+				{
+					const u64 entry = RandomU64(&seed) % count;
+					u64 offset = 0;
+					for (u64 e = 0; e < entry; e++)
+					{
+						offset += 1 + u64((unsigned char)packed[offset]);
+					};
+					s64 at = unpack_at_u(num1, packed.data(), index.data(), k, entry);
+					Assert::AreEqual(s64(offset), at, _MSGW(L"Entry #" << entry << " offset failed on run #" << i));
+					Assert::AreEqual(s16(0), compare_u(num1, values + entry * 8), _MSGW(L"Entry #" << entry << " value failed on run #" << i));
+				};
+
+				// No index
+				Assert::AreEqual(expected_bytes, pack_u_n(packed.data(), values, count, nullptr, 0), L"Packed size without index failed.");
+			};
+
+			// Edge cases: bad length byte, k of zero
+			packed[0] = u8(65);
+			Assert::AreEqual(s64(-1), unpack_u_n(unpacked, packed.data(), 1), L"Bad length byte not detected.");
+			Assert::AreEqual(s64(-1), unpack_at_u(num1, packed.data(), index.data(), 0, 0), L"Index spacing of zero not rejected.");
+
+			string runmsg = "Compact codec pack / unpack / random access: " + to_string(test_run_count / 20) + " random arrays.\n";
+			Logger::WriteMessage(runmsg.c_str());
+			Logger::WriteMessage(L"Passed. Tested expected values, return value, and volatile register integrity: each via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_13_delta)
+		{
+			// Delta codec for sorted arrays: pack, decode by block, lower bound search
+			// Expected values come from the original array, and a linear compare_u search
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_DELTATAB(tab);
+			_UI512(key) { 0 };
+			_UI512(result) { 0 };
+			_UI512(step) { 0 };
+
+			const u64 max_count = 250;
+			const u64 max_block = 32;
+			std::vector<u64> buffer((2 * max_count + max_block) * 8 + 8);
+			u64* values = (u64*)((uintptr_t(buffer.data()) + 63) & ~uintptr_t(63));
+			u64* bounds = values + max_count * 8;
+			u64* scratch = bounds + max_count * 8;
+			std::vector<u8> packed(max_count * 65);
+			std::vector<u64> offsets(max_count);
+
+			for (int i = 0; i < test_run_count / 20; i++)
+			{
+				const u64 count = 1 + RandomU64(&seed) % max_count;
+				const u64 block = 1 + RandomU64(&seed) % max_block;
+				const u64 blocks = (count + block - 1) / block;
+
+				// Sorted values: a large random start, then small steps (some zero, for duplicates)
+				RandomFill(values, &seed);
+				values[0] = 0;
+				for (u64 e = 1; e < count; e++)
+				{
+					zero_u(step);
+					step[7] = RandomU64(&seed) % 4 == 0 ? 0 : RandomU64(&seed) >> (RandomU64(&seed) % 64);
+					add_u(values + e * 8, values + (e - 1) * 8, step);
+				};
+
+				tab[0] = u64(packed.data());
+				tab[1] = u64(offsets.data());
+				tab[2] = u64(bounds);
+				tab[4] = block;
+				reg_verify((u64*)&r_before);
+				s64 bytes = delta_pack_u(tab, values, count);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::IsTrue(bytes > 0 && u64(bytes) == tab[5], _MSGW(L"Packed size failed on run #" << i));
+				Assert::AreEqual(count, tab[3], _MSGW(L"Table count failed on run #" << i));
+
+				// Every block decodes to the original; bounds are its first and last value
+				for (u64 b = 0; b < blocks; b++)
+				{
+					const u64 first = b * block;
+					const u64 n = (count - first < block) ? count - first : block;
+					reg_verify((u64*)&r_before);
+					s64 decoded = delta_unpack_block_u(scratch, tab, b);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s64(n), decoded, _MSGW(L"Block #" << b << " size failed on run #" << i));
+					for (u64 w = 0; w < n * 8; w++)
+					{
+						Assert::AreEqual(values[first * 8 + w], scratch[w], _MSGW(L"Block #" << b << " word #" << w << " failed on run #" << i));
+					};
+					Assert::AreEqual(s16(0), compare_u(bounds + b * 16, values + first * 8), _MSGW(L"Block #" << b << " min failed on run #" << i));
+					Assert::AreEqual(s16(0), compare_u(bounds + b * 16 + 8, values + (first + n - 1) * 8), _MSGW(L"Block #" << b << " max failed on run #" << i));
+				};
+				Assert::AreEqual(s64(-1), delta_unpack_block_u(scratch, tab, blocks), L"Block out of range not rejected.");
+
+				// Lower bound: keys equal to values, between values, and past the end
+				for (int r = 0; r < 20; r++)
+				{
+					const u64 pick = RandomU64(&seed) % count;
+					copy_u(key, values + pick * 8);
+					if (r % 3 == 1)
+					{
+						add_uT64(key, key, 1);
+					}
+					else if (r % 3 == 2 && r > 15)
+					{
+						copy_u(key, values + (count - 1) * 8);
+						add_uT64(key, key, 1);
+					};
+					u64 expected = 0;
+					while (expected < count && compare_u(values + expected * 8, key) < 0)
+					{
+						expected++;
+					};
+					reg_verify((u64*)&r_before);
+					s64 found = delta_lower_bound_u(result, tab, key, scratch);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s64(expected), found, _MSGW(L"Lower bound index failed on run #" << i << " search #" << r));
+					if (expected < count)
+					{
+						Assert::AreEqual(s16(0), compare_u(result, values + expected * 8), _MSGW(L"Lower bound value failed on run #" << i));
+					};
+				};
+			};
+
+			// Out of order values, and a block size of zero, are rejected
+			set_uT64(values, 5);
+			set_uT64(values + 8, 4);
+			tab[4] = 4;
+			Assert::AreEqual(s64(-1), delta_pack_u(tab, values, 2), L"Out of order values not rejected.");
+			tab[4] = 0;
+			Assert::AreEqual(s64(-1), delta_pack_u(tab, values, 2), L"Block size of zero not rejected.");
+
+			string runmsg = "Delta codec pack / block decode / lower bound: " + to_string(test_run_count / 20) + " random sorted arrays.\n";
+			Logger::WriteMessage(runmsg.c_str());
+			Logger::WriteMessage(L"Passed. Tested expected values, return value, and volatile register integrity: each via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_14_trace_replay)
+		{
+			// Operand trace capture and replay (see ui512trace.h)
+			// Captures a production shaped workload (short values, a few repeated divisors, many multiplies by one) through the
+			// ui512trace wrappers with sampling, checks the trace decodes to the sampled operands, then replays it for per-routine timing.
+			// Set UI512_TRACE_FILE to also replay a trace captured elsewhere; set UI512_TRACE_SAVE to keep this one.
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			_UI512(num1) { 0 };
+			_UI512(num2) { 0 };
+			_UI512(out1) { 0 };
+			_UI512(out2) { 0 };
+
+			const u64 sample_every = 3;
+			ui512trace::TraceWriter writer(sample_every);
+			std::vector<u64> expected[ui512trace::op_count];
+
+			_UI512(divisors[4]) { 0 };
+			for (int d = 0; d < 4; d++)
+			{
+				divisors[d][6] = RandomU64(&seed) >> 40;
+				divisors[d][7] = RandomU64(&seed) | 1;
+			};
+
+			auto Short = [&](u64* var)
+				{
+					zero_u(var);
+					var[7] = RandomU64(&seed);
+					if (RandomU64(&seed) % 4 == 0)
+					{
+						var[6] = RandomU64(&seed) >> 32;
+					};
+				};
+			auto Expect = [&](int op, const u64* lh, const u64* rh)
+				{
+					if ((writer.calls - 1) % sample_every == 0)
+					{
+						expected[op].insert(expected[op].end(), lh, lh + 8);
+						expected[op].insert(expected[op].end(), rh, rh + 8);
+					};
+				};
+
+			ui512trace::active = &writer;
+			for (int i = 0; i < test_run_count * 3; i++)
+			{
+				Short(num1);
+				Short(num2);
+				switch (RandomU64(&seed) % 6)
+				{
+				case 0:
+					set_uT64(num2, 1);
+					ui512trace::mult_u(out1, out2, num1, num2);
+					Expect(ui512trace::op_mult_u, num1, num2);
+					break;
+				case 1:
+					ui512trace::mult_u(out1, out2, num1, num2);
+					Expect(ui512trace::op_mult_u, num1, num2);
+					break;
+				case 2:
+					ui512trace::mult_uT64(out1, out2, num1, num2[7]);
+					set_uT64(out1, num2[7]);
+					Expect(ui512trace::op_mult_uT64, num1, out1);
+					break;
+				case 3:
+				{
+					const u64* divisor = divisors[RandomU64(&seed) % 4];
+					ui512trace::div_u(out1, out2, num1, divisor);
+					Expect(ui512trace::op_div_u, num1, divisor);
+					break;
+				}
+				case 4:
+					ui512trace::add_u(out1, num1, num2);
+					Expect(ui512trace::op_add_u, num1, num2);
+					break;
+				case 5:
+					ui512trace::sub_u(out1, num1, num2);
+					Expect(ui512trace::op_sub_u, num1, num2);
+					break;
+				};
+			};
+			ui512trace::active = nullptr;
+			ui512trace::mult_u(out1, out2, num1, num2);		// not active: not recorded
+
+			Assert::AreEqual(u64(test_run_count * 3), writer.calls, L"Trace call count failed.");
+			Assert::AreEqual((writer.calls + sample_every - 1) / sample_every, writer.records, L"Trace sample count failed.");
+
+			ui512trace::TraceReplay replay;
+			Assert::IsTrue(replay.Decode(writer.bytes), L"Trace decode failed.");
+			for (int op = 1; op < ui512trace::op_count; op++)
+			{
+				Assert::AreEqual(u64(expected[op].size() / 16), replay.count[op], _MSGW(L"Trace pool size failed for routine #" << op));
+				const u64* pool = replay.Pool(op);
+				for (size_t w = 0; w < expected[op].size(); w++)
+				{
+					Assert::AreEqual(expected[op][w], pool[w], _MSGW(L"Trace operand word #" << w << " failed for routine #" << op));
+				};
+			};
+
+			// a record cut short, or a routine code with nothing after it, is rejected
+			{
+				ui512trace::TraceReplay cut;
+				std::vector<u8> shortened(writer.bytes.begin(), writer.bytes.end() - 1);
+				Assert::IsFalse(cut.Decode(shortened), L"Trace decode of a cut record not rejected.");
+				shortened.assign(1, u8(ui512trace::op_add_u));
+				Assert::IsFalse(cut.Decode(shortened), L"Trace decode of a bare routine code not rejected.");
+			};
+
+			auto Report = [&](ui512trace::TraceReplay& r, const string& title)
+				{
+					r.Run(ui512trace::TraceTargets{}, 20);
+					string msg = title + "\n";
+					for (int op = 1; op < ui512trace::op_count; op++)
+					{
+						msg += std::format("\t{:<12}{:>10} calls{:>12.2f} ns per call\n", ui512trace::trace_op_names[op], r.count[op], r.nanoseconds[op]);
+					};
+					Logger::WriteMessage(msg.c_str());
+				};
+
+			string runmsg = "Trace of " + to_string(writer.calls) + " calls, " + to_string(writer.records) + " sampled, " + to_string(writer.bytes.size()) + " bytes.";
+			Report(replay, runmsg);
+
+			char* path = nullptr;
+			size_t len = 0;
+			if (_dupenv_s(&path, &len, "UI512_TRACE_SAVE") == 0 && path != nullptr)
+			{
+				Assert::IsTrue(writer.Save(path), L"Trace save failed.");
+				free(path);
+			};
+			if (_dupenv_s(&path, &len, "UI512_TRACE_FILE") == 0 && path != nullptr)
+			{
+				std::vector<u8> trace;
+				ui512trace::TraceReplay external;
+				if (ui512trace::TraceWriter::Load(path, trace) && external.Decode(trace))
+				{
+					Report(external, string("Replay of ") + path + ":");
+				}
+				else
+				{
+					Logger::WriteMessage((string("Could not load or decode trace ") + path + "\n").c_str());
+				};
+				free(path);
+			};
+
+			Logger::WriteMessage(L"Passed. Tested trace capture, sampling and decode via assert; replay timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_15_comparative)
+		{
+			// Comparative benchmark: the same operand pools through mult_u / div_u / add_u, a plain C++ reference,
+			// Boost.Multiprecision (uint512_t, uint1024_t for the full product) and GMP (mpn_mul_n, mpn_tdiv_qr, mpn_add_n).
+			// Comparators whose headers are not found (or GMP, unless UI512_USE_GMP is defined) are reported as skipped (see ui512compare.h).
+			// Results are cross checked against the ui512 routines before timing.
+			// Note: the cycle counts are informational only
+
+			using namespace ui512compare;
+			u64 seed = 0;
+			const int pool_size = 1024;
+			const int repeat = 50;
+
+			std::vector<u64> pools(pool_size * 24 + 8);
+			u64* lhs = (u64*)((uintptr_t(pools.data()) + 63) & ~uintptr_t(63));
+			u64* rhs = lhs + pool_size * 8;
+			u64* divisors = rhs + pool_size * 8;
+			for (int i = 0; i < pool_size; i++)
+			{
+				RandomFill(lhs + i * 8, &seed);
+				RandomFill(rhs + i * 8, &seed);
+				u64* d = divisors + i * 8;
+				RandomFill(d, &seed);
+				shr_u(d, d, u16(RandomU64(&seed) % 448));		// divisors from 64 to 512 bits
+				d[7] |= 1;
+			};
+
+			_UI512(out1) { 0 };
+			_UI512(out2) { 0 };
+			_UI512(chk1) { 0 };
+			_UI512(chk2) { 0 };
+
+			enum { row_mul, row_div, row_add, rows };
+			enum { col_ui512, col_ref, col_boost, col_gmp, cols };
+			const char* row_names[rows] = { "mult_u", "div_u", "add_u" };
+			const char* col_names[cols] = { "ui512", "reference", "boost", "gmp" };
+			double cycles[rows][cols] = { { 0.0 } };
+			bool have[rows][cols] = { { false } };
+
+			auto Time = [&](int row, int col, auto&& body)
+				{
+					const u64 start = Cycles();
+					for (int r = 0; r < repeat; r++)
+					{
+						for (int i = 0; i < pool_size; i++)
+						{
+							body(i);
+						};
+					};
+					cycles[row][col] = double(Cycles() - start) / (double(pool_size) * double(repeat));
+					have[row][col] = true;
+				};
+			auto Check = [&](const u64* expected, const u64* got, const char* what, int i)
+				{
+					for (int j = 0; j < 8; j++)
+					{
+						Assert::AreEqual(expected[j], got[j], _MSGW(what << " mismatch at pool entry #" << i << " word #" << j));
+					};
+				};
+
+			// ui512 kernels
+			Time(row_mul, col_ui512, [&](int i) { mult_u(out1, out2, lhs + i * 8, rhs + i * 8); });
+			Time(row_div, col_ui512, [&](int i) { div_u(out1, out2, lhs + i * 8, divisors + i * 8); });
+			Time(row_add, col_ui512, [&](int i) { add_u(out1, lhs + i * 8, rhs + i * 8); });
+
+			// Plain C++ reference
+			for (int i = 0; i < pool_size; i++)
+			{
+				mult_u(chk1, chk2, lhs + i * 8, rhs + i * 8);
+				ref_mul(out1, out2, lhs + i * 8, rhs + i * 8);
+				Check(chk1, out1, "reference product", i);
+				Check(chk2, out2, "reference overflow", i);
+				div_u(chk1, chk2, lhs + i * 8, divisors + i * 8);
+				ref_div(out1, out2, lhs + i * 8, divisors + i * 8);
+				Check(chk1, out1, "reference quotient", i);
+				Check(chk2, out2, "reference remainder", i);
+				add_u(chk1, lhs + i * 8, rhs + i * 8);
+				ref_add(out1, lhs + i * 8, rhs + i * 8);
+				Check(chk1, out1, "reference sum", i);
+			};
+			Time(row_mul, col_ref, [&](int i) { ref_mul(out1, out2, lhs + i * 8, rhs + i * 8); });
+			Time(row_div, col_ref, [&](int i) { ref_div(out1, out2, lhs + i * 8, divisors + i * 8); });
+			Time(row_add, col_ref, [&](int i) { ref_add(out1, lhs + i * 8, rhs + i * 8); });
+
+#if UI512_HAVE_BOOST
+			{
+				std::vector<uint512_t> bl(pool_size), br(pool_size), bd(pool_size);
+				uint1024_t bp = 0;
+				uint512_t bq = 0, brem = 0;
+				for (int i = 0; i < pool_size; i++)
+				{
+					bl[i] = ToBoost<uint512_t>(lhs + i * 8);
+					br[i] = ToBoost<uint512_t>(rhs + i * 8);
+					bd[i] = ToBoost<uint512_t>(divisors + i * 8);
+
+					mult_u(chk1, chk2, lhs + i * 8, rhs + i * 8);
+					bp = uint1024_t(bl[i]) * br[i];
+					FromBoost(out1, uint512_t(bp & ((uint1024_t(1) << 512) - 1)));
+					FromBoost(out2, uint512_t(bp >> 512));
+					Check(chk1, out1, "boost product", i);
+					Check(chk2, out2, "boost overflow", i);
+
+					div_u(chk1, chk2, lhs + i * 8, divisors + i * 8);
+					boost::multiprecision::divide_qr(bl[i], bd[i], bq, brem);
+					FromBoost(out1, bq);
+					FromBoost(out2, brem);
+					Check(chk1, out1, "boost quotient", i);
+					Check(chk2, out2, "boost remainder", i);
+				};
+				Time(row_mul, col_boost, [&](int i) { bp = uint1024_t(bl[i]) * br[i]; });
+				Time(row_div, col_boost, [&](int i) { boost::multiprecision::divide_qr(bl[i], bd[i], bq, brem); });
+				Time(row_add, col_boost, [&](int i) { bq = bl[i] + br[i]; });
+			};
+#endif
+
+#if UI512_HAVE_GMP
+			{
+				std::vector<mp_limb_t> gl(pool_size * 8), gr(pool_size * 8), gd(pool_size * 8);
+				std::vector<mp_size_t> gdn(pool_size);
+				mp_limb_t gp[16] = { 0 }, gq[8] = { 0 }, grem[8] = { 0 };
+				for (int i = 0; i < pool_size; i++)
+				{
+					ToLimbs(&gl[i * 8], lhs + i * 8);
+					ToLimbs(&gr[i * 8], rhs + i * 8);
+					ToLimbs(&gd[i * 8], divisors + i * 8);
+					gdn[i] = Limbs(&gd[i * 8]);
+
+					mult_u(chk1, chk2, lhs + i * 8, rhs + i * 8);
+					mpn_mul_n(gp, &gl[i * 8], &gr[i * 8], 8);
+					FromLimbs(out1, gp);
+					FromLimbs(out2, gp + 8);
+					Check(chk1, out1, "gmp product", i);
+					Check(chk2, out2, "gmp overflow", i);
+
+					div_u(chk1, chk2, lhs + i * 8, divisors + i * 8);
+					gmp_div(out1, out2, lhs + i * 8, divisors + i * 8);
+					Check(chk1, out1, "gmp quotient", i);
+					Check(chk2, out2, "gmp remainder", i);
+				};
+				Time(row_mul, col_gmp, [&](int i) { mpn_mul_n(gp, &gl[i * 8], &gr[i * 8], 8); });
+				Time(row_div, col_gmp, [&](int i) { mpn_tdiv_qr(gq, grem, 0, &gl[i * 8], 8, &gd[i * 8], gdn[i]); });
+				Time(row_add, col_gmp, [&](int i) { mpn_add_n(gp, &gl[i * 8], &gr[i * 8], 8); });
+			};
+#endif
+
+			string msg = std::format("Cycles per op, {} operand pairs x {} passes:\n\t{:<10}", pool_size, repeat, "");
+			for (int c = 0; c < cols; c++)
+			{
+				msg += std::format("{:>12}", col_names[c]);
+			};
+			msg += "\n";
+			for (int r = 0; r < rows; r++)
+			{
+				msg += std::format("\t{:<10}", row_names[r]);
+				for (int c = 0; c < cols; c++)
+				{
+					msg += have[r][c] ? std::format("{:>12.1f}", cycles[r][c]) : std::format("{:>12}", "-");
+				};
+				msg += "\n";
+			};
+			msg += std::format("\tboost: {}, gmp: {}\n", UI512_HAVE_BOOST ? "found" : "skipped (not installed)", UI512_HAVE_GMP ? "found" : "skipped (not installed, or UI512_USE_GMP not defined)");
+			Logger::WriteMessage(msg.c_str());
+
+			Logger::WriteMessage(L"Passed. Cross checked available comparators against the ui512 routines via assert; cycle counts are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_16_variants)
+		{
+			// Processor option variants side by side (see ui512variants.h, ui512mdVariants.inc)
+			// Every variant runs the same operand pools; results are checked against the default build, then each routine
+			// is timed on each variant and the fastest is reported.
+			// Note: the timings are informational only
+
+			using namespace ui512variants;
+			u64 seed = 0;
+			const int pool_size = 256;
+			const int repeat = 20;
+			_UI512(num1) { 0 };
+			_UI512(num2) { 0 };
+			_UI512(out1) { 0 };
+			_UI512(out2) { 0 };
+			_UI512(chk1) { 0 };
+			_UI512(chk2) { 0 };
+
+			// Core pools by trace: full and short operands for multiply and divide
+			ui512trace::TraceWriter writer;
+			ui512trace::active = &writer;
+			for (int i = 0; i < pool_size; i++)
+			{
+				RandomFill(num1, &seed);
+				RandomFill(num2, &seed);
+				shr_u(num2, num2, u16(RandomU64(&seed) % 448));
+				num2[7] |= 1;
+				ui512trace::mult_u(out1, out2, num1, num2);
+				ui512trace::mult_uT64(out1, out2, num1, num2[7]);
+				ui512trace::div_u(out1, out2, num1, num2);
+				ui512trace::div_uT64(out1, out2, num1, num2[7]);
+			};
+			ui512trace::active = nullptr;
+			ui512trace::TraceReplay replay;
+			Assert::IsTrue(replay.Decode(writer.bytes), L"Trace decode failed.");
+
+			// Batch pools
+			std::vector<u64> storage(pool_size * 8 + 8);
+			u64* values = (u64*)((uintptr_t(storage.data()) + 63) & ~uintptr_t(63));
+			for (int i = 0; i < pool_size; i++)
+			{
+				RandomFill(values + i * 8, &seed);
+				shr_u(values + i * 8, values + i * 8, u16(RandomU64(&seed) % 512));
+			};
+			_MONTCTX(ctx);
+			_UI512(modulus) { 0 };
+			for (int j = 4; j < 8; j++)
+			{
+				modulus[j] = RandomU64(&seed);
+			};
+			modulus[4] |= 0x8000000000000000ull;
+			modulus[7] |= 1ull;
+			Assert::AreEqual(s16(0), mont_setup_u(ctx, modulus), L"Montgomery setup failed.");
+			copy_u(num1, values);
+			RandomFill(num2, &seed);
+			std::vector<u64> masks(pool_size / 64 + 1);
+			std::vector<s16> bits(pool_size);
+			std::vector<u8> packed(pool_size * 65);
+
+			// Correctness: each variant against the default build
+			for (int v = 0; v < variant_count; v++)
+			{
+				const Variant& var = variants[v];
+				for (int op = ui512trace::op_mult_u; op <= ui512trace::op_div_uT64; op++)
+				{
+					const u64* pool = replay.Pool(op);
+					for (u64 i = 0; i < replay.count[op]; i++)
+					{
+						const u64* lh = pool + i * 16;
+						const u64* rh = lh + 8;
+						switch (op)
+						{
+						case ui512trace::op_mult_u: mult_u(chk1, chk2, lh, rh); var.core.mult_u(out1, out2, lh, rh); break;
+						case ui512trace::op_mult_uT64: mult_uT64(chk1, chk2, lh, rh[7]); var.core.mult_uT64(out1, out2, lh, rh[7]); break;
+						case ui512trace::op_div_u: div_u(chk1, chk2, lh, rh); var.core.div_u(out1, out2, lh, rh); break;
+						case ui512trace::op_div_uT64: div_uT64(chk1, chk2, lh, rh[7]); var.core.div_uT64(out1, out2, lh, rh[7]); break;
+						};
+						const int words = (op == ui512trace::op_mult_uT64 || op == ui512trace::op_div_uT64) ? 1 : 8;
+						for (int j = 0; j < 8; j++)
+						{
+							Assert::AreEqual(chk1[j], out1[j], _MSGW(L"Variant " << var.name << " " << ui512trace::trace_op_names[op] << " entry #" << i << " word #" << j));
+						};
+						for (int j = 8 - words; j < 8; j++)
+						{
+							Assert::AreEqual(chk2[j], out2[j], _MSGW(L"Variant " << var.name << " " << ui512trace::trace_op_names[op] << " second result, entry #" << i << " word #" << j));
+						};
+					};
+				};
+				mont_mul_u(chk1, num1, num2, ctx);
+				var.mont_mul_u(out1, num1, num2, ctx);
+				Assert::AreEqual(s16(0), compare_u(chk1, out1), _MSGW(L"Variant " << var.name << " mont_mul_u failed."));
+				muls_u(chk1, num1, num2);
+				var.muls_u(out1, num1, num2);
+				Assert::AreEqual(s16(0), compare_u(chk1, out1), _MSGW(L"Variant " << var.name << " muls_u failed."));
+				Assert::AreEqual(sum_u_n(chk1, values, pool_size), var.sum_u_n(out1, values, pool_size), _MSGW(L"Variant " << var.name << " sum_u_n overflow failed."));
+				Assert::AreEqual(s16(0), compare_u(chk1, out1), _MSGW(L"Variant " << var.name << " sum_u_n failed."));
+				Assert::AreEqual(argmax_u_n(values, pool_size), var.argmax_u_n(values, pool_size), _MSGW(L"Variant " << var.name << " argmax_u_n failed."));
+				Assert::AreEqual(cmp_u_n(masks.data(), values, num2, pool_size, cmp_lt), var.cmp_u_n(masks.data(), values, num2, pool_size, cmp_lt),
+					_MSGW(L"Variant " << var.name << " cmp_u_n failed."));
+				msb_u_n(bits.data(), values, pool_size);
+				std::vector<s16> expected_bits = bits;
+				var.msb_u_n(bits.data(), values, pool_size);
+				Assert::IsTrue(expected_bits == bits, _MSGW(L"Variant " << var.name << " msb_u_n failed."));
+				Assert::AreEqual(pack_u_n(packed.data(), values, pool_size, nullptr, 0), var.pack_u_n(packed.data(), values, pool_size, nullptr, 0),
+					_MSGW(L"Variant " << var.name << " pack_u_n failed."));
+			};
+
+			// Timing
+			const char* routine_names[] = { "mult_u", "mult_uT64", "div_u", "div_uT64", "mont_mul_u", "muls_u", "sum_u_n", "argmax_u_n", "cmp_u_n", "msb_u_n", "pack_u_n" };
+			const int routines = int(sizeof(routine_names) / sizeof(routine_names[0]));
+			std::vector<double> ns(routines * variant_count, 0.0);
+
+			auto Time = [&](auto&& body, int calls)
+				{
+					auto start = std::chrono::steady_clock::now();
+					for (int r = 0; r < repeat; r++)
+					{
+						body();
+					};
+					std::chrono::duration<double, std::nano> dur = std::chrono::steady_clock::now() - start;
+					return dur.count() / (double(calls) * double(repeat));
+				};
+
+			for (int v = 0; v < variant_count; v++)
+			{
+				const Variant& var = variants[v];
+				double* row = ns.data() + v;
+				replay.Run(var.core, repeat);
+				for (int op = ui512trace::op_mult_u; op <= ui512trace::op_div_uT64; op++)
+				{
+					row[(op - ui512trace::op_mult_u) * variant_count] = replay.nanoseconds[op];
+				};
+				row[4 * variant_count] = Time([&]() { for (int i = 0; i < pool_size; i++) var.mont_mul_u(out1, num1, values + i * 8, ctx); }, pool_size);
+				row[5 * variant_count] = Time([&]() { for (int i = 0; i < pool_size; i++) var.muls_u(out1, num1, values + i * 8); }, pool_size);
+				row[6 * variant_count] = Time([&]() { var.sum_u_n(out1, values, pool_size); }, pool_size);
+				row[7 * variant_count] = Time([&]() { var.argmax_u_n(values, pool_size); }, pool_size);
+				row[8 * variant_count] = Time([&]() { var.cmp_u_n(masks.data(), values, num2, pool_size, cmp_lt); }, pool_size);
+				row[9 * variant_count] = Time([&]() { var.msb_u_n(bits.data(), values, pool_size); }, pool_size);
+				row[10 * variant_count] = Time([&]() { var.pack_u_n(packed.data(), values, pool_size, nullptr, 0); }, pool_size);
+			};
+
+			string msg = std::format("Variants, ns per value, {} values x {} passes:\n\t{:<12}", pool_size, repeat, "");
+			for (int v = 0; v < variant_count; v++)
+			{
+				msg += std::format("{:>10}", variants[v].name);
+			};
+			msg += std::format("{:>10}\n", "winner");
+			for (int r = 0; r < routines; r++)
+			{
+				const double* row = ns.data() + r * variant_count;
+				int best = 0;
+				msg += std::format("\t{:<12}", routine_names[r]);
+				for (int v = 0; v < variant_count; v++)
+				{
+					msg += std::format("{:>10.2f}", row[v]);
+					best = (row[v] < row[best]) ? v : best;
+				};
+				msg += std::format("{:>10}\n", variants[best].name);
+			};
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested each variant against the default build via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_17_unwind)
+		{
+			// Unwind metadata (see CreateFrame in ui512mdMacros.inc)
+			// For each routine with a frame: the function table must have an entry for it, and a virtual unwind from the first
+			// instruction after the prologue, over a fake stack laid out as CreateFrame leaves it, must recover the caller's
+			// return address, stack pointer and RBP, and the non-volatile registers from their slots (.SAVEREG).
+			// This is the step a sampling profiler or debugger takes to walk through it.
+			// msb_u_n, lsb_u_n, add_u_n, sub_u_n and compare_u_n are leaves under __UseZ (the default build), with no frame, so are not listed.
+			// div_u, div_round_u, bsgs_log_u and bsgs_range_u are leaf entries that jump to a private framed core; the cores are reached
+			// by stepping over the stub's one instruction (MOV [RSP+20h], rnd_floor in div_u; XOR R10, R10 in bsgs_log_u) and following its JMP.
+
+			struct Framed
+			{
+				const char* name;
+				const void* entry;
+				u64 frame;												// CreateFrame argsize + 64, or the fixed allocation
+				bool pushes_rbp;
+				const char* saved;										// CreateFrame regs, in slot order
+				u64 stub = 0;											// bytes of a leaf entry before its JMP to a private core, or 0
+			};
+			const Framed routines[] = {
+				{ "mult_u", (const void*)mult_u, 0x220 + 64, true, "R12" },
+				{ "mult_uT64", (const void*)mult_uT64, 8 * 8, false, "" },
+				{ "mont_setup_u", (const void*)mont_setup_u, 0x200 + 64, true, "" },
+				{ "mont_mul_u", (const void*)mont_mul_u, 0x200 + 64, true, "RBX R12 R13 R14" },
+				{ "mont_pow_uT64", (const void*)mont_pow_uT64, 0x200 + 64, true, "R12 R13" },
+				{ "mont_pow_u", (const void*)mont_pow_u, 0x240 + 64, true, "R12" },
+				{ "mont_inv_u", (const void*)mont_inv_u, 0x180 + 64, true, "" },
+				{ "mont_batchinv_u", (const void*)mont_batchinv_u, 0x200 + 64, true, "RBX R12 R13" },
+				{ "shamir_split_u", (const void*)shamir_split_u, 0x200 + 64, true, "RBX R12 R13 R14 R15" },
+				{ "shamir_lagrange_u", (const void*)shamir_lagrange_u, 0x200 + 64, true, "RBX R12 R13 R14" },
+				{ "shamir_combine_u", (const void*)shamir_combine_u, 0x200 + 64, true, "R12 R13" },
+				{ "muls_u", (const void*)muls_u, 0x140 + 64, true, "" },
+				{ "muls_u_n", (const void*)muls_u_n, 0x100 + 64, true, "R12 R13 R14 R15 RBX" },
+				{ "sum_u_n", (const void*)sum_u_n, 0x180 + 64, true, "" },
+				{ "max_u_n", (const void*)max_u_n, 0x100 + 64, true, "" },
+				{ "min_u_n", (const void*)min_u_n, 0x100 + 64, true, "" },
+				{ "cmp_u_n", (const void*)cmp_u_n, 0x100 + 64, true, "RBX RSI RDI R12 R13 R14" },
+				{ "pack_u_n", (const void*)pack_u_n, 0x180 + 64, true, "RBX RSI RDI R12 R13 R14 R15" },
+				{ "unpack_u_n", (const void*)unpack_u_n, 0x140 + 64, true, "RSI RDI R15" },
+				{ "unpack_at_u", (const void*)unpack_at_u, 0x100 + 64, true, "R12" },
+				{ "delta_pack_u", (const void*)delta_pack_u, 0x180 + 64, true, "RBX RSI RDI R12 R13 R14 R15" },
+				{ "delta_unpack_block_u", (const void*)delta_unpack_block_u, 0x100 + 64, true, "RBX R12 R13" },
+				{ "delta_lower_bound_u", (const void*)delta_lower_bound_u, 0x140 + 64, true, "RBX RSI RDI R12 R13 R14 R15" },
+				{ "add_u_idx", (const void*)add_u_idx, 0x140 + 64, true, "RBX RSI RDI R12 R13 R14 R15" },
+				{ "mult_u_idx", (const void*)mult_u_idx, 0x140 + 64, true, "RBX RSI RDI R12 R13 R14 R15" },
+				{ "cmp_u_idx", (const void*)cmp_u_idx, 0x140 + 64, true, "RBX RSI RDI R12 R13 R14 R15" },
+				{ "exp_plan_u", (const void*)exp_plan_u, 0x140 + 64, true, "RBX RSI RDI R12 R13 R14 R15" },
+				{ "exp_exec_u", (const void*)exp_exec_u, 0xA00 + 64, true, "RBX R12 R13 R14 R15" },
+				{ "mult_lo_u", (const void*)mult_lo_u, 0x100 + 64, true, "RBX R12" },
+				{ "pow_u", (const void*)pow_u, 0x200 + 64, true, "R12 R13" },
+				{ "ilog_setup_u", (const void*)ilog_setup_u, 0x100 + 64, true, "RBX R12 R13 R14 R15" },
+				{ "ilog_u", (const void*)ilog_u, 0x100 + 64, true, "" },
+				{ "ilog_u_n", (const void*)ilog_u_n, 0x100 + 64, true, "RBX R12 R13 R14 R15" },
+				{ "mult_uT128", (const void*)mult_uT128, 0x180 + 64, true, "RBX RSI RDI R12 R13 R14 R15" },
+				{ "mult_uT256", (const void*)mult_uT256, 0x180 + 64, true, "RBX RSI RDI R12 R13 R14 R15" },
+				{ "div_core_u", (const void*)div_u, 0x360 + 64, true, "R12", 9 },
+				{ "bsgs_core_u", (const void*)bsgs_log_u, 0x300 + 64, true, "RBX RSI RDI R12 R13 R14 R15", 3 },
+			};
+
+			const u64 caller_rip = 0x00007FF612345678ull;
+			const u64 caller_rbp = 0x00000012ABCDEF00ull;
+			const u64 caller_nv = 0x00000034C0FFEE00ull;					// + slot number, for each saved register
+			auto Nonvolatile = [](CONTEXT& c, const string& reg) -> DWORD64*
+				{
+					return (reg == "RBX") ? &c.Rbx : (reg == "RSI") ? &c.Rsi : (reg == "RDI") ? &c.Rdi : (reg == "R12") ? &c.R12
+						: (reg == "R13") ? &c.R13 : (reg == "R14") ? &c.R14 : (reg == "R15") ? &c.R15 : nullptr;
+				};
+			auto Jump = [](const u8* code) -> const u8*
+				{
+					return (code[0] == u8(0xE9)) ? code + 5 + *(const s32*)(code + 1) : (code[0] == u8(0xEB)) ? code + 2 + (signed char)code[1] : code;
+				};
+			std::vector<u64> stack(1024, 0);
+			for (const Framed& r : routines)
+			{
+				// incremental linking may route the address through a jump thunk
+				const u8* code = Jump((const u8*)r.entry);
+				if (r.stub != 0)
+				{
+					Assert::IsTrue(Jump(code + r.stub) != code + r.stub, _MSGW(L"No jump to " << r.name << " in its entry stub"));
+					code = Jump(code + r.stub);
+				};
+				DWORD64 image = 0;
+				PRUNTIME_FUNCTION fn = RtlLookupFunctionEntry(DWORD64(code), &image, nullptr);
+				Assert::IsNotNull(fn, _MSGW(L"No function table entry for " << r.name));
+				const u8* info = (const u8*)(image + fn->UnwindData);
+				const u64 prolog = u64(u8(info[1]));
+
+				// fake stack, as the routine's body sees it: LOCALs, register slots (rounded to 16 bytes), RBP, return address
+				std::vector<string> saved;
+				std::istringstream names(r.saved);
+				for (string reg; names >> reg;)
+				{
+					saved.push_back(reg);
+				};
+				std::fill(stack.begin(), stack.end(), 0);
+				const u64 base = (uintptr_t(stack.data()) + 63) & ~uintptr_t(63);
+				const u64 alloc = r.frame + ((saved.size() * 8 + 15) & ~u64(15));
+				const u64 entry_rsp = base + alloc + (r.pushes_rbp ? 8 : 0);
+				*(u64*)entry_rsp = caller_rip;
+				if (r.pushes_rbp)
+				{
+					*(u64*)(entry_rsp - 8) = caller_rbp;
+				};
+				for (size_t k = 0; k < saved.size(); k++)
+				{
+					*(u64*)(base + r.frame + k * 8) = caller_nv + k;
+				};
+				CONTEXT ctx{};
+				ctx.Rip = DWORD64(code) + prolog;
+				ctx.Rsp = base;
+				ctx.Rbp = base & ~u64(63);									// realigned, not a frame register
+				PVOID handler_data = nullptr;
+				DWORD64 establisher = 0;
+				RtlVirtualUnwind(UNW_FLAG_NHANDLER, image, ctx.Rip, fn, &ctx, &handler_data, &establisher, nullptr);
+
+				Assert::AreEqual(caller_rip, u64(ctx.Rip), _MSGW(L"Unwound return address failed for " << r.name));
+				Assert::AreEqual(entry_rsp + 8, u64(ctx.Rsp), _MSGW(L"Unwound stack pointer failed for " << r.name));
+				if (r.pushes_rbp)
+				{
+					Assert::AreEqual(caller_rbp, u64(ctx.Rbp), _MSGW(L"Unwound RBP failed for " << r.name));
+				};
+				for (size_t k = 0; k < saved.size(); k++)
+				{
+					const DWORD64* reg = Nonvolatile(ctx, saved[k]);
+					Assert::IsNotNull(reg, _MSGW(L"Unknown saved register for " << r.name));
+					Assert::AreEqual(caller_nv + k, u64(*reg), _MSGW(L"Unwound " << saved[k].c_str() << " failed for " << r.name));
+				};
+			};
+
+			string runmsg = "Virtual unwind through " + to_string(sizeof(routines) / sizeof(routines[0])) + " routines with frames.\n";
+			Logger::WriteMessage(runmsg.c_str());
+			Logger::WriteMessage(L"Passed. Tested function table entries and unwound return address, stack pointer, RBP, and saved registers via assert.\n\n");
+		};
+
+		TEST_METHOD(ui512md_18_service)
+		{
+			// Shared memory modmul / modexp service (see ui512service.h), with a local load generator
+			// Client threads call through the named ring, as separate processes would; every result is checked against
+			// the routines called directly. Runs once per knob setting and reports throughput, latency, and batching.
+			// Note: a modulus of 256 bits keeps products within 512 bits, so mult_u and div_u can build "expected"
+			// Note: the timings are informational only
+
+			const int clients = 4;
+			const int calls = 500;
+			const int moduli = 3;
+			const char* name = "Local\\ui512md_service_test";
+
+			struct Knob
+			{
+				u64 max_batch;
+				u64 max_wait_us;
+			};
+			const Knob knobs[] = { { 1, 0 }, { 16, 10 }, { 64, 50 } };
+
+			ALIGN64 u64 mods[moduli][8] = { { 0 } };
+			u64 seed = 0;
+			for (int m = 0; m < moduli; m++)
+			{
+				for (int j = 4; j < 8; j++)
+				{
+					mods[m][j] = RandomU64(&seed);
+				};
+				mods[m][4] |= 0x8000000000000000ull;
+				mods[m][7] |= 1ull;
+			};
+
+			string msg = std::format("Service: {} clients x {} calls, {} moduli\n", clients, calls, moduli);
+			for (const Knob& knob : knobs)
+			{
+				ui512service::Service service;
+				service.max_batch = knob.max_batch;
+				service.max_wait_us = knob.max_wait_us;
+				Assert::IsTrue(service.Create(name, 64), L"Service ring creation failed.");
+				std::thread server([&]() { service.Run(); });
+
+				std::vector<double> latency(clients * calls, 0.0);
+				std::atomic<int> failures = 0;
+				auto start = std::chrono::steady_clock::now();
+				std::vector<std::thread> threads;
+				for (int c = 0; c < clients; c++)
+				{
+					threads.emplace_back([&, c]()
+						{
+							ui512service::Client client;
+							if (!client.Open(name))
+							{
+								failures++;
+								return;
+							};
+							u64 cseed = u64(c) * 7919 + 1;
+							_MONTCTX(ctx);
+							_UI512(a) { 0 };
+							_UI512(b) { 0 };
+							_UI512(result) { 0 };
+							_UI512(expected) { 0 };
+							_UI512(product) { 0 };
+							_UI512(overflow) { 0 };
+							_UI512(quotient) { 0 };
+							_UI512(work) { 0 };
+							for (int i = 0; i < calls; i++)
+							{
+								const u64* modulus = mods[RandomU64(&cseed) % moduli];
+								const bool modexp = (RandomU64(&cseed) % 4) == 0;
+								zero_u(a);
+								zero_u(b);
+								for (int j = 5; j < 8; j++)
+								{
+									a[j] = RandomU64(&cseed);
+									b[j] = RandomU64(&cseed);
+								};
+								auto t0 = std::chrono::steady_clock::now();
+								s32 status = client.Call(modexp ? ui512service::op_modexp : ui512service::op_modmul, modulus, a, b, result);
+								std::chrono::duration<double, std::micro> dur = std::chrono::steady_clock::now() - t0;
+								latency[c * calls + i] = dur.count();
+
+								if (modexp)
+								{
+									mont_setup_u(ctx, modulus);
+									mont_to_u(work, a, ctx);
+									mont_pow_u(product, work, b, ctx);
+									mont_from_u(expected, product, ctx);
+								}
+								else
+								{
+									mult_u(product, overflow, a, b);
+									div_u(quotient, expected, product, modulus);
+								};
+								if (status != 0 || compare_u(expected, result) != 0)
+								{
+									failures++;
+								};
+							};
+						});
+				};
+				for (std::thread& t : threads)
+				{
+					t.join();
+				};
+				std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+				service.Stop();
+				server.join();
+
+				Assert::AreEqual(0, failures.load(), _MSGW(L"Service results failed with max_batch " << knob.max_batch));
+				Assert::AreEqual(u64(clients * calls), service.requests, L"Service request count failed.");
+
+				std::sort(latency.begin(), latency.end());
+				msg += std::format("\tmax_batch {:>3}, max_wait {:>3} us: {:>10.0f} calls/s, latency median {:>8.2f} us, p99 {:>8.2f} us, {:>6.2f} per batch, {} context setups\n",
+					knob.max_batch, knob.max_wait_us, double(clients * calls) * 1.0e6 / elapsed.count(), latency[latency.size() / 2], latency[latency.size() * 99 / 100],
+					double(service.requests) / double(service.batches), service.contexts.misses.load());
+			};
+
+			// a bad modulus is returned as status -1
+			{
+				ui512service::Service service;
+				Assert::IsTrue(service.Create(name, 4), L"Service ring creation failed.");
+				std::thread server([&]() { service.Run(); });
+				ui512service::Client client;
+				Assert::IsTrue(client.Open(name), L"Service ring open failed.");
+				_UI512(even) { 0 };
+				_UI512(one) { 0 };
+				_UI512(result) { 0 };
+				_UI512(before) { 0 };
+				set_uT64(even, 10);
+				set_uT64(one, 1);
+				RandomFill(result, &seed);
+				copy_u(before, result);
+				Assert::AreEqual(s32(-1), client.Call(ui512service::op_modmul, even, one, one, result), L"Even modulus not rejected.");
+				Assert::AreEqual(s16(0), compare_u(before, result), L"Result changed on bad modulus.");
+				service.Stop();
+				server.join();
+			};
+
+			// a call waiting when the service stops, and a call after it, return status -2 rather than blocking
+			{
+				ui512service::Service service;
+				Assert::IsTrue(service.Create(name, 4), L"Service ring creation failed.");
+				ui512service::Client client;
+				Assert::IsTrue(client.Open(name), L"Service ring open failed.");
+				_UI512(modulus) { 0 };
+				_UI512(one) { 0 };
+				_UI512(result) { 0 };
+				_UI512(later) { 0 };
+				_UI512(before) { 0 };
+				set_uT64(modulus, 101);
+				set_uT64(one, 1);
+				RandomFill(result, &seed);
+				copy_u(later, result);
+				copy_u(before, result);
+				std::atomic<s32> waiting_status = 0;
+				std::thread waiter([&]() { waiting_status = client.Call(ui512service::op_modmul, modulus, one, one, result); });
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				service.Stop();
+				service.Run();										// no batch in hand: completes the waiting slot, if still there, and returns
+				waiter.join();
+				Assert::AreEqual(s32(ui512service::status_shutdown), waiting_status.load(), L"Waiting call not released on stop.");
+				Assert::AreEqual(s16(0), compare_u(before, result), L"Result changed on waiting call released by stop.");
+				Assert::AreEqual(s32(ui512service::status_shutdown), client.Call(ui512service::op_modmul, modulus, one, one, later), L"Call after stop not refused.");
+				Assert::AreEqual(s16(0), compare_u(before, later), L"Result changed on call after stop.");
+			};
+
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested service results against direct calls, bad modulus status, and shutdown status, via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_19_ctxcache)
+		{
+			// Montgomery context cache keyed by modulus (see ui512ctxcache.h)
+			// Checks cached contexts against mont_setup_u, hit / miss / eviction counting, concurrent readers,
+			// the cached modmul / modexp fast paths, bad modulus, and warm start through a file.
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			const int distinct = 600;
+			const int capacity = 256;
+			std::vector<u64> storage(distinct * 8 + 8);
+			u64* moduli = (u64*)((uintptr_t(storage.data()) + 63) & ~uintptr_t(63));
+			for (int m = 0; m < distinct; m++)
+			{
+				u64* mod = moduli + m * 8;
+				for (int j = 4; j < 8; j++)
+				{
+					mod[j] = RandomU64(&seed);
+				};
+				mod[4] |= 0x8000000000000000ull;
+				mod[7] |= 1ull;
+			};
+			_MONTCTX(ctx);
+			_MONTCTX(expected);
+
+			// 1. every lookup matches mont_setup_u; a hot set of 64 moduli stays cached while the rest stream through
+			ui512ctxcache::ContextCache cache(capacity);
+			u64 lookups = 0;
+			for (int i = 0; i < test_run_count; i++)
+			{
+				const int m = (RandomU64(&seed) % 4 != 0) ? int(RandomU64(&seed) % 64) : int(RandomU64(&seed) % distinct);
+				const u64* mod = moduli + m * 8;
+				Assert::AreEqual(s16(0), cache.Get(ctx, mod), _MSGW(L"Cache lookup failed on run #" << i));
+				mont_setup_u(expected, mod);
+				for (int j = 0; j < 32; j++)
+				{
+					Assert::AreEqual(expected[j], ctx[j], _MSGW(L"Cached context word #" << j << " failed on run #" << i));
+				};
+				lookups++;
+			};
+			Assert::AreEqual(lookups, cache.hits.load() + cache.misses.load(), L"Hit and miss counts failed.");
+			Assert::IsTrue(cache.evictions.load() > 0, L"No evictions with more moduli than capacity.");
+			Assert::IsTrue(cache.HitRate() > 0.4, L"Hot set was not kept.");
+
+			// 2. bad modulus is returned, not cached
+			_UI512(even) { 0 };
+			set_uT64(even, 10);
+			const u64 misses = cache.misses.load();
+			Assert::AreEqual(s16(-1), cache.Get(ctx, even), L"Even modulus not rejected.");
+			Assert::AreEqual(s16(-1), cache.Get(ctx, even), L"Even modulus not rejected twice.");
+			Assert::AreEqual(misses + 2, cache.misses.load(), L"Bad modulus was cached.");
+
+			// 3. cached fast paths
+			_UI512(a) { 0 };
+			_UI512(b) { 0 };
+			_UI512(result) { 0 };
+			_UI512(product) { 0 };
+			_UI512(overflow) { 0 };
+			_UI512(quotient) { 0 };
+			_UI512(remainder) { 0 };
+			_UI512(work) { 0 };
+			for (int i = 0; i < test_run_count / 10; i++)
+			{
+				const u64* mod = moduli + (RandomU64(&seed) % 64) * 8;
+				zero_u(a);
+				zero_u(b);
+				for (int j = 5; j < 8; j++)
+				{
+					a[j] = RandomU64(&seed);
+					b[j] = RandomU64(&seed);
+				};
+				Assert::AreEqual(s16(0), cache.ModMul(result, a, b, mod), L"Cached modmul failed.");
+				mult_u(product, overflow, a, b);
+				div_u(quotient, remainder, product, mod);
+				Assert::AreEqual(s16(0), compare_u(remainder, result), _MSGW(L"Cached modmul result failed on run #" << i));
+				Assert::AreEqual(s16(0), cache.ModExp(result, a, b, mod), L"Cached modexp failed.");
+				mont_setup_u(expected, mod);
+				mont_to_u(work, a, expected);
+				mont_pow_u(product, work, b, expected);
+				mont_from_u(remainder, product, expected);
+				Assert::AreEqual(s16(0), compare_u(remainder, result), _MSGW(L"Cached modexp result failed on run #" << i));
+			};
+
+			// 4. concurrent readers (and inserts) over a set that fits
+			ui512ctxcache::ContextCache shared(capacity);
+			std::atomic<int> failures = 0;
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; t++)
+			{
+				threads.emplace_back([&, t]()
+					{
+						u64 tseed = u64(t) + 11;
+						_MONTCTX(tctx);
+						_MONTCTX(texp);
+						for (int i = 0; i < 2000; i++)
+						{
+							const u64* mod = moduli + (RandomU64(&tseed) % 128) * 8;
+							if (shared.Get(tctx, mod) != 0)
+							{
+								failures++;
+								continue;
+							};
+							if (i % 16 == 0)
+							{
+								mont_setup_u(texp, mod);
+								failures += (memcmp(texp, tctx, sizeof(texp)) != 0) ? 1 : 0;
+							};
+						};
+					});
+			};
+			for (std::thread& th : threads)
+			{
+				th.join();
+			};
+			Assert::AreEqual(0, failures.load(), L"Concurrent lookups failed.");
+
+			// 5. warm start
+			const string path = (std::filesystem::temp_directory_path() / "ui512md_ctxcache.bin").string();
+			Assert::IsTrue(shared.Save(path.c_str()), L"Cache save failed.");
+			ui512ctxcache::ContextCache warm(capacity);
+			Assert::AreEqual(s64(128), warm.Load(path.c_str()), L"Cache load count failed.");
+			for (int m = 0; m < 128; m++)
+			{
+				Assert::AreEqual(s16(0), warm.Get(ctx, moduli + m * 8), L"Warm lookup failed.");
+			};
+			Assert::AreEqual(0ull, warm.misses.load(), L"Warm start missed.");
+			std::filesystem::remove(path);
+
+			// timing: cached lookup against mont_setup_u
+			auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < test_run_count; i++)
+			{
+				mont_setup_u(ctx, moduli + (i % 128) * 8);
+			};
+			std::chrono::duration<double, std::nano> setup_ns = std::chrono::steady_clock::now() - start;
+			start = std::chrono::steady_clock::now();
+			for (int i = 0; i < test_run_count; i++)
+			{
+				warm.Get(ctx, moduli + (i % 128) * 8);
+			};
+			std::chrono::duration<double, std::nano> cached_ns = std::chrono::steady_clock::now() - start;
+
+			string runmsg = std::format("Context cache: hit rate {:.3f}, {} evictions over {} lookups; mont_setup_u {:.1f} ns, cached {:.1f} ns per lookup.\n",
+				cache.HitRate(), cache.evictions.load(), lookups, setup_ns.count() / test_run_count, cached_ns.count() / test_run_count);
+			Logger::WriteMessage(runmsg.c_str());
+			Logger::WriteMessage(L"Passed. Tested cached contexts, counters, fast paths, concurrency and warm start via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_20_seqlock)
+		{
+			// Seqlock cell: store_u / load_u
+			// Single thread: values round trip, sequence advances by two per store, volatile registers kept.
+			// Concurrent: one writer stores values with all eight QWORDS equal and increasing; readers must never see a torn
+			// value (words differing) or a value older than one they have seen. Reports reader throughput against a mutex and copy_u.
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512CELL(cell) { 0 };
+			_UI512(value) { 0 };
+			_UI512(got) { 0 };
+
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomFill(value, &seed);
+				const u64 seq = cell[0];
+				reg_verify((u64*)&r_before);
+				s16 ret = store_u(cell, value);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"store_u return failed.");
+				Assert::AreEqual(seq + 2, cell[0], _MSGW(L"Sequence failed on run #" << i));
+				reg_verify((u64*)&r_before);
+				ret = load_u(got, cell);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"load_u return failed.");
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(value[j], got[j], _MSGW(L"Loaded word #" << j << " failed on run #" << i));
+					Assert::AreEqual(value[j], cell[8 + j], _MSGW(L"Stored word #" << j << " failed on run #" << i));
+				};
+			};
+
+			const u64 writes = 200000;
+			string msg = "Seqlock cell, one writer, " + to_string(writes) + " stores:\n";
+			for (int readers = 1; readers <= 4; readers *= 2)
+			{
+				zero_u(value);
+				store_u(cell, value);
+				std::atomic<bool> done = false;
+				std::atomic<int> torn = 0;
+				std::atomic<int> backwards = 0;
+				std::atomic<u64> loads = 0;
+				std::vector<std::thread> threads;
+				auto start = std::chrono::steady_clock::now();
+				for (int r = 0; r < readers; r++)
+				{
+					threads.emplace_back([&]()
+						{
+							_UI512(seen) { 0 };
+							u64 last = 0;
+							u64 n = 0;
+							while (!done.load(std::memory_order_relaxed))
+							{
+								load_u(seen, cell);
+								for (int j = 1; j < 8; j++)
+								{
+									torn += (seen[j] != seen[0]) ? 1 : 0;
+								};
+								backwards += (seen[0] < last) ? 1 : 0;
+								last = seen[0];
+								n++;
+							};
+							loads += n;
+						});
+				};
+				for (u64 w = 1; w <= writes; w++)
+				{
+					for (int j = 0; j < 8; j++)
+					{
+						value[j] = w;
+					};
+					store_u(cell, value);
+				};
+				done = true;
+				for (std::thread& t : threads)
+				{
+					t.join();
+				};
+				std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+				Assert::AreEqual(0, torn.load(), _MSGW(L"Torn value seen with " << readers << " readers"));
+				Assert::AreEqual(0, backwards.load(), _MSGW(L"Older value seen with " << readers << " readers"));
+				load_u(got, cell);
+				Assert::AreEqual(writes, got[7], L"Final value failed.");
+
+				// the same, through a mutex and copy_u
+				std::mutex lock;
+				_UI512(locked) { 0 };
+				std::atomic<u64> mloads = 0;
+				std::atomic<bool> mdone = false;
+				std::vector<std::thread> mthreads;
+				auto mstart = std::chrono::steady_clock::now();
+				for (int r = 0; r < readers; r++)
+				{
+					mthreads.emplace_back([&]()
+						{
+							_UI512(seen) { 0 };
+							u64 n = 0;
+							while (!mdone.load(std::memory_order_relaxed))
+							{
+								{
+									std::lock_guard<std::mutex> guard(lock);
+									copy_u(seen, locked);
+								};
+								n++;
+							};
+							mloads += n;
+						});
+				};
+				for (u64 w = 1; w <= writes; w++)
+				{
+					for (int j = 0; j < 8; j++)
+					{
+						value[j] = w;
+					};
+					std::lock_guard<std::mutex> guard(lock);
+					copy_u(locked, value);
+				};
+				mdone = true;
+				for (std::thread& t : mthreads)
+				{
+					t.join();
+				};
+				std::chrono::duration<double, std::micro> melapsed = std::chrono::steady_clock::now() - mstart;
+
+				msg += std::format("\t{} readers: seqlock {:>8.2f} M loads/s, {:>8.2f} M stores/s; mutex {:>8.2f} M loads/s, {:>8.2f} M stores/s\n", readers,
+					double(loads.load()) / elapsed.count(), double(writes) / elapsed.count(), double(mloads.load()) / melapsed.count(), double(writes) / melapsed.count());
+			};
+
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested round trip, sequence, volatile register integrity, and no torn or older reads via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_21_indexed)
+		{
+			// Indexed batches: add_u_idx, mult_u_idx, cmp_u_idx
+			// Random tables and index arrays (indexes repeat); results stored densely and scattered through a permutation,
+			// each checked against add_u, mult_u, compare_u on the same elements. Counts over lengths that end mid mask QWORD.
+			// Then times add_u_idx and mult_u_idx over a table larger than cache against a loop calling add_u / mult_u through the same indexes.
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			const u64 table_size = 64;
+			const u64 max_count = 200;
+			std::vector<u64> lh_store(table_size * 8 + 8, 0);
+			std::vector<u64> rh_store(table_size * 8 + 8, 0);
+			std::vector<u64> out_store(max_count * 8 + 8, 0);
+			std::vector<u64> ovf_store(max_count * 8 + 8, 0);
+			u64* lh_table = (u64*)((uintptr_t(lh_store.data()) + 63) & ~uintptr_t(63));
+			u64* rh_table = (u64*)((uintptr_t(rh_store.data()) + 63) & ~uintptr_t(63));
+			u64* out = (u64*)((uintptr_t(out_store.data()) + 63) & ~uintptr_t(63));
+			u64* ovf = (u64*)((uintptr_t(ovf_store.data()) + 63) & ~uintptr_t(63));
+			std::vector<u64> lh_idx(max_count);
+			std::vector<u64> rh_idx(max_count);
+			std::vector<u64> res_idx(max_count);
+			u64 masks[(max_count + 63) / 64] = { 0 };
+			_UI512(expected) { 0 };
+			_UI512(expected_ovf) { 0 };
+			const u64 predicates[6] = { cmp_eq, cmp_lt, cmp_le, cmp_ne, cmp_ge, cmp_gt };
+
+			for (int i = 0; i < test_run_count / 10; i++)
+			{
+				for (u64 t = 0; t < table_size; t++)
+				{
+					RandomFill(lh_table + t * 8, &seed);
+					RandomFill(rh_table + t * 8, &seed);
+				};
+				copy_u(rh_table, lh_table);										// some equal pairs for the compares
+				const u64 count = 1 + RandomU64(&seed) % max_count;
+				for (u64 k = 0; k < count; k++)
+				{
+					lh_idx[k] = RandomU64(&seed) % table_size;
+					rh_idx[k] = (k % 7 == 0) ? 0 : RandomU64(&seed) % table_size;
+					if (k % 7 == 0)
+					{
+						lh_idx[k] = 0;
+					};
+					res_idx[k] = k;
+				};
+				for (u64 k = count - 1; k > 0; k--)								// scatter through a permutation
+				{
+					std::swap(res_idx[k], res_idx[RandomU64(&seed) % (k + 1)]);
+				};
+
+				for (int scattered = 0; scattered < 2; scattered++)
+				{
+					const u64* place = scattered ? res_idx.data() : nullptr;
+					reg_verify((u64*)&r_before);
+					u64 carries = add_u_idx(out, place, lh_table, lh_idx.data(), rh_table, rh_idx.data(), count);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					u64 expected_carries = 0;
+					for (u64 k = 0; k < count; k++)
+					{
+						const u64 at = scattered ? res_idx[k] : k;
+						expected_carries += u64(add_u(expected, lh_table + lh_idx[k] * 8, rh_table + rh_idx[k] * 8));
+						for (int j = 0; j < 8; j++)
+						{
+							Assert::AreEqual(expected[j], out[at * 8 + j], _MSGW(L"add_u_idx element #" << k << " word #" << j << " failed on run #" << i));
+						};
+					};
+					Assert::AreEqual(expected_carries, carries, _MSGW(L"add_u_idx carries failed on run #" << i));
+
+					reg_verify((u64*)&r_before);
+					s16 ret = mult_u_idx(out, ovf, place, lh_table, lh_idx.data(), rh_table, rh_idx.data(), count);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s16(0), ret, L"mult_u_idx return failed.");
+					for (u64 k = 0; k < count; k++)
+					{
+						const u64 at = scattered ? res_idx[k] : k;
+						mult_u(expected, expected_ovf, lh_table + lh_idx[k] * 8, rh_table + rh_idx[k] * 8);
+						for (int j = 0; j < 8; j++)
+						{
+							Assert::AreEqual(expected[j], out[at * 8 + j], _MSGW(L"mult_u_idx product #" << k << " word #" << j << " failed on run #" << i));
+							Assert::AreEqual(expected_ovf[j], ovf[at * 8 + j], _MSGW(L"mult_u_idx overflow #" << k << " word #" << j << " failed on run #" << i));
+						};
+					};
+				};
+
+				for (u64 predicate : predicates)
+				{
+					for (u64& m : masks)
+					{
+						m = u64_Max;
+					};
+					reg_verify((u64*)&r_before);
+					const u64 matched = cmp_u_idx(masks, lh_table, lh_idx.data(), rh_table, rh_idx.data(), count, predicate);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					u64 expected_matched = 0;
+					for (u64 k = 0; k < count; k++)
+					{
+						const s16 c = compare_u(lh_table + lh_idx[k] * 8, rh_table + rh_idx[k] * 8);
+						bool truth = false;
+						switch (predicate)
+						{
+						case cmp_eq: truth = c == 0; break;
+						case cmp_lt: truth = c < 0; break;
+						case cmp_le: truth = c <= 0; break;
+						case cmp_ne: truth = c != 0; break;
+						case cmp_ge: truth = c >= 0; break;
+						case cmp_gt: truth = c > 0; break;
+						};
+						expected_matched += truth ? 1 : 0;
+						const bool bit = ((masks[k / 64] >> (k % 64)) & 1) != 0;
+						Assert::AreEqual(truth, bit, _MSGW(L"cmp_u_idx bit #" << k << " predicate " << predicate << " failed on run #" << i));
+					};
+					if (count % 64 != 0)
+					{
+						Assert::AreEqual(0ull, masks[count / 64] >> (count % 64), _MSGW(L"cmp_u_idx unused bits failed on run #" << i));
+					};
+					Assert::AreEqual(expected_matched, matched, _MSGW(L"cmp_u_idx count failed on run #" << i));
+				};
+			};
+			Assert::AreEqual(0ull, add_u_idx(out, nullptr, lh_table, lh_idx.data(), rh_table, rh_idx.data(), 0), L"Empty add_u_idx failed.");
+			Assert::AreEqual(0ull, cmp_u_idx(masks, lh_table, lh_idx.data(), rh_table, rh_idx.data(), 0, cmp_eq), L"Empty cmp_u_idx failed.");
+
+			// timing: 32 MiB tables, random indexes
+			const u64 big = u64(1) << 19;
+			const u64 n = u64(1) << 16;
+			std::vector<u64> big_lh_store(big * 8 + 8, 0);
+			std::vector<u64> big_rh_store(big * 8 + 8, 0);
+			std::vector<u64> dense_store(n * 8 + 8, 0);
+			std::vector<u64> dense_ovf_store(n * 8 + 8, 0);
+			u64* big_lh = (u64*)((uintptr_t(big_lh_store.data()) + 63) & ~uintptr_t(63));
+			u64* big_rh = (u64*)((uintptr_t(big_rh_store.data()) + 63) & ~uintptr_t(63));
+			u64* dense = (u64*)((uintptr_t(dense_store.data()) + 63) & ~uintptr_t(63));
+			u64* dense_ovf = (u64*)((uintptr_t(dense_ovf_store.data()) + 63) & ~uintptr_t(63));
+			for (u64 t = 0; t < big * 8; t++)
+			{
+				big_lh[t] = RandomU64(&seed);
+				big_rh[t] = RandomU64(&seed);
+			};
+			std::vector<u64> big_lh_idx(n);
+			std::vector<u64> big_rh_idx(n);
+			for (u64 k = 0; k < n; k++)
+			{
+				big_lh_idx[k] = RandomU64(&seed) % big;
+				big_rh_idx[k] = RandomU64(&seed) % big;
+			};
+			const int reps = 10;
+			auto start = std::chrono::steady_clock::now();
+			for (int r = 0; r < reps; r++)
+			{
+				for (u64 k = 0; k < n; k++)
+				{
+					add_u(dense + k * 8, big_lh + big_lh_idx[k] * 8, big_rh + big_rh_idx[k] * 8);
+				};
+			};
+			std::chrono::duration<double, std::nano> add_loop = std::chrono::steady_clock::now() - start;
+			start = std::chrono::steady_clock::now();
+			for (int r = 0; r < reps; r++)
+			{
+				add_u_idx(dense, nullptr, big_lh, big_lh_idx.data(), big_rh, big_rh_idx.data(), n);
+			};
+			std::chrono::duration<double, std::nano> add_idx = std::chrono::steady_clock::now() - start;
+			start = std::chrono::steady_clock::now();
+			for (int r = 0; r < reps; r++)
+			{
+				for (u64 k = 0; k < n; k++)
+				{
+					mult_u(dense + k * 8, dense_ovf + k * 8, big_lh + big_lh_idx[k] * 8, big_rh + big_rh_idx[k] * 8);
+				};
+			};
+			std::chrono::duration<double, std::nano> mult_loop = std::chrono::steady_clock::now() - start;
+			start = std::chrono::steady_clock::now();
+			for (int r = 0; r < reps; r++)
+			{
+				mult_u_idx(dense, dense_ovf, nullptr, big_lh, big_lh_idx.data(), big_rh, big_rh_idx.data(), n);
+			};
+			std::chrono::duration<double, std::nano> mult_idx = std::chrono::steady_clock::now() - start;
+			const double per = double(n) * double(reps);
+			string msg = std::format("Indexed batches over 2 x {} MiB tables, {} random indexes, ns per element:\n", big * 64 / (1024 * 1024), n);
+			msg += std::format("\tadd_u loop {:>8.2f}, add_u_idx {:>8.2f} (prefetch {} ahead)\n", add_loop.count() / per, add_idx.count() / per, 8);
+			msg += std::format("\tmult_u loop {:>8.2f}, mult_u_idx {:>8.2f}\n", mult_loop.count() / per, mult_idx.count() / per);
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested dense and scattered results, carries, masks and counts against the direct routines, and volatile register integrity via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_22_montshape)
+		{
+			// Montgomery modulus shapes: mont_setup_u records the shape, mont_mul_u picks its reduction by it
+			// For each family of moduli (generic, low qword all ones, sparse, both): the shape is as expected, and mont_mul_u
+			// gives the same result as with the shape flags cleared (the generic reduction). A 256 bit modulus with a low qword
+			// of all ones (sparse and N' = 1) is also checked against mult_u then div_u. Then times each family, shaped and generic.
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_MONTCTX(ctx);
+			_MONTCTX(generic);
+			_UI512(modulus) { 0 };
+			_UI512(num1) { 0 };
+			_UI512(num2) { 0 };
+			_UI512(mnum1) { 0 };
+			_UI512(mnum2) { 0 };
+			_UI512(result) { 0 };
+			_UI512(expected) { 0 };
+			_UI512(product) { 0 };
+			_UI512(overflow) { 0 };
+			_UI512(quotient) { 0 };
+
+			struct Family
+			{
+				const char* name;
+				u64 limbs;												// expected non-zero qword mask
+				u64 flags;
+			};
+			const Family families[4] = {
+				{ "generic", 0xFF, 0 },
+				{ "N' = 1", 0xFF, mshape_nprime1 },
+				{ "sparse", 0x81, mshape_sparse },
+				{ "sparse, N' = 1", 0x81, mshape_sparse | mshape_nprime1 } };
+			auto RandomModulus = [&](int family)
+				{
+					RandomFill(modulus, &seed);
+					for (int j = 1; j < 7; j++)
+					{
+						modulus[j] = (family >= 2) ? 0 : (modulus[j] | 1ull);
+					};
+					modulus[0] |= 0x8000000000000000ull;
+					modulus[7] = (family % 2 == 1) ? u64_Max : ((modulus[7] | 1ull) == u64_Max ? 1ull : (modulus[7] | 1ull));
+				};
+			auto RandomOperands = [&]()
+				{
+					RandomFill(num1, &seed);
+					RandomFill(num2, &seed);
+					num1[0] &= 0x7FFFFFFFFFFFFFFFull;						// below 2^511, so below N
+					num2[0] &= 0x7FFFFFFFFFFFFFFFull;
+				};
+
+			for (int f = 0; f < 4; f++)
+			{
+				for (int i = 0; i < test_run_count; i++)
+				{
+					RandomModulus(f);
+					RandomOperands();
+					reg_verify((u64*)&r_before);
+					s16 ret = mont_setup_u(ctx, modulus);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s16(0), ret, L"Return code failed Montgomery setup test.");
+					Assert::AreEqual(families[f].limbs | families[f].flags, _MONTSHAPE(ctx), _MSGW(L"Shape failed for family " << f << " on run #" << i));
+					for (int j = 0; j < 32; j++)
+					{
+						generic[j] = ctx[j];
+					};
+					_MONTSHAPE(generic) = 0;
+					mont_to_u(mnum1, num1, ctx);
+					mont_to_u(mnum2, num2, ctx);
+					mont_mul_u(expected, mnum1, mnum2, generic);
+					reg_verify((u64*)&r_before);
+					ret = mont_mul_u(result, mnum1, mnum2, ctx);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s16(0), ret, L"Return code failed Montgomery multiply test.");
+					for (int j = 0; j < 8; j++)
+					{
+						Assert::AreEqual(expected[j], result[j], _MSGW(L"Product at word #" << j << " failed for family " << f << " on run #" << i));
+					};
+				};
+			};
+
+			// 256 bit modulus, low qword all ones: against mult_u then div_u
+			for (int i = 0; i < test_run_count; i++)
+			{
+				zero_u(modulus);
+				for (int j = 4; j < 7; j++)
+				{
+					modulus[j] = RandomU64(&seed);
+				};
+				modulus[4] |= 0x8000000000000000ull;
+				modulus[7] = u64_Max;
+				RandomFill(product, &seed);
+				div_u(quotient, num1, product, modulus);
+				RandomFill(product, &seed);
+				div_u(quotient, num2, product, modulus);
+				Assert::AreEqual(s16(0), mont_setup_u(ctx, modulus), L"Return code failed Montgomery setup test.");
+				Assert::AreEqual(u64(mshape_sparse | mshape_nprime1), _MONTSHAPE(ctx) & (mshape_sparse | mshape_nprime1), _MSGW(L"Shape failed for 256 bit modulus on run #" << i));
+				mult_u(product, overflow, num1, num2);
+				div_u(quotient, expected, product, modulus);
+				mont_to_u(mnum1, num1, ctx);
+				mont_to_u(mnum2, num2, ctx);
+				mont_mul_u(result, mnum1, mnum2, ctx);
+				mont_from_u(result, result, ctx);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Product at word #" << j << " failed for 256 bit modulus on run #" << i));
+				};
+			};
+
+			// timing: shaped against the generic reduction, same moduli and operands
+			const int timing_count = 1000000;
+			string msg = "Montgomery multiply by modulus shape, ns per mont_mul_u:\n";
+			for (int f = 0; f < 4; f++)
+			{
+				RandomModulus(f);
+				RandomOperands();
+				mont_setup_u(ctx, modulus);
+				for (int j = 0; j < 32; j++)
+				{
+					generic[j] = ctx[j];
+				};
+				_MONTSHAPE(generic) = 0;
+				mont_to_u(mnum1, num1, ctx);
+				mont_to_u(mnum2, num2, ctx);
+				auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < timing_count; i++)
+				{
+					mont_mul_u(mnum1, mnum1, mnum2, generic);
+				};
+				std::chrono::duration<double, std::nano> generic_time = std::chrono::steady_clock::now() - start;
+				start = std::chrono::steady_clock::now();
+				for (int i = 0; i < timing_count; i++)
+				{
+					mont_mul_u(mnum1, mnum1, mnum2, ctx);
+				};
+				std::chrono::duration<double, std::nano> shaped_time = std::chrono::steady_clock::now() - start;
+				msg += std::format("\t{:<16} shape {:#06x}: generic {:>8.2f}, shaped {:>8.2f} ({:+.1f}%)\n", families[f].name, _MONTSHAPE(ctx),
+					generic_time.count() / timing_count, shaped_time.count() / timing_count,
+					100.0 * (shaped_time.count() - generic_time.count()) / generic_time.count());
+			};
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested shape detection, shaped against generic reduction, expected values, return value, and volatile register integrity via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_23_expplan)
+		{
+			// Fixed exponent plans: exp_plan_u, exp_exec_u
+			// Random, sparse, dense (all ones), small, zero and one exponents: exp_exec_u with the plan gives the same result as mont_pow_u,
+			// for several bases per plan. A plan copied through a file gives the same result; a plan with a bad tag is refused.
+			// Then times N - 2 (Fermat inverse) and (N + 1) / 4 (square root) exponents: mont_pow_u against exp_exec_u with the plan made once.
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_MONTCTX(ctx);
+			_EXPPLAN(plan);
+			_EXPPLAN(loaded);
+			_UI512(modulus) { 0 };
+			_UI512(exponent) { 0 };
+			_UI512(base) { 0 };
+			_UI512(mbase) { 0 };
+			_UI512(expected) { 0 };
+			_UI512(result) { 0 };
+
+			auto RandomModulus = [&]()
+				{
+					RandomFill(modulus, &seed);
+					modulus[0] |= 0x8000000000000000ull;
+					modulus[7] |= 1ull;
+					mont_setup_u(ctx, modulus);
+				};
+			auto CheckPlan = [&](int run, const wchar_t* kind)
+				{
+					reg_verify((u64*)&r_before);
+					s16 ret = exp_plan_u(plan, exponent);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s16(0), ret, L"Return code failed plan test.");
+					Assert::IsTrue(plan[1] >= 1 && plan[1] <= 6, _MSGW(L"Window width failed for " << kind << " exponent on run #" << run));
+					Assert::AreEqual(u64(msb_u(exponent) + 1), plan[3], _MSGW(L"Exponent bit length failed for " << kind << " exponent on run #" << run));
+					for (int b = 0; b < 3; b++)
+					{
+						RandomFill(base, &seed);
+						base[0] &= 0x7FFFFFFFFFFFFFFFull;
+						mont_to_u(mbase, base, ctx);
+						mont_pow_u(expected, mbase, exponent, ctx);
+						reg_verify((u64*)&r_before);
+						ret = exp_exec_u(result, mbase, plan, ctx);
+						reg_verify((u64*)&r_after);
+						Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+						Assert::AreEqual(s16(0), ret, L"Return code failed execute test.");
+						for (int j = 0; j < 8; j++)
+						{
+							Assert::AreEqual(expected[j], result[j], _MSGW(L"Power at word #" << j << " failed for " << kind << " exponent on run #" << run));
+						};
+					};
+				};
+
+			for (int i = 0; i < test_run_count / 10; i++)
+			{
+				RandomModulus();
+				RandomFill(exponent, &seed);
+				CheckPlan(i, L"random");
+				zero_u(exponent);
+				exponent[RandomU64(&seed) % 8] = u64(1) << (RandomU64(&seed) % 64);
+				exponent[7] |= RandomU64(&seed) & 0x11;
+				CheckPlan(i, L"sparse");
+				for (int j = 0; j < 8; j++)
+				{
+					exponent[j] = u64_Max;
+				};
+				exponent[0] >>= RandomU64(&seed) % 64;
+				CheckPlan(i, L"dense");
+				set_uT64(exponent, RandomU64(&seed) % 1000);
+				CheckPlan(i, L"small");
+			};
+
+			// zero and one; result aliasing the base
+			RandomModulus();
+			RandomFill(base, &seed);
+			base[0] &= 0x7FFFFFFFFFFFFFFFull;
+			mont_to_u(mbase, base, ctx);
+			zero_u(exponent);
+			Assert::AreEqual(s16(0), exp_plan_u(plan, exponent), L"Return code failed zero exponent plan.");
+			Assert::AreEqual(0ull, plan[2], L"Steps failed for zero exponent.");
+			exp_exec_u(result, mbase, plan, ctx);
+			for (int j = 0; j < 8; j++)
+			{
+				Assert::AreEqual(ctx[8 + j], result[j], _MSGW(L"Zero exponent gave other than one at word #" << j));
+			};
+			set_uT64(exponent, 1ull);
+			exp_plan_u(plan, exponent);
+			copy_u(result, mbase);
+			exp_exec_u(result, result, plan, ctx);
+			for (int j = 0; j < 8; j++)
+			{
+				Assert::AreEqual(mbase[j], result[j], _MSGW(L"Exponent of one failed at word #" << j));
+			};
+
+			// saved and reloaded
+			RandomFill(exponent, &seed);
+			exp_plan_u(plan, exponent);
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "ui512md_expplan.bin";
+			{
+				FILE* f = nullptr;
+				Assert::IsTrue(fopen_s(&f, path.string().c_str(), "wb") == 0 && f != nullptr, L"Plan file create failed.");
+				fwrite(plan, sizeof(u64), 144, f);
+				fclose(f);
+				Assert::IsTrue(fopen_s(&f, path.string().c_str(), "rb") == 0 && f != nullptr, L"Plan file open failed.");
+				Assert::AreEqual(size_t(144), fread(loaded, sizeof(u64), 144, f), L"Plan file read failed.");
+				fclose(f);
+				std::filesystem::remove(path);
+			};
+			mont_pow_u(expected, mbase, exponent, ctx);
+			Assert::AreEqual(s16(0), exp_exec_u(result, mbase, loaded, ctx), L"Return code failed reloaded plan.");
+			for (int j = 0; j < 8; j++)
+			{
+				Assert::AreEqual(expected[j], result[j], _MSGW(L"Reloaded plan failed at word #" << j));
+			};
+			loaded[0] ^= 1;
+			copy_u(result, mbase);
+			Assert::AreEqual(s16(-1), exp_exec_u(result, mbase, loaded, ctx), L"Return code failed bad plan.");
+			for (int j = 0; j < 8; j++)
+			{
+				Assert::AreEqual(mbase[j], result[j], _MSGW(L"Bad plan changed result at word #" << j));
+			};
+
+			// timing: fixed exponents, many bases
+			const int timing_count = 2000;
+			_UI512(two) { 0 };
+			set_uT64(two, 2ull);
+			string msg = "Fixed exponent plans, microseconds per exponentiation (512 bit modulus):\n";
+			for (int e = 0; e < 2; e++)
+			{
+				if (e == 0)
+				{
+					sub_u(exponent, modulus, two);								// N - 2
+				}
+				else
+				{
+					add_uT64(exponent, modulus, 1ull);							// ( N + 1 ) / 4
+					shr_u(exponent, exponent, 2);
+				};
+				auto start = std::chrono::steady_clock::now();
+				exp_plan_u(plan, exponent);
+				std::chrono::duration<double, std::micro> plan_time = std::chrono::steady_clock::now() - start;
+				start = std::chrono::steady_clock::now();
+				for (int i = 0; i < timing_count; i++)
+				{
+					mont_pow_u(result, mbase, exponent, ctx);
+				};
+				std::chrono::duration<double, std::micro> pow_time = std::chrono::steady_clock::now() - start;
+				start = std::chrono::steady_clock::now();
+				for (int i = 0; i < timing_count; i++)
+				{
+					exp_exec_u(result, mbase, plan, ctx);
+				};
+				std::chrono::duration<double, std::micro> exec_time = std::chrono::steady_clock::now() - start;
+				msg += std::format("\t{:<10} window {}, {} squarings, {} multiplies; plan {:>8.2f}, mont_pow_u {:>8.2f}, exp_exec_u {:>8.2f}\n",
+					(e == 0) ? "N - 2" : "(N + 1)/4", plan[1], plan[4], plan[5], plan_time.count(), pow_time.count() / timing_count, exec_time.count() / timing_count);
+			};
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested plans against mont_pow_u, zero and one exponents, reload, bad plan, and volatile register integrity via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_24_pow)
+		{
+			// Truncated multiply mult_lo_u, and integer power pow_u
+			// mult_lo_u: the product of mult_u, also in place. pow_u: against repeated mult_u checking the overflow, for bases of every
+			// bit length and exponents either side of the 512 bit boundary, plus the edge cases 0, 1, x ^ 0, x ^ 1 and huge exponents.
+			// Then times pow_u against the repeated multiply, for results that fit and that overflow.
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(x) { 0 };
+			_UI512(y) { 0 };
+			_UI512(product) { 0 };
+			_UI512(overflow) { 0 };
+			_UI512(result) { 0 };
+			_UI512(expected) { 0 };
+
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomFill(x, &seed);
+				RandomFill(y, &seed);
+				x[RandomU64(&seed) % 8] = 0;
+				mult_u(product, overflow, x, y);
+				reg_verify((u64*)&r_before);
+				s16 ret = mult_lo_u(result, x, y);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Return code failed truncated multiply test.");
+				mult_lo_u(x, x, y);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(product[j], result[j], _MSGW(L"Truncated product at word #" << j << " failed on run #" << i));
+					Assert::AreEqual(product[j], x[j], _MSGW(L"In place truncated product at word #" << j << " failed on run #" << i));
+				};
+			};
+
+			// reference: multiply k times, stopping at the first overflow (x > 1 overflows within 512 multiplies)
+			auto RefPow = [&](u64* out, const u64* base, u64 k) -> s16
+				{
+					set_uT64(out, 1ull);
+					for (u64 n = 0; n < k; n++)
+					{
+						mult_u(out, overflow, out, base);
+						if (compare_uT64(overflow, 0ull) != 0)
+						{
+							zero_u(out);
+							return 1;
+						};
+					};
+					return 0;
+				};
+			for (int i = 0; i < test_run_count; i++)
+			{
+				const u64 bits = 2 + RandomU64(&seed) % 511;					// bit length of x, 2 to 512
+				RandomFill(x, &seed);
+				shr_u(x, x, u32(512 - bits));
+				x[7 - (bits - 1) / 64] |= u64(1) << ((bits - 1) % 64);
+				const u64 boundary = 512 / bits;								// largest k with b * k <= 512
+				const u64 k = boundary + RandomU64(&seed) % 5 - 2;					// either side of it (wraps to a huge k when boundary is one)
+				const s16 expected_ret = RefPow(expected, x, k);
+				copy_u(y, x);
+				reg_verify((u64*)&r_before);
+				s16 ret = pow_u(result, x, k);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(expected_ret, ret, _MSGW(L"Overflow status failed for " << bits << " bits ^ " << k << " on run #" << i));
+				pow_u(y, y, k);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Power at word #" << j << " failed for " << bits << " bits ^ " << k << " on run #" << i));
+					Assert::AreEqual(expected[j], y[j], _MSGW(L"In place power at word #" << j << " failed on run #" << i));
+				};
+			};
+
+			// edge cases
+			zero_u(x);
+			Assert::AreEqual(s16(0), pow_u(result, x, 0), L"0 ^ 0 return failed.");
+			Assert::AreEqual(s16(0), compare_uT64(result, 1ull), L"0 ^ 0 failed.");
+			Assert::AreEqual(s16(0), pow_u(result, x, u64_Max), L"0 ^ k return failed.");
+			Assert::AreEqual(s16(0), compare_uT64(result, 0ull), L"0 ^ k failed.");
+			set_uT64(x, 1ull);
+			Assert::AreEqual(s16(0), pow_u(result, x, u64_Max), L"1 ^ k return failed.");
+			Assert::AreEqual(s16(0), compare_uT64(result, 1ull), L"1 ^ k failed.");
+			set_uT64(x, 2ull);
+			Assert::AreEqual(s16(0), pow_u(result, x, 511), L"2 ^ 511 return failed.");
+			Assert::AreEqual(s16(510), msb_u(result), L"2 ^ 511 failed.");
+			Assert::AreEqual(s16(1), pow_u(result, x, 512), L"2 ^ 512 return failed.");
+			Assert::AreEqual(s16(1), pow_u(result, x, u64_Max), L"2 ^ huge return failed.");
+			Assert::AreEqual(s16(0), compare_uT64(result, 0ull), L"Overflow result not zero.");
+			RandomFill(x, &seed);
+			Assert::AreEqual(s16(0), pow_u(result, x, 1), L"x ^ 1 return failed.");
+			for (int j = 0; j < 8; j++)
+			{
+				Assert::AreEqual(x[j], result[j], _MSGW(L"x ^ 1 failed at word #" << j));
+			};
+
+			// timing
+			const int timing_count = 20000;
+			string msg = "Integer power, ns per call, pow_u against multiplying k times checking the overflow:\n";
+			const u64 cases[3][2] = { { 64, 8 }, { 17, 30 }, { 100, 6 } };	// bits of x, k: fits, fits, overflows
+			for (const auto& c : cases)
+			{
+				zero_u(x);
+				x[7] = u64_Max >> (64 - std::min<u64>(c[0], 64));
+				if (c[0] > 64)
+				{
+					x[6] = u64_Max >> (128 - c[0]);
+				};
+				auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < timing_count; i++)
+				{
+					RefPow(expected, x, c[1]);
+				};
+				std::chrono::duration<double, std::nano> ref_time = std::chrono::steady_clock::now() - start;
+				start = std::chrono::steady_clock::now();
+				s16 ret = 0;
+				for (int i = 0; i < timing_count; i++)
+				{
+					ret = pow_u(result, x, c[1]);
+				};
+				std::chrono::duration<double, std::nano> pow_time = std::chrono::steady_clock::now() - start;
+				msg += std::format("\t{:>3} bits ^ {:<3} ({}): multiply loop {:>10.1f}, pow_u {:>10.1f}\n", c[0], c[1], (ret == 0) ? "fits" : "overflow",
+					ref_time.count() / timing_count, pow_time.count() / timing_count);
+			};
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested truncated products, powers and overflow status against repeated mult_u, edge cases, and volatile register integrity via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_25_ilog)
+		{
+			// Integer logarithms: ilog10_u (built in table), ilog_u with tables from ilog_setup_u, and the batch forms ilog_u_n, ilog10_u_n
+			// Against a reference counting divisions by the base (div_uT64) until zero, for values of every bit length and several bases,
+			// plus the edges 0, 1, and each power and power - 1. Then times ilog10_u against the division count.
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(x) { 0 };
+			_UI512(quotient) { 0 };
+			_ILOGTAB(table) = { 0 };
+
+			// reference: number of divisions by base to reach zero, less one (-1 for zero)
+			auto RefLog = [&](const u64* value, u64 base) -> s16
+				{
+					u64 remainder = 0;
+					s16 log = -1;
+					copy_u(quotient, value);
+					while (compare_uT64(quotient, 0ull) != 0)
+					{
+						div_uT64(quotient, &remainder, quotient, base);
+						log++;
+					};
+					return log;
+				};
+
+			Assert::AreEqual(s16(-1), ilog_setup_u(table, 1), L"Setup failed to reject base 1.");
+			Assert::AreEqual(s16(-1), ilog_setup_u(table, 0), L"Setup failed to reject base 0.");
+
+			const u64 bases[] = { 10, 2, 3, 7, 16, 1000, 0xFFFFFFFFull, u64_Max };
+			for (u64 base : bases)
+			{
+				reg_verify((u64*)&r_before);
+				s16 ret = ilog_setup_u(table, base);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, _MSGW(L"Setup return failed for base " << base));
+				Assert::AreEqual(base, table[0], _MSGW(L"Table base failed for base " << base));
+
+				const int values = test_run_count / 4;
+				std::vector<u64> storage(values * 8 + 8, 0);
+				u64* pool = (u64*)((uintptr_t(storage.data()) + 63) & ~uintptr_t(63));
+				std::vector<s16> results(values, 0);
+				for (int i = 0; i < values; i++)
+				{
+					u64* v = pool + i * 8;
+					RandomFill(v, &seed);
+					shr_u(v, v, u32(RandomU64(&seed) % 512));
+					const s16 expected = RefLog(v, base);
+					reg_verify((u64*)&r_before);
+					ret = ilog_u(v, table);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(expected, ret, _MSGW(L"Logarithm failed for base " << base << " on run #" << i));
+					if (base == 10)
+					{
+						Assert::AreEqual(expected, ilog10_u(v), _MSGW(L"Decimal logarithm failed on run #" << i));
+					};
+				};
+				reg_verify((u64*)&r_before);
+				ret = ilog_u_n(results.data(), pool, values, table);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(s16(0), ret, L"Batch return failed.");
+				for (int i = 0; i < values; i++)
+				{
+					Assert::AreEqual(ilog_u(pool + i * 8, table), results[i], _MSGW(L"Batch logarithm failed for base " << base << " at #" << i));
+				};
+				if (base == 10)
+				{
+					std::fill(results.begin(), results.end(), s16(0));
+					Assert::AreEqual(s16(0), ilog10_u_n(results.data(), pool, values), L"Decimal batch return failed.");
+					for (int i = 0; i < values; i++)
+					{
+						Assert::AreEqual(ilog10_u(pool + i * 8), results[i], _MSGW(L"Decimal batch logarithm failed at #" << i));
+					};
+				};
+
+				// edges: zero, and every power that fits, and one less
+				zero_u(x);
+				Assert::AreEqual(s16(-1), ilog_u(x, table), L"Logarithm of zero failed.");
+				set_uT64(x, 1ull);
+				u64 overflow = 0;
+				for (s16 k = 0; overflow == 0; k++)
+				{
+					Assert::AreEqual(k, ilog_u(x, table), _MSGW(L"Logarithm of power " << k << " failed for base " << base));
+					if (k > 0)
+					{
+						copy_u(quotient, x);
+						sub_uT64(quotient, quotient, 1ull);
+						Assert::AreEqual(s16(k - 1), ilog_u(quotient, table), _MSGW(L"Logarithm of power " << k << " - 1 failed for base " << base));
+					};
+					mult_uT64(x, &overflow, x, base);
+				};
+				for (int j = 0; j < 8; j++)
+				{
+					x[j] = u64_Max;
+				};
+				Assert::AreEqual(RefLog(x, base), ilog_u(x, table), _MSGW(L"Logarithm of 2^512 - 1 failed for base " << base));
+			};
+
+			// the built in decimal table is the one ilog_setup_u builds
+			ilog_setup_u(table, 10);
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomFill(x, &seed);
+				shr_u(x, x, u32(RandomU64(&seed) % 512));
+				Assert::AreEqual(ilog_u(x, table), ilog10_u(x), _MSGW(L"Decimal logarithm against base 10 table failed on run #" << i));
+			};
+
+			// timing
+			const int timing_count = 20000;
+			RandomFill(x, &seed);
+			auto start = std::chrono::steady_clock::now();
+			s16 digits = 0;
+			for (int i = 0; i < timing_count / 100; i++)
+			{
+				digits = RefLog(x, 10);
+			};
+			std::chrono::duration<double, std::nano> ref_time = std::chrono::steady_clock::now() - start;
+			start = std::chrono::steady_clock::now();
+			for (int i = 0; i < timing_count; i++)
+			{
+				digits = ilog10_u(x);
+			};
+			std::chrono::duration<double, std::nano> log_time = std::chrono::steady_clock::now() - start;
+			string msg = std::format("Decimal logarithm of a 512 bit value ({} digits), ns per call: division count {:>10.1f}, ilog10_u {:>10.1f}\n",
+				digits + 1, ref_time.count() / (timing_count / 100), log_time.count() / timing_count);
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested ilog10_u, ilog_u and their batch forms against division counts, powers and neighbours, and volatile register integrity via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_26_divround)
+		{
+			// Rounded division div_round_u, div_round_uT64 in each mode
+			// Against div_u (div_uT64) then a doubled remainder compared to the divisor, for random operands of every length,
+			// and for dividends built as q * d + r with r at 0, 1, half - 1, half, half + 1 and d - 1 (odd and even quotients, odd and even divisors).
+			// Then times div_round_u against div_u with the caller's rounding (shl_u, compare_u, add_uT64).
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(dividend) { 0 };
+			_UI512(divisor) { 0 };
+			_UI512(quotient) { 0 };
+			_UI512(remainder) { 0 };
+			_UI512(twice) { 0 };
+			_UI512(expected) { 0 };
+			_UI512(result) { 0 };
+			u64 overflow = 0;
+
+			// reference: the truncated quotient, rounded by comparing 2 * remainder (with its top bit) to the divisor
+			auto RefRound = [&](u64* out, const u64* n, const u64* d, u64 mode)
+				{
+					div_u(out, remainder, n, d);
+					mult_uT64(twice, &overflow, remainder, 2);
+					const s16 half = (overflow != 0) ? s16(1) : compare_u(twice, d);
+					const bool odd = (out[7] & 1) != 0;
+					bool up = false;
+					switch (mode)
+					{
+					case rnd_ceil: up = compare_uT64(remainder, 0ull) != 0; break;
+					case rnd_half_even: up = half > 0 || (half == 0 && odd); break;
+					case rnd_half_up: up = half >= 0 && compare_uT64(remainder, 0ull) != 0; break;
+					};
+					if (up)
+					{
+						add_uT64(out, out, 1ull);
+					};
+				};
+
+			auto Check = [&](const u64* n, const u64* d, const wchar_t* what, int run)
+				{
+					for (u64 mode = rnd_floor; mode <= rnd_half_up; mode++)
+					{
+						RefRound(expected, n, d, mode);
+						reg_verify((u64*)&r_before);
+						s16 ret = div_round_u(result, n, d, mode);
+						reg_verify((u64*)&r_after);
+						Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+						Assert::AreEqual(s16(0), ret, _MSGW(L"Return failed for " << what << " mode " << mode << " on run #" << run));
+						for (int j = 0; j < 8; j++)
+						{
+							Assert::AreEqual(expected[j], result[j], _MSGW(L"Quotient at word #" << j << " failed for " << what << " mode " << mode << " on run #" << run));
+						};
+						if (compare_uT64(d, d[7]) == 0)
+						{
+							copy_u(result, n);
+							reg_verify((u64*)&r_before);
+							ret = div_round_uT64(result, result, d[7], mode);
+							reg_verify((u64*)&r_after);
+							Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+							Assert::AreEqual(s16(0), ret, _MSGW(L"T64 return failed for " << what << " mode " << mode << " on run #" << run));
+							for (int j = 0; j < 8; j++)
+							{
+								Assert::AreEqual(expected[j], result[j], _MSGW(L"T64 quotient at word #" << j << " failed for " << what << " mode " << mode << " on run #" << run));
+							};
+						};
+					};
+				};
+
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomFill(dividend, &seed);
+				RandomFill(divisor, &seed);
+				shr_u(divisor, divisor, u32(RandomU64(&seed) % 512));
+				if (compare_uT64(divisor, 0ull) == 0)
+				{
+					divisor[7] = 1;
+				};
+				Check(dividend, divisor, L"random", i);
+				zero_u(divisor);
+				divisor[7] = RandomU64(&seed) | 1;
+				Check(dividend, divisor, L"64 bit", i);
+			};
+
+			// remainders at and around half the divisor: dividend = q * d + r
+			const u64 small_divisors[] = { 2, 3, 10, 0x8000000000000000ull, u64_Max };
+			for (int i = 0; i < test_run_count / 10; i++)
+			{
+				zero_u(divisor);
+				if (i % 2 == 0)
+				{
+					divisor[7] = small_divisors[(i / 2) % 5];
+				}
+				else
+				{
+					RandomFill(divisor, &seed);
+					shr_u(divisor, divisor, u32(64 + RandomU64(&seed) % 320));
+					divisor[7] |= 2;
+				};
+				_UI512(q) { 0 };
+				_UI512(r) { 0 };
+				_UI512(halfd) { 0 };
+				RandomFill(q, &seed);
+				shr_u(q, q, u32(msb_u(divisor) + 2));
+				shr_u(halfd, divisor, 1);
+				const u64 adjust[] = { 0, 1, 2, 3, 4, 5 };
+				for (u64 a : adjust)
+				{
+					for (u64 parity = 0; parity < 2; parity++)
+					{
+						q[7] = (q[7] & ~1ull) | parity;
+						switch (a)
+						{
+						case 0: zero_u(r); break;
+						case 1: set_uT64(r, 1ull); break;
+						case 2: sub_uT64(r, halfd, 1ull); break;
+						case 3: copy_u(r, halfd); break;
+						case 4: add_uT64(r, halfd, 1ull); break;
+						case 5: sub_uT64(r, divisor, 1ull); break;
+						};
+						if (compare_u(r, divisor) >= 0)
+						{
+							continue;
+						};
+						mult_u(dividend, twice, q, divisor);
+						add_u(dividend, dividend, r);
+						Check(dividend, divisor, L"near half", i);
+					};
+				};
+			};
+
+			// errors
+			zero_u(divisor);
+			RandomFill(dividend, &seed);
+			Assert::AreEqual(s16(-1), div_round_u(result, dividend, divisor, rnd_ceil), L"Divide by zero return failed.");
+			Assert::AreEqual(s16(-1), div_round_uT64(result, dividend, 0, rnd_ceil), L"T64 divide by zero return failed.");
+			Assert::AreEqual(s16(0), compare_uT64(result, 0ull), L"T64 divide by zero quotient failed.");
+			set_uT64(divisor, 3ull);
+			Assert::AreEqual(s16(-1), div_round_u(result, dividend, divisor, rnd_half_up + 1), L"Unknown mode return failed.");
+			Assert::AreEqual(s16(-1), div_round_uT64(result, dividend, 3, rnd_half_up + 1), L"T64 unknown mode return failed.");
+
+			// timing
+			const int timing_count = 20000;
+			RandomFill(dividend, &seed);
+			RandomFill(divisor, &seed);
+			shr_u(divisor, divisor, 200);
+			auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < timing_count; i++)
+			{
+				div_u(expected, remainder, dividend, divisor);
+				shl_u(twice, remainder, u16(1));
+				if (compare_u(twice, divisor) >= 0)
+				{
+					add_uT64(expected, expected, 1ull);
+				};
+			};
+			std::chrono::duration<double, std::nano> ref_time = std::chrono::steady_clock::now() - start;
+			start = std::chrono::steady_clock::now();
+			for (int i = 0; i < timing_count; i++)
+			{
+				div_round_u(result, dividend, divisor, rnd_half_up);
+			};
+			std::chrono::duration<double, std::nano> round_time = std::chrono::steady_clock::now() - start;
+			start = std::chrono::steady_clock::now();
+			for (int i = 0; i < timing_count; i++)
+			{
+				div_uT64(expected, &overflow, dividend, 10);
+				if (overflow >= 5)
+				{
+					add_uT64(expected, expected, 1ull);
+				};
+			};
+			std::chrono::duration<double, std::nano> ref64_time = std::chrono::steady_clock::now() - start;
+			start = std::chrono::steady_clock::now();
+			for (int i = 0; i < timing_count; i++)
+			{
+				div_round_uT64(result, dividend, 10, rnd_half_up);
+			};
+			std::chrono::duration<double, std::nano> round64_time = std::chrono::steady_clock::now() - start;
+			string msg = std::format("Rounded division, ns per call: div_u and caller rounding {:>8.1f}, div_round_u {:>8.1f}; div_uT64 and caller rounding {:>8.1f}, div_round_uT64 {:>8.1f}\n",
+				ref_time.count() / timing_count, round_time.count() / timing_count, ref64_time.count() / timing_count, round64_time.count() / timing_count);
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested div_round_u, div_round_uT64 in each mode against div_u with a doubled remainder, near half remainders, errors, and volatile register integrity via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_27_multmid)
+		{
+			// Mid-size multiplies mult_uT128, mult_uT256, and mult_u's dispatch to them
+			// Against the plain C++ reference product (ui512compare::ref_mul) for multipliers of every length up to 256 bits, all ones,
+			// in place (product is the multiplicand, or the multiplier), and mult_u with short operands on either side.
+			// Then times mult_uT128 and mult_uT256 against two (four) mult_uT64 calls with shifted adds, and mult_u with a short multiplier.
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(x) { 0 };
+			_UI512(y) { 0 };
+			_UI512(product) { 0 };
+			_UI512(overflow) { 0 };
+			_UI512(expected) { 0 };
+			_UI512(expected_ovf) { 0 };
+			_UI512(work) { 0 };
+			ALIGN64 u64 ovf[4] = { 0 };
+
+			for (int i = 0; i < test_run_count; i++)
+			{
+				RandomFill(x, &seed);
+				RandomFill(y, &seed);
+				if (i % 10 == 0)
+				{
+					for (int j = 0; j < 8; j++)
+					{
+						x[j] = y[j] = u64_Max;
+					};
+				};
+				for (int qwords : { 4, 2 })
+				{
+					for (int j = 0; j < 8 - qwords; j++)
+					{
+						y[j] = 0;
+					};
+					ui512compare::ref_mul(expected, expected_ovf, x, y);
+					reg_verify((u64*)&r_before);
+					s16 ret = (qwords == 2) ? mult_uT128(product, ovf, x, y + 6) : mult_uT256(product, ovf, x, y + 4);
+					reg_verify((u64*)&r_after);
+					Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+					Assert::AreEqual(s16(0), ret, L"Return code failed.");
+					for (int j = 0; j < 8; j++)
+					{
+						Assert::AreEqual(expected[j], product[j], _MSGW(L"Product at word #" << j << " failed for " << qwords << " qwords on run #" << i));
+					};
+					for (int j = 0; j < qwords; j++)
+					{
+						Assert::AreEqual(expected_ovf[8 - qwords + j], ovf[j], _MSGW(L"Overflow at word #" << j << " failed for " << qwords << " qwords on run #" << i));
+					};
+
+					// in place: product is the multiplicand, then the multiplier (its low qwords)
+					copy_u(work, x);
+					(qwords == 2) ? mult_uT128(work, ovf, work, y + 6) : mult_uT256(work, ovf, work, y + 4);
+					for (int j = 0; j < 8; j++)
+					{
+						Assert::AreEqual(expected[j], work[j], _MSGW(L"In place (multiplicand) product at word #" << j << " failed on run #" << i));
+					};
+					copy_u(work, y);
+					(qwords == 2) ? mult_uT128(work, ovf, x, work + 6) : mult_uT256(work, ovf, x, work + 4);
+					for (int j = 0; j < 8; j++)
+					{
+						Assert::AreEqual(expected[j], work[j], _MSGW(L"In place (multiplier) product at word #" << j << " failed on run #" << i));
+					};
+				};
+
+				// mult_u dispatch: either operand short, of each length
+				RandomFill(y, &seed);
+				const int len = 1 + int(RandomU64(&seed) % 8);
+				for (int j = 0; j < 8 - len; j++)
+				{
+					y[j] = 0;
+				};
+				y[8 - len] |= 2;											// keep it above one
+				ui512compare::ref_mul(expected, expected_ovf, x, y);
+				reg_verify((u64*)&r_before);
+				mult_u(product, overflow, x, y);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], product[j], _MSGW(L"mult_u product at word #" << j << " failed for " << len << " qwords on run #" << i));
+					Assert::AreEqual(expected_ovf[j], overflow[j], _MSGW(L"mult_u overflow at word #" << j << " failed for " << len << " qwords on run #" << i));
+				};
+				mult_u(product, overflow, y, x);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], product[j], _MSGW(L"mult_u (short multiplicand) product at word #" << j << " failed on run #" << i));
+					Assert::AreEqual(expected_ovf[j], overflow[j], _MSGW(L"mult_u (short multiplicand) overflow at word #" << j << " failed on run #" << i));
+				};
+				copy_u(work, x);
+				mult_u(work, overflow, work, y);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], work[j], _MSGW(L"mult_u in place product at word #" << j << " failed on run #" << i));
+				};
+			};
+
+			// timing
+			const int timing_count = 100000;
+			RandomFill(x, &seed);
+			RandomFill(y, &seed);
+			u64 ovf64 = 0;
+			auto Time = [&](auto&& f)
+				{
+					auto start = std::chrono::steady_clock::now();
+					for (int i = 0; i < timing_count; i++)
+					{
+						f();
+					};
+					std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+					return d.count() / timing_count;
+				};
+			// the old way: one mult_uT64 per multiplier qword, each shifted up and added
+			auto ByT64 = [&](int qwords)
+				{
+					zero_u(product);
+					zero_u(overflow);
+					for (int k = 0; k < qwords; k++)
+					{
+						mult_uT64(work, &ovf64, x, y[7 - k]);
+						_UI512(hi) { 0 };
+						_UI512(lo) { 0 };
+						shl_u(lo, work, u16(64 * k));
+						if (k > 0)
+						{
+							shr_u(hi, work, u32(512 - 64 * k));
+						};
+						hi[7 - k] += ovf64;
+						s16 c = add_u(product, product, lo);
+						add_u(overflow, overflow, hi);
+						if (c != 0)
+						{
+							add_uT64(overflow, overflow, 1ull);
+						};
+					};
+				};
+			_UI512(y128) { 0 };
+			_UI512(y256) { 0 };
+			copy_u(y128, y);
+			copy_u(y256, y);
+			for (int j = 0; j < 6; j++)
+			{
+				y128[j] = 0;
+			};
+			for (int j = 0; j < 4; j++)
+			{
+				y256[j] = 0;
+			};
+			const double t64x2 = Time([&]() { ByT64(2); });
+			const double t128u = Time([&]() { mult_u(product, overflow, x, y128); });
+			const double t128 = Time([&]() { mult_uT128(product, ovf, x, y + 6); });
+			const double t64x4 = Time([&]() { ByT64(4); });
+			const double t256u = Time([&]() { mult_u(product, overflow, x, y256); });
+			const double t256 = Time([&]() { mult_uT256(product, ovf, x, y + 4); });
+			string msg = "Mid-size multiply, ns per call:\n";
+			msg += std::format("\t128 bit multiplier: mult_uT64 x 2 with shifted adds {:>8.1f}, mult_u {:>8.1f}, mult_uT128 {:>8.1f}\n", t64x2, t128u, t128);
+			msg += std::format("\t256 bit multiplier: mult_uT64 x 4 with shifted adds {:>8.1f}, mult_u {:>8.1f}, mult_uT256 {:>8.1f}\n", t64x4, t256u, t256);
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested mult_uT128, mult_uT256 and mult_u's dispatch against the reference product, in place, and volatile register integrity via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_28_maskcarry)
+		{
+			// Single register add, subtract and compare: add_uZ, sub_uZ, compare_uZ, and the batch forms add_u_n, sub_u_n, compare_u_n
+			// Against add_u, sub_u, compare_u, with qwords often all ones or zero so that carries and borrows run through several lanes,
+			// in place, and batch against single calls.
+			// Then benchmarks each against the scalar carry chain: latency (each result feeds the next call) and throughput (independent calls).
+			// Note: the timings are informational only
+
+			u64 seed = 0;
+			regs r_before{};
+			regs r_after{};
+			_UI512(x) { 0 };
+			_UI512(y) { 0 };
+			_UI512(expected) { 0 };
+			_UI512(result) { 0 };
+
+			// qwords drawn from random, all ones, zero, one, and all ones less one
+			auto Fill = [&](u64* v)
+				{
+					for (int j = 0; j < 8; j++)
+					{
+						const u64 r = RandomU64(&seed);
+						const u64 pick = RandomU64(&seed) % 5;
+						v[j] = (pick == 0) ? r : (pick == 1) ? u64_Max : (pick == 2) ? 0 : (pick == 3) ? 1 : u64_Max - 1;
+					};
+				};
+
+			for (int i = 0; i < test_run_count * 10; i++)
+			{
+				Fill(x);
+				Fill(y);
+				if (i % 3 == 0)
+				{
+					copy_u(y, x);
+				};
+				s16 expected_carry = add_u(expected, x, y);
+				reg_verify((u64*)&r_before);
+				s16 carry = add_uZ(result, x, y);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(expected_carry, carry, _MSGW(L"Carry failed on run #" << i));
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Sum at word #" << j << " failed on run #" << i));
+				};
+
+				expected_carry = sub_u(expected, x, y);
+				reg_verify((u64*)&r_before);
+				carry = sub_uZ(result, x, y);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(expected_carry, carry, _MSGW(L"Borrow failed on run #" << i));
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"Difference at word #" << j << " failed on run #" << i));
+				};
+
+				reg_verify((u64*)&r_before);
+				s16 cmp = compare_uZ(x, y);
+				reg_verify((u64*)&r_after);
+				Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+				Assert::AreEqual(compare_u(x, y), cmp, _MSGW(L"Compare failed on run #" << i));
+				Assert::AreEqual(compare_u(y, x), compare_uZ(y, x), _MSGW(L"Reversed compare failed on run #" << i));
+
+				// in place
+				add_u(expected, x, y);
+				copy_u(result, x);
+				add_uZ(result, result, y);
+				sub_uZ(y, result, y);
+				for (int j = 0; j < 8; j++)
+				{
+					Assert::AreEqual(expected[j], result[j], _MSGW(L"In place sum at word #" << j << " failed on run #" << i));
+					Assert::AreEqual(x[j], y[j], _MSGW(L"In place difference at word #" << j << " failed on run #" << i));
+				};
+			};
+
+			// batch forms against single calls
+			const u64 count = 257;
+			std::vector<u64> storage(4 * count * 8 + 8, 0);
+			u64* lh = (u64*)((uintptr_t(storage.data()) + 63) & ~uintptr_t(63));
+			u64* rh = lh + count * 8;
+			u64* out = rh + count * 8;
+			u64* ref = out + count * 8;
+			std::vector<s16> cmps(count, 0);
+			for (u64 k = 0; k < count; k++)
+			{
+				Fill(lh + k * 8);
+				Fill(rh + k * 8);
+			};
+			u64 expected_carries = 0;
+			for (u64 k = 0; k < count; k++)
+			{
+				expected_carries += u64(add_u(ref + k * 8, lh + k * 8, rh + k * 8));
+			};
+			reg_verify((u64*)&r_before);
+			u64 carries = add_u_n(out, lh, rh, count);
+			reg_verify((u64*)&r_after);
+			Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+			Assert::AreEqual(expected_carries, carries, L"Batch carries failed.");
+			for (u64 j = 0; j < count * 8; j++)
+			{
+				Assert::AreEqual(ref[j], out[j], _MSGW(L"Batch sum at qword #" << j << " failed"));
+			};
+			expected_carries = 0;
+			for (u64 k = 0; k < count; k++)
+			{
+				expected_carries += u64(sub_u(ref + k * 8, lh + k * 8, rh + k * 8));
+			};
+			reg_verify((u64*)&r_before);
+			carries = sub_u_n(out, lh, rh, count);
+			reg_verify((u64*)&r_after);
+			Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+			Assert::AreEqual(expected_carries, carries, L"Batch borrows failed.");
+			for (u64 j = 0; j < count * 8; j++)
+			{
+				Assert::AreEqual(ref[j], out[j], _MSGW(L"Batch difference at qword #" << j << " failed"));
+			};
+			reg_verify((u64*)&r_before);
+			s16 ret = compare_u_n(cmps.data(), lh, rh, count);
+			reg_verify((u64*)&r_after);
+			Assert::IsTrue(r_before.AreEqual(&r_after), L"Register validation failed");
+			Assert::AreEqual(s16(0), ret, L"Batch compare return failed.");
+			for (u64 k = 0; k < count; k++)
+			{
+				Assert::AreEqual(compare_u(lh + k * 8, rh + k * 8), cmps[k], _MSGW(L"Batch compare failed at #" << k));
+			};
+			Assert::AreEqual(u64(0), add_u_n(out, lh, rh, 0), L"Empty batch failed.");
+
+			// benchmark: latency, each call on the last result; throughput, independent calls over the pool
+			const int timing_count = 100000;
+			auto Time = [&](auto&& f, u64 per)
+				{
+					auto start = std::chrono::steady_clock::now();
+					for (int i = 0; i < timing_count; i++)
+					{
+						f(i);
+					};
+					std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+					return d.count() / (double(timing_count) * double(per));
+				};
+			RandomFill(x, &seed);
+			RandomFill(y, &seed);
+			const int passes = timing_count / int(count);
+			string msg = "Single register add / sub / compare, ns per operation (latency: dependent chain; throughput: independent over a pool):\n";
+			msg += std::format("\tadd      latency: add_u {:>7.2f}, add_uZ {:>7.2f};  throughput: add_u {:>7.2f}, add_uZ {:>7.2f}, add_u_n {:>7.2f}\n",
+				Time([&](int) { add_u(x, x, y); }, 1), Time([&](int) { add_uZ(x, x, y); }, 1),
+				Time([&](int i) { const u64 k = u64(i) % count; add_u(out + k * 8, lh + k * 8, rh + k * 8); }, 1),
+				Time([&](int i) { const u64 k = u64(i) % count; add_uZ(out + k * 8, lh + k * 8, rh + k * 8); }, 1),
+				Time([&](int i) { if (i < passes) add_u_n(out, lh, rh, count); }, 1) * double(timing_count) / double(passes * count));
+			msg += std::format("\tsub      latency: sub_u {:>7.2f}, sub_uZ {:>7.2f};  throughput: sub_u {:>7.2f}, sub_uZ {:>7.2f}, sub_u_n {:>7.2f}\n",
+				Time([&](int) { sub_u(x, x, y); }, 1), Time([&](int) { sub_uZ(x, x, y); }, 1),
+				Time([&](int i) { const u64 k = u64(i) % count; sub_u(out + k * 8, lh + k * 8, rh + k * 8); }, 1),
+				Time([&](int i) { const u64 k = u64(i) % count; sub_uZ(out + k * 8, lh + k * 8, rh + k * 8); }, 1),
+				Time([&](int i) { if (i < passes) sub_u_n(out, lh, rh, count); }, 1) * double(timing_count) / double(passes * count));
+			volatile s16 sink = 0;
+			msg += std::format("\tcompare  throughput: compare_u {:>7.2f}, compare_uZ {:>7.2f}, compare_u_n {:>7.2f}\n",
+				Time([&](int i) { const u64 k = u64(i) % count; sink = compare_u(lh + k * 8, rh + k * 8); }, 1),
+				Time([&](int i) { const u64 k = u64(i) % count; sink = compare_uZ(lh + k * 8, rh + k * 8); }, 1),
+				Time([&](int i) { if (i < passes) compare_u_n(cmps.data(), lh, rh, count); }, 1) * double(timing_count) / double(passes * count));
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested add_uZ, sub_uZ, compare_uZ and their batch forms against add_u, sub_u, compare_u, in place, and volatile register integrity via assert; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_29_sweep)
+		{
+			// Working set sweep, L1 to DRAM (see ui512sweep.h): copy_u, add_u, mult_u, div_u over sequential, strided and random orders
+			// The set stops at 256 MB here so the test stays short; set max_bytes up to 64ull << 30 to run out to 64 GB (capped at half of free memory).
+			// Checks the sweep covers every size, routine and order, in order, with a time for each.
+			// Note: the timings are informational only
+
+			using namespace ui512sweep;
+			WorkingSetSweep sweep;
+			sweep.max_bytes = 256ull << 20;
+			sweep.min_calls = 1ull << 18;
+			const u64 added = sweep.Run();
+			u64 sizes = 0;
+			for (u64 bytes = sweep.min_bytes; bytes <= sweep.max_bytes; bytes *= 2)
+			{
+				sizes++;
+			};
+			Assert::IsTrue(added > 0 && added % (op_count * order_count) == 0, L"Sweep point count failed.");
+			Assert::IsTrue(added <= sizes * op_count * order_count, L"Sweep ran past max_bytes.");
+			for (u64 i = 0; i < added; i++)
+			{
+				const SweepPoint& p = sweep.points[i];
+				Assert::AreEqual(sweep.min_bytes << (i / (op_count * order_count)), p.bytes, _MSGW(L"Sweep size failed at point #" << i));
+				Assert::AreEqual(int(i % op_count), int(p.op), _MSGW(L"Sweep routine failed at point #" << i));
+				Assert::AreEqual(int((i / op_count) % order_count), int(p.order), _MSGW(L"Sweep order failed at point #" << i));
+				Assert::IsTrue(p.ns_per_op > 0.0 && p.gb_per_s > 0.0, _MSGW(L"Sweep timing failed at point #" << i));
+			};
+			Logger::WriteMessage(sweep.Report().c_str());
+			Logger::WriteMessage(L"Passed. Swept copy_u, add_u, mult_u and div_u over each working set size and order; timings are informational.\n\n");
+		};
+
+		TEST_METHOD(ui512md_30_batch)
+		{
+			// Deferred batch builder (see ui512batch.h): scattered add, sub, compare, mult and div calls, gathered and flushed in batches
+			// Results and returns against direct calls; flush on full, on deadline, and on await; co_await resumed by the flush.
+			// Then times scattered direct calls against calls through the context, with the context's wait metrics.
+			// Note: the timings are informational only
+
+			using namespace ui512batch;
+			u64 seed = 0;
+			const int count = test_run_count;
+			std::vector<u64> storage(9 * count * 8 + 8, 0);
+			u64* lh = (u64*)((uintptr_t(storage.data()) + 63) & ~uintptr_t(63));
+			u64* rh = lh + count * 8;
+			u64* sums = rh + count * 8;
+			u64* diffs = sums + count * 8;
+			u64* products = diffs + count * 8;
+			u64* overflows = products + count * 8;
+			u64* quotients = overflows + count * 8;
+			u64* remainders = quotients + count * 8;
+			u64* check = remainders + count * 8;
+			for (int i = 0; i < count; i++)
+			{
+				RandomFill(lh + i * 8, &seed);
+				RandomFill(rh + i * 8, &seed);
+				shr_u(rh + i * 8, rh + i * 8, u16(RandomU64(&seed) % 512));
+				rh[i * 8 + 7] |= 1;
+				if (i % 7 == 0)
+				{
+					copy_u(rh + i * 8, lh + i * 8);
+				};
+			};
+
+			// Interleaved kinds; only full flushes until the final Flush
+			std::vector<BatchRequest> reqs(5 * count);
+			{
+				BatchContext ctx;
+				ctx.max_batch = 16;
+				ctx.max_wait_us = u64_Max;
+				for (int i = 0; i < count; i++)
+				{
+					ctx.Add(reqs[i * 5], sums + i * 8, lh + i * 8, rh + i * 8);
+					ctx.Sub(reqs[i * 5 + 1], diffs + i * 8, lh + i * 8, rh + i * 8);
+					ctx.Compare(reqs[i * 5 + 2], lh + i * 8, rh + i * 8);
+					ctx.Mult(reqs[i * 5 + 3], products + i * 8, overflows + i * 8, lh + i * 8, rh + i * 8);
+					ctx.Div(reqs[i * 5 + 4], quotients + i * 8, remainders + i * 8, lh + i * 8, rh + i * 8);
+				};
+				for (int op = 0; op < op_count; op++)
+				{
+					Assert::AreEqual(u64(count % 16), ctx.Pending(batch_op(op)), _MSGW(L"Pending " << batch_op_names[op] << " failed."));
+				};
+				Assert::AreEqual(u64(5 * (count % 16)), ctx.Flush(), L"Final flush count failed.");
+				for (int op = 0; op < op_count; op++)
+				{
+					Assert::AreEqual(u64(count), ctx.stats[op].requests, _MSGW(L"Requests " << batch_op_names[op] << " failed."));
+					Assert::AreEqual(u64(count / 16), ctx.stats[op].flushes[flush_full], _MSGW(L"Full flushes " << batch_op_names[op] << " failed."));
+					Assert::AreEqual(u64(0), ctx.stats[op].flushes[flush_deadline], _MSGW(L"Deadline flushes " << batch_op_names[op] << " failed."));
+				};
+			};
+			_UI512(out1) { 0 };
+			_UI512(out2) { 0 };
+			for (int i = 0; i < count; i++)
+			{
+				const u64* a = lh + i * 8;
+				const u64* b = rh + i * 8;
+				for (int r = 0; r < 5; r++)
+				{
+					Assert::IsTrue(reqs[i * 5 + r].done, _MSGW(L"Request not done: " << batch_op_names[r] << " #" << i));
+				};
+				Assert::AreEqual(add_u(check, a, b), reqs[i * 5].ret, _MSGW(L"Carry failed on #" << i));
+				Assert::AreEqual(s16(0), compare_u(check, sums + i * 8), _MSGW(L"Sum failed on #" << i));
+				Assert::AreEqual(sub_u(check, a, b), reqs[i * 5 + 1].ret, _MSGW(L"Borrow failed on #" << i));
+				Assert::AreEqual(s16(0), compare_u(check, diffs + i * 8), _MSGW(L"Difference failed on #" << i));
+				Assert::AreEqual(compare_u(a, b), reqs[i * 5 + 2].ret, _MSGW(L"Compare failed on #" << i));
+				Assert::AreEqual(mult_u(out1, out2, a, b), reqs[i * 5 + 3].ret, _MSGW(L"Multiply return failed on #" << i));
+				Assert::AreEqual(s16(0), compare_u(out1, products + i * 8), _MSGW(L"Product failed on #" << i));
+				Assert::AreEqual(s16(0), compare_u(out2, overflows + i * 8), _MSGW(L"Overflow failed on #" << i));
+				Assert::AreEqual(div_u(out1, out2, a, b), reqs[i * 5 + 4].ret, _MSGW(L"Divide return failed on #" << i));
+				Assert::AreEqual(s16(0), compare_u(out1, quotients + i * 8), _MSGW(L"Quotient failed on #" << i));
+				Assert::AreEqual(s16(0), compare_u(out2, remainders + i * 8), _MSGW(L"Remainder failed on #" << i));
+			};
+
+			// Await forces a flush; a zero deadline flushes on the call; outputs may alias inputs
+			{
+				BatchContext ctx;
+				ctx.max_wait_us = u64_Max;
+				BatchRequest req;
+				copy_u(out1, lh);
+				ctx.Mult(req, out1, out2, out1, rh);
+				Assert::IsFalse(req.done, L"Multiply completed early.");
+				Assert::AreEqual(mult_u(check, products, lh, rh), ctx.Await(req), L"Await return failed.");
+				Assert::IsTrue(req.done, L"Await did not complete the request.");
+				Assert::AreEqual(s16(0), compare_u(check, out1), L"Aliased product failed.");
+				Assert::AreEqual(u64(1), ctx.stats[op_mult_u].flushes[flush_forced], L"Forced flush count failed.");
+				ctx.max_wait_us = 0;
+				ctx.Add(req, out1, lh, rh);
+				Assert::IsTrue(req.done, L"Zero deadline did not flush.");
+				Assert::AreEqual(u64(1), ctx.stats[op_add_u].flushes[flush_deadline], L"Deadline flush count failed.");
+			};
+
+			// co_await: the task suspends on its first pending request and is resumed by the flush
+			{
+				BatchContext ctx;
+				ctx.max_wait_us = u64_Max;
+				BatchRequest first;
+				BatchRequest second;
+				s16 seen = 99;
+				int stage = 0;
+				auto task = [&]() -> BatchTask
+					{
+						stage = 1;
+						ctx.Compare(first, lh, rh);
+						ctx.Compare(second, rh, lh);
+						const s16 c1 = co_await ctx.Async(first);
+						const s16 c2 = co_await ctx.Async(second);
+						seen = s16(c1 - c2);
+						stage = 2;
+					};
+				task();
+				Assert::AreEqual(1, stage, L"Task did not suspend on a pending request.");
+				ctx.Poll();
+				Assert::AreEqual(1, stage, L"Poll flushed before the deadline.");
+				ctx.Flush();
+				Assert::AreEqual(2, stage, L"Flush did not resume the task.");
+				Assert::AreEqual(s16(compare_u(lh, rh) - compare_u(rh, lh)), seen, L"Awaited results failed.");
+			};
+
+			// benchmark: scattered direct calls against the context
+			const int repeat = 20;
+			auto Time = [&](auto&& body)
+				{
+					auto start = std::chrono::steady_clock::now();
+					for (int r = 0; r < repeat; r++)
+					{
+						body();
+					};
+					std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+					return d.count() / (double(count) * double(repeat));
+				};
+			BatchContext ctx;
+			string msg = std::format("Batch builder, ns per call over {} scattered calls, max_batch {}:\n", count, ctx.max_batch);
+			msg += std::format("\tadd_u  direct {:>8.2f}, batched {:>8.2f}\n",
+				Time([&]() { for (int i = 0; i < count; i++) add_u(sums + i * 8, lh + i * 8, rh + i * 8); }),
+				Time([&]() { for (int i = 0; i < count; i++) ctx.Add(reqs[i], sums + i * 8, lh + i * 8, rh + i * 8); ctx.Flush(); }));
+			msg += std::format("\tmult_u direct {:>8.2f}, batched {:>8.2f}\n",
+				Time([&]() { for (int i = 0; i < count; i++) mult_u(products + i * 8, overflows + i * 8, lh + i * 8, rh + i * 8); }),
+				Time([&]() { for (int i = 0; i < count; i++) ctx.Mult(reqs[i], products + i * 8, overflows + i * 8, lh + i * 8, rh + i * 8); ctx.Flush(); }));
+			for (int op : { int(op_add_u), int(op_mult_u) })
+			{
+				const BatchStats& s = ctx.stats[op];
+				msg += std::format("\t{:<7}flushes {} (full {}, deadline {}, forced {}), mean batch {:.1f}, wait ns mean {:.0f} max {:.0f}\n",
+					batch_op_names[op], s.Flushes(), s.flushes[flush_full], s.flushes[flush_deadline], s.flushes[flush_forced], s.MeanBatch(), s.MeanWait(), s.wait_ns_max);
+			};
+			Logger::WriteMessage(msg.c_str());
+			Logger::WriteMessage(L"Passed. Tested batched add, sub, compare, mult and div against direct calls, flush on full, deadline and await, and co_await resumption via assert; timings are informational.\n\n");
+		};
 	};
 };
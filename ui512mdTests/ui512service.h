@@ -0,0 +1,324 @@
+#pragma once
+
+#ifndef ui512service_h
+#define ui512service_h
+
+//		ui512service.h
+//
+//		File:			ui512service.h
+//		Author:			John G.Lynch
+//		Legal:			Copyright @2024, per MIT License below
+//		Date:			October 18, 2026
+//
+//		Local modmul / modexp service over a named shared memory ring (no sockets).
+//		Clients in any process on the host open the ring by name, take a slot by ticket (ticket mod capacity), fill in the request,
+//		and wait on the slot; the result is written back into the same slot. The service collects ready slots from all clients into
+//		one batch, groups the batch by modulus, and runs each group on one Montgomery context from the context cache (ui512ctxcache.h),
+//		so a context (mont_setup_u, a division and several multiplies) is set up once per modulus rather than once per client call.
+//		Knobs: max_batch (larger batches, more throughput) and max_wait_us (how long a partial batch may wait to fill; less is lower latency).
+//		On Stop the service finishes the batch in hand, then completes every slot still waiting with status_shutdown; a client that
+//		finds the ring stopped (before, or while, it waits) withdraws its request and returns status_shutdown, so no caller is left blocked.
+
+#include "CommonTypeDefs.h"
+#include "ui512a.h"
+#include "ui512md.h"
+#include "ui512ctxcache.h"
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <immintrin.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace ui512service
+{
+	enum service_op : u32 { op_modmul = 1, op_modexp };
+	enum slot_state : u32 { slot_free = 0, slot_claimed, slot_ready, slot_taken, slot_done };
+	enum slot_status : s32 { status_ok = 0, status_bad_modulus = -1, status_shutdown = -2 };
+
+	// One request: a * b mod N (op_modmul) or a ^ b mod N (op_modexp), result in place
+	struct ALIGN64 Slot
+	{
+		std::atomic<u32> state;
+		u32 op;
+		s32 status;												// slot_status: 0, -1 for a bad modulus (even, zero, or one), -2 for shutdown
+		u32 reserved[13];
+		u64 modulus[8];
+		u64 a[8];
+		u64 b[8];												// multiplier, or exponent
+		u64 result[8];
+	};
+	static_assert(sizeof(Slot) == 5 * 64, "Slot layout");
+
+	struct ALIGN64 RingHeader
+	{
+		u64 magic;
+		u64 capacity;
+		std::atomic<u64> next_ticket;
+		std::atomic<u32> stop;
+		u32 reserved[9];
+	};
+	static_assert(sizeof(RingHeader) == 64, "RingHeader layout");
+
+	inline const u64 ring_magic = 0x75693531327372ull;		// "ui512sr"
+
+	inline u64 RingBytes(u64 capacity)
+	{
+		return sizeof(RingHeader) + capacity * sizeof(Slot);
+	};
+
+	class Service
+	{
+	public:
+		u64 max_batch = 64;
+		u64 max_wait_us = 20;
+		u64 batches = 0;
+		u64 requests = 0;
+		ui512ctxcache::ContextCache contexts{ 256 };
+
+		// Create the named ring. Returns false if it cannot be created, or already exists
+		bool Create(const char* name, u64 capacity)
+		{
+			const u64 bytes = RingBytes(capacity);
+			mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, DWORD(bytes >> 32), DWORD(bytes), name);
+			if (mapping == nullptr || GetLastError() == ERROR_ALREADY_EXISTS)
+			{
+				return false;
+			};
+			void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, SIZE_T(bytes));
+			if (view == nullptr)
+			{
+				return false;
+			};
+			ring = new (view) RingHeader{};
+			slots = (Slot*)(ring + 1);
+			for (u64 i = 0; i < capacity; i++)
+			{
+				new (&slots[i]) Slot{};
+			};
+			ring->capacity = capacity;
+			ring->magic = ring_magic;
+			return true;
+		};
+
+		// Run returns once the slots in hand are done, and the waiting ones are completed with status_shutdown
+		void Stop()
+		{
+			ring->stop.store(1, std::memory_order_release);
+		};
+
+		// Serve until Stop
+		void Run()
+		{
+			std::vector<Slot*> batch;
+			u64 cursor = 0;
+			const u64 capacity = ring->capacity;
+			auto first = std::chrono::steady_clock::now();
+			while (ring->stop.load(std::memory_order_acquire) == 0)
+			{
+				for (u64 k = 0; k < capacity && batch.size() < max_batch; k++)
+				{
+					Slot& s = slots[(cursor + k) % capacity];
+					u32 expected = slot_ready;
+					if (s.state.load(std::memory_order_relaxed) == slot_ready
+						&& s.state.compare_exchange_strong(expected, slot_taken, std::memory_order_acquire))
+					{
+						if (batch.empty())
+						{
+							first = std::chrono::steady_clock::now();
+						};
+						batch.push_back(&s);
+						cursor = (cursor + k + 1) % capacity;
+					};
+				};
+				if (batch.empty())
+				{
+					_mm_pause();
+					continue;
+				};
+				const u64 waited = u64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - first).count());
+				if (batch.size() >= max_batch || waited >= max_wait_us)
+				{
+					Execute(batch);
+					batch.clear();
+				};
+			};
+			if (!batch.empty())
+			{
+				Execute(batch);
+			};
+			for (u64 k = 0; k < capacity; k++)
+			{
+				Slot& s = slots[k];
+				u32 expected = slot_ready;
+				if (s.state.compare_exchange_strong(expected, slot_taken, std::memory_order_acquire))
+				{
+					s.status = status_shutdown;
+					s.state.store(slot_done, std::memory_order_release);
+				};
+			};
+		};
+
+		~Service()
+		{
+			if (ring != nullptr)
+			{
+				UnmapViewOfFile(ring);
+			};
+			if (mapping != nullptr)
+			{
+				CloseHandle(mapping);
+			};
+		};
+
+	private:
+		HANDLE mapping = nullptr;
+		RingHeader* ring = nullptr;
+		Slot* slots = nullptr;
+
+		void Execute(std::vector<Slot*>& batch)
+		{
+			std::stable_sort(batch.begin(), batch.end(), [](const Slot* l, const Slot* r) { return memcmp(l->modulus, r->modulus, 64) < 0; });
+			_UI512(lh) { 0 };
+			_UI512(rh) { 0 };
+			_UI512(work) { 0 };
+			_UI512(quotient) { 0 };
+			_MONTCTX(ctx);
+			s16 ret = 0;
+			for (size_t i = 0; i < batch.size(); i++)
+			{
+				Slot& s = *batch[i];
+				if (i == 0 || memcmp(batch[i - 1]->modulus, s.modulus, 64) != 0)
+				{
+					ret = contexts.Get(ctx, s.modulus);
+				};
+				s.status = ret;
+				if (ret == 0)
+				{
+					copy_u(lh, s.a);
+					if (compare_u(lh, s.modulus) >= 0)
+					{
+						div_u(quotient, lh, s.a, s.modulus);
+					};
+					mont_to_u(work, lh, ctx);
+					if (s.op == op_modexp)
+					{
+						mont_pow_u(rh, work, s.b, ctx);
+						mont_from_u(s.result, rh, ctx);
+					}
+					else
+					{
+						copy_u(rh, s.b);
+						if (compare_u(rh, s.modulus) >= 0)
+						{
+							div_u(quotient, rh, s.b, s.modulus);
+						};
+						mont_mul_u(s.result, work, rh, ctx);	// (a R) b R^-1 = a b
+					};
+				};
+				s.state.store(slot_done, std::memory_order_release);
+			};
+			batches++;
+			requests += batch.size();
+		};
+	};
+
+	class Client
+	{
+	public:
+		bool Open(const char* name)
+		{
+			mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+			if (mapping == nullptr)
+			{
+				return false;
+			};
+			ring = (RingHeader*)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+			if (ring == nullptr || ring->magic != ring_magic)
+			{
+				return false;
+			};
+			slots = (Slot*)(ring + 1);
+			return true;
+		};
+
+		// Blocking call. Returns the slot status: 0, -1 for a bad modulus, or -2 if the service has stopped; result is written only for 0
+		s32 Call(service_op op, const u64* modulus, const u64* a, const u64* b, u64* result)
+		{
+			const u64 ticket = ring->next_ticket.fetch_add(1, std::memory_order_relaxed);
+			Slot& s = slots[ticket % ring->capacity];
+			u32 expected = slot_free;
+			while (!s.state.compare_exchange_weak(expected, slot_claimed, std::memory_order_acquire))
+			{
+				if (Stopped())
+				{
+					return status_shutdown;
+				};
+				expected = slot_free;
+				_mm_pause();
+			};
+			s.op = op;
+			memcpy(s.modulus, modulus, 64);
+			memcpy(s.a, a, 64);
+			memcpy(s.b, b, 64);
+			s.state.store(slot_ready, std::memory_order_release);
+			for (u64 spins = 0; s.state.load(std::memory_order_acquire) != slot_done; spins++)
+			{
+				u32 ready = slot_ready;
+				if (Stopped() && s.state.compare_exchange_strong(ready, slot_free, std::memory_order_acquire))
+				{
+					return status_shutdown;								// withdrawn before the service took it
+				};
+				if (spins < 4096)
+				{
+					_mm_pause();
+				}
+				else
+				{
+					SwitchToThread();
+				};
+			};
+			const s32 status = s.status;
+			if (status == status_ok)
+			{
+				memcpy(result, s.result, 64);
+			};
+			s.state.store(slot_free, std::memory_order_release);
+			return status;
+		};
+
+		~Client()
+		{
+			if (ring != nullptr)
+			{
+				UnmapViewOfFile(ring);
+			};
+			if (mapping != nullptr)
+			{
+				CloseHandle(mapping);
+			};
+		};
+
+	private:
+		HANDLE mapping = nullptr;
+		RingHeader* ring = nullptr;
+		Slot* slots = nullptr;
+
+		bool Stopped() const
+		{
+			return ring->stop.load(std::memory_order_acquire) != 0;
+		};
+	};
+}
+
+#endif
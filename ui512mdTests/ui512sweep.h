@@ -0,0 +1,288 @@
+#pragma once
+
+#ifndef ui512sweep_h
+#define ui512sweep_h
+
+//		ui512sweep.h
+//
+//		File:			ui512sweep.h
+//		Author:			John G.Lynch
+//		Legal:			Copyright @2024, per MIT License below
+//		Date:			October 19, 2026
+//
+//		Working set sweep: times copy_u, add_u, mult_u and div_u over operand arrays from L1 sized to DRAM sized,
+//		so the cache level cliffs show in the per call times. The working set doubles from min_bytes to max_bytes
+//		(capped at half the free physical memory). It is split into four arrays of 512 bit values (two inputs, two outputs),
+//		visited in one of three orders: sequential, strided (stride values apart, then the next offset), or random (a shuffled permutation).
+//		Every order goes through the same u32 index array, so the index stream costs the same in each.
+//		Reports ns per call, and GB/s of operand bytes touched (index bytes are not counted).
+
+#include "CommonTypeDefs.h"
+#include "ui512a.h"
+#include "ui512md.h"
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace ui512sweep
+{
+	enum sweep_op : u8 { op_copy_u = 0, op_add_u, op_mult_u, op_div_u, op_count };
+	inline const char* sweep_op_names[op_count] = { "copy_u", "add_u", "mult_u", "div_u" };
+	inline const u64 sweep_op_bytes[op_count] = { 128, 192, 256, 256 };		// operand bytes read and written per call
+
+	enum sweep_order : u8 { order_sequential = 0, order_strided, order_random, order_count };
+	inline const char* sweep_order_names[order_count] = { "sequential", "strided", "random" };
+
+	struct SweepPoint
+	{
+		u64 bytes;													// working set
+		sweep_op op;
+		sweep_order order;
+		double ns_per_op;
+		double gb_per_s;
+	};
+
+	inline u64 SplitMix(u64* state)
+	{
+		u64 z = (*state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	};
+
+	// Largest working set worth trying: half the free physical memory, or zero if it cannot be read
+	inline u64 MemoryCap()
+	{
+		MEMORYSTATUSEX status{};
+		status.dwLength = sizeof(status);
+		return GlobalMemoryStatusEx(&status) ? u64(status.ullAvailPhys / 2) : 0;
+	};
+
+	class WorkingSetSweep
+	{
+	public:
+		u64 min_bytes = 4ull << 10;									// 4 KB
+		u64 max_bytes = 64ull << 30;								// 64 GB, before the memory cap
+		u64 stride = 64;											// in values: 4 KB apart within each array
+		u64 min_calls = 1ull << 20;									// small sets are repeated to at least this many calls
+		u64 seed = 0;
+		std::vector<SweepPoint> points;
+
+		// Sweep every routine in every order. Returns the number of points added
+		u64 Run()
+		{
+			const u64 cap = MemoryCap();
+			const u64 top = (cap == 0) ? max_bytes : std::min(max_bytes, cap);
+			const u64 before = points.size();
+			for (u64 bytes = min_bytes; bytes <= top && bytes >= min_bytes; bytes *= 2)
+			{
+				if (!Allocate(bytes))
+				{
+					break;
+				};
+				for (int order = 0; order < order_count; order++)
+				{
+					Order(sweep_order(order));
+					for (int op = 0; op < op_count; op++)
+					{
+						const double ns = Time(sweep_op(op));
+						points.push_back({ bytes, sweep_op(op), sweep_order(order), ns, (ns == 0.0) ? 0.0 : double(sweep_op_bytes[op]) / ns });
+					};
+				};
+				Release();
+			};
+			return points.size() - before;
+		};
+
+		// One table per routine: working set, then ns per call and GB/s for each order
+		std::string Report() const
+		{
+			std::string msg;
+			for (int op = 0; op < op_count; op++)
+			{
+				msg += std::format("{}, ns per call / GB/s:\n\t{:>10}", sweep_op_names[op], "set");
+				for (int order = 0; order < order_count; order++)
+				{
+					msg += std::format("{:>22}", sweep_order_names[order]);
+				};
+				msg += "\n";
+				u64 last = 0;
+				for (const SweepPoint& p : points)
+				{
+					if (p.op != op || p.bytes == last)
+					{
+						continue;
+					};
+					last = p.bytes;
+					msg += std::format("\t{:>10}", Size(p.bytes));
+					for (const SweepPoint& q : points)
+					{
+						if (q.op == op && q.bytes == p.bytes)
+						{
+							msg += std::format("{:>12.2f}{:>10.2f}", q.ns_per_op, q.gb_per_s);
+						};
+					};
+					msg += "\n";
+				};
+			};
+			return msg;
+		};
+
+		~WorkingSetSweep()
+		{
+			Release();
+		};
+
+	private:
+		u64* arena = nullptr;
+		u64 values = 0;												// per array
+		u64* lh = nullptr;
+		u64* rh = nullptr;
+		u64* out1 = nullptr;
+		u64* out2 = nullptr;
+		std::vector<u32> index;
+
+		static std::string Size(u64 bytes)
+		{
+			return (bytes >= (1ull << 30)) ? std::format("{} GB", bytes >> 30)
+				: (bytes >= (1ull << 20)) ? std::format("{} MB", bytes >> 20) : std::format("{} KB", bytes >> 10);
+		};
+
+		// Four arrays of bytes / 256 values each, page aligned; inputs random, divisors non-zero, every page touched
+		bool Allocate(u64 bytes)
+		{
+			values = bytes / 256;
+			if (values == 0 || values > u64(u32_Max))
+			{
+				return false;
+			};
+			arena = (u64*)VirtualAlloc(nullptr, SIZE_T(bytes), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+			if (arena == nullptr)
+			{
+				return false;
+			};
+			lh = arena;
+			rh = lh + values * 8;
+			out1 = rh + values * 8;
+			out2 = out1 + values * 8;
+			for (u64 i = 0; i < values * 8; i++)
+			{
+				lh[i] = SplitMix(&seed);
+				rh[i] = SplitMix(&seed);
+				out1[i] = 0;
+				out2[i] = 0;
+			};
+			for (u64 i = 0; i < values; i++)
+			{
+				rh[i * 8 + 7] |= 1;
+			};
+			index.resize(values);
+			return true;
+		};
+
+		void Release()
+		{
+			if (arena != nullptr)
+			{
+				VirtualFree(arena, 0, MEM_RELEASE);
+				arena = nullptr;
+			};
+			index.clear();
+			index.shrink_to_fit();
+		};
+
+		void Order(sweep_order order)
+		{
+			u64 at = 0;
+			switch (order)
+			{
+			case order_sequential:
+				for (u64 i = 0; i < values; i++)
+				{
+					index[i] = u32(i);
+				};
+				break;
+			case order_strided:
+				for (u64 start = 0; start < stride && start < values; start++)
+				{
+					for (u64 i = start; i < values; i += stride)
+					{
+						index[at++] = u32(i);
+					};
+				};
+				break;
+			case order_random:
+				for (u64 i = 0; i < values; i++)
+				{
+					index[i] = u32(i);
+				};
+				for (u64 i = values - 1; i > 0; i--)
+				{
+					std::swap(index[i], index[SplitMix(&seed) % (i + 1)]);
+				};
+				break;
+			default:
+				break;
+			};
+		};
+
+		// ns per call, over enough passes of the index for min_calls calls
+		double Time(sweep_op op)
+		{
+			const u64 passes = std::max(u64(1), min_calls / values);
+			const u32* ix = index.data();
+			auto start = std::chrono::steady_clock::now();
+			for (u64 p = 0; p < passes; p++)
+			{
+				switch (op)
+				{
+				case op_copy_u:
+					for (u64 i = 0; i < values; i++)
+					{
+						const u64 k = u64(ix[i]) * 8;
+						copy_u(out1 + k, lh + k);
+					};
+					break;
+				case op_add_u:
+					for (u64 i = 0; i < values; i++)
+					{
+						const u64 k = u64(ix[i]) * 8;
+						add_u(out1 + k, lh + k, rh + k);
+					};
+					break;
+				case op_mult_u:
+					for (u64 i = 0; i < values; i++)
+					{
+						const u64 k = u64(ix[i]) * 8;
+						mult_u(out1 + k, out2 + k, lh + k, rh + k);
+					};
+					break;
+				case op_div_u:
+					for (u64 i = 0; i < values; i++)
+					{
+						const u64 k = u64(ix[i]) * 8;
+						div_u(out1 + k, out2 + k, lh + k, rh + k);
+					};
+					break;
+				default:
+					break;
+				};
+			};
+			std::chrono::duration<double, std::nano> dur = std::chrono::steady_clock::now() - start;
+			return dur.count() / (double(values) * double(passes));
+		};
+	};
+}
+
+#endif
@@ -0,0 +1,236 @@
+#pragma once
+
+#ifndef ui512trace_h
+#define ui512trace_h
+
+//		ui512trace.h
+//
+//		File:			ui512trace.h
+//		Author:			John G.Lynch
+//		Legal:			Copyright @2024, per MIT License below
+//		Date:			October 18, 2026
+//
+//		Operand trace capture and replay.
+//		Capture: call the routines through the ui512trace:: wrappers. With a TraceWriter set active, every n-th call
+//		records the routine and its operands (packed by pack_u_n, so short values take a few bytes). With none active,
+//		the wrappers cost one test of a null pointer.
+//		Replay: TraceReplay decodes a trace into per-routine operand pools, then times each routine over its pool
+//		through a table of entry points, so the same trace can be run against any build or variant.
+
+#include "CommonTypeDefs.h"
+#include "ui512a.h"
+#include "ui512md.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace ui512trace
+{
+	// Routine codes, one byte per trace record
+	enum trace_op : u8 { op_mult_u = 1, op_mult_uT64, op_div_u, op_div_uT64, op_add_u, op_sub_u, op_count };
+	inline const char* trace_op_names[op_count] = { "", "mult_u", "mult_uT64", "div_u", "div_uT64", "add_u", "sub_u" };
+
+	// Record: routine code, then its two inputs in pack_u_n form (a 64 bit operand is recorded as a 512 bit value)
+	class TraceWriter
+	{
+	public:
+		std::vector<u8> bytes;
+		u64 sample_every = 1;
+		u64 calls = 0;
+		u64 records = 0;
+
+		explicit TraceWriter(u64 every = 1) : sample_every(every == 0 ? 1 : every) {};
+
+		void Sample(trace_op op, const u64* lh, const u64* rh)
+		{
+			if (calls++ % sample_every != 0)
+			{
+				return;
+			};
+			ALIGN64 u64 operands[16];
+			for (int j = 0; j < 8; j++)
+			{
+				operands[j] = lh[j];
+				operands[8 + j] = rh[j];
+			};
+			const size_t at = bytes.size();
+			bytes.resize(at + 1 + 2 * 65);
+			bytes[at] = u8(op);
+			const u64 packed = pack_u_n(bytes.data() + at + 1, operands, 2, nullptr, 0);
+			bytes.resize(at + 1 + packed);
+			records++;
+		};
+
+		void Sample(trace_op op, const u64* lh, u64 rh)
+		{
+			ALIGN64 u64 wide[8] = { 0 };
+			wide[7] = rh;
+			Sample(op, lh, wide);
+		};
+
+		bool Save(const char* path) const
+		{
+			FILE* f = nullptr;
+			if (fopen_s(&f, path, "wb") != 0 || f == nullptr)
+			{
+				return false;
+			};
+			const bool ok = fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+			fclose(f);
+			return ok;
+		};
+
+		static bool Load(const char* path, std::vector<u8>& into)
+		{
+			FILE* f = nullptr;
+			if (fopen_s(&f, path, "rb") != 0 || f == nullptr)
+			{
+				return false;
+			};
+			u8 chunk[4096];
+			size_t n = 0;
+			into.clear();
+			while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+			{
+				into.insert(into.end(), chunk, chunk + n);
+			};
+			fclose(f);
+			return true;
+		};
+	};
+
+	inline TraceWriter* active = nullptr;
+
+	// Capture wrappers: same signatures as the routines they forward to
+	inline s16 mult_u(u64* product, u64* overflow, const u64* multiplicand, const u64* multiplier)
+	{
+		if (active != nullptr) active->Sample(op_mult_u, multiplicand, multiplier);
+		return ::mult_u(product, overflow, multiplicand, multiplier);
+	};
+
+	inline s16 mult_uT64(u64* product, u64* overflow, const u64* multiplicand, u64 multiplier)
+	{
+		if (active != nullptr) active->Sample(op_mult_uT64, multiplicand, multiplier);
+		return ::mult_uT64(product, overflow, multiplicand, multiplier);
+	};
+
+	inline s16 div_u(u64* quotient, u64* remainder, const u64* dividend, const u64* divisor)
+	{
+		if (active != nullptr) active->Sample(op_div_u, dividend, divisor);
+		return ::div_u(quotient, remainder, dividend, divisor);
+	};
+
+	inline s16 div_uT64(u64* quotient, u64* remainder, const u64* dividend, u64 divisor)
+	{
+		if (active != nullptr) active->Sample(op_div_uT64, dividend, divisor);
+		return ::div_uT64(quotient, remainder, dividend, divisor);
+	};
+
+	inline s16 add_u(u64* sum, const u64* addend1, const u64* addend2)
+	{
+		if (active != nullptr) active->Sample(op_add_u, addend1, addend2);
+		return ::add_u(sum, addend1, addend2);
+	};
+
+	inline s16 sub_u(u64* difference, const u64* left, const u64* right)
+	{
+		if (active != nullptr) active->Sample(op_sub_u, left, right);
+		return ::sub_u(difference, left, right);
+	};
+
+	// Entry points replayed against; defaults are the linked build
+	struct TraceTargets
+	{
+		s16(*mult_u)(const u64*, const u64*, const u64*, const u64*) = ::mult_u;
+		s16(*mult_uT64)(const u64*, const u64*, const u64*, const u64) = ::mult_uT64;
+		s16(*div_u)(const u64*, const u64*, const u64*, const u64*) = ::div_u;
+		s16(*div_uT64)(const u64*, const u64*, const u64*, const u64) = ::div_uT64;
+		s16(*add_u)(const u64*, const u64*, const u64*) = ::add_u;
+		s16(*sub_u)(const u64*, const u64*, const u64*) = ::sub_u;
+	};
+
+	class TraceReplay
+	{
+	public:
+		// Operand pools, by routine: pairs of 512 bit values, 64 byte aligned within storage
+		std::vector<u64> storage[op_count];
+		u64 count[op_count] = { 0 };
+		double nanoseconds[op_count] = { 0.0 };
+
+		const u64* Pool(int op) const
+		{
+			return (const u64*)((uintptr_t(storage[op].data()) + 63) & ~uintptr_t(63));
+		};
+
+		// Decode a trace into pools. Returns false for an unknown routine code, a bad length byte, or a record cut short
+		// (decoding is from a copy padded by two maximal values, so a cut record is caught without reading past the trace)
+		bool Decode(const std::vector<u8>& trace)
+		{
+			std::vector<u64> decoded[op_count];
+			std::vector<u64> scratch(16 + 8);
+			u64* pair = (u64*)((uintptr_t(scratch.data()) + 63) & ~uintptr_t(63));
+			std::vector<u8> padded(trace);
+			padded.resize(trace.size() + 2 * 65, 0);
+			size_t at = 0;
+			while (at < trace.size())
+			{
+				const u8 op = trace[at];
+				if (op == 0 || op >= op_count || at + 1 >= trace.size())
+				{
+					return false;
+				};
+				const s64 used = unpack_u_n(pair, padded.data() + at + 1, 2);
+				if (used < 0 || at + 1 + size_t(used) > trace.size())
+				{
+					return false;
+				};
+				decoded[op].insert(decoded[op].end(), pair, pair + 16);
+				at += 1 + size_t(used);
+			};
+			for (int op = 0; op < op_count; op++)
+			{
+				count[op] = decoded[op].size() / 16;
+				storage[op].assign(decoded[op].size() + 8, 0);
+				std::copy(decoded[op].begin(), decoded[op].end(), (u64*)Pool(op));
+			};
+			return true;
+		};
+
+		// Time each routine over its pool, 'repeat' times. Results in nanoseconds[], per call
+		void Run(const TraceTargets& t, int repeat = 1)
+		{
+			ALIGN64 u64 out1[8];
+			ALIGN64 u64 out2[8];
+			for (int op = 1; op < op_count; op++)
+			{
+				const u64* p = Pool(op);
+				const u64 n = count[op];
+				auto start = std::chrono::steady_clock::now();
+				for (int r = 0; r < repeat; r++)
+				{
+					for (u64 i = 0; i < n; i++)
+					{
+						const u64* lh = p + i * 16;
+						const u64* rh = lh + 8;
+						switch (op)
+						{
+						case op_mult_u: t.mult_u(out1, out2, lh, rh); break;
+						case op_mult_uT64: t.mult_uT64(out1, out2, lh, rh[7]); break;
+						case op_div_u: t.div_u(out1, out2, lh, rh); break;
+						case op_div_uT64: t.div_uT64(out1, out2, lh, rh[7]); break;
+						case op_add_u: t.add_u(out1, lh, rh); break;
+						case op_sub_u: t.sub_u(out1, lh, rh); break;
+						};
+					};
+				};
+				std::chrono::duration<double, std::nano> dur = std::chrono::steady_clock::now() - start;
+				nanoseconds[op] = (n == 0) ? 0.0 : dur.count() / (double(n) * double(repeat));
+			};
+		};
+	};
+}
+
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef ui512variants_h
+#define ui512variants_h
+
+//		ui512variants.h
+//
+//		File:			ui512variants.h
+//		Author:			John G.Lynch
+//		Legal:			Copyright @2024, per MIT License below
+//		Date:			October 18, 2026
+//
+//		Side by side processor option variants of ui512md (see ui512mdVariants.inc): the routines assembled with each of
+//		__UseZ, __UseY, __UseX and __UseQ, under names suffixed _Z, _Y, _X, _Q, all linked into the same program.
+//		Only ui512md routines have variants; add_u, sub_u and the other ui512a / ui512b routines are linked once.
+
+#include "CommonTypeDefs.h"
+#include "ui512md.h"
+#include "ui512trace.h"
+
+#define UI512_VARIANT_PROTOTYPES(v) \
+	s16 mult_u_##v(const u64*, const u64*, const u64*, const u64*); \
+	s16 mult_uT64_##v(const u64*, const u64*, const u64*, const u64); \
+	s16 div_u_##v(const u64*, const u64*, const u64*, const u64*); \
+	s16 div_uT64_##v(const u64*, const u64*, const u64*, const u64); \
+	s16 mont_mul_u_##v(const u64*, const u64*, const u64*, const u64*); \
+	s16 muls_u_##v(const u64*, const u64*, const u64*); \
+	u64 sum_u_n_##v(const u64*, const u64*, const u64); \
+	s64 argmax_u_n_##v(const u64*, const u64); \
+	u64 cmp_u_n_##v(const u64*, const u64*, const u64*, const u64, const u64); \
+	s16 msb_u_n_##v(const s16*, const u64*, const u64); \
+	u64 pack_u_n_##v(const u8*, const u64*, const u64, const u64*, const u64);
+
+extern "C"
+{
+	UI512_VARIANT_PROTOTYPES(Z)
+	UI512_VARIANT_PROTOTYPES(Y)
+	UI512_VARIANT_PROTOTYPES(X)
+	UI512_VARIANT_PROTOTYPES(Q)
+}
+
+namespace ui512variants
+{
+	struct Variant
+	{
+		const char* name;
+		ui512trace::TraceTargets core;								// mult_u, mult_uT64, div_u, div_uT64 (add_u, sub_u are shared)
+		s16(*mont_mul_u)(const u64*, const u64*, const u64*, const u64*);
+		s16(*muls_u)(const u64*, const u64*, const u64*);
+		u64(*sum_u_n)(const u64*, const u64*, const u64);
+		s64(*argmax_u_n)(const u64*, const u64);
+		u64(*cmp_u_n)(const u64*, const u64*, const u64*, const u64, const u64);
+		s16(*msb_u_n)(const s16*, const u64*, const u64);
+		u64(*pack_u_n)(const u8*, const u64*, const u64, const u64*, const u64);
+	};
+
+#define UI512_VARIANT(v) { #v, { mult_u_##v, mult_uT64_##v, div_u_##v, div_uT64_##v }, \
+	mont_mul_u_##v, muls_u_##v, sum_u_n_##v, argmax_u_n_##v, cmp_u_n_##v, msb_u_n_##v, pack_u_n_##v }
+
+	inline const Variant variants[] = { UI512_VARIANT(Z), UI512_VARIANT(Y), UI512_VARIANT(X), UI512_VARIANT(Q) };
+	inline const int variant_count = int(sizeof(variants) / sizeof(variants[0]));
+
+#undef UI512_VARIANT
+}
+
+#endif
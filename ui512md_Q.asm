@@ -0,0 +1,22 @@
+;			ui512md_Q
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;
+;			File:			ui512md_Q.asm
+;			Author:			John G. Lynch
+;			Legal:			Copyright @2024, per MIT License below
+;			Date:			October 18, 2026
+;
+;			ui512md built for no extensions (64 bit registers), routine names suffixed _Q (see ui512mdVariants.inc)
+;
+
+__UseZ			EQU				0
+__UseY			EQU				0
+__UseX			EQU				0
+__UseQ			EQU				1
+__UseBMI2		EQU				0
+__UseADX		EQU				0
+__VariantSuffix	TEXTEQU			<Q>
+
+				INCLUDE			ui512mdVariants.inc
+				INCLUDE			ui512md.asm
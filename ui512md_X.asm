@@ -0,0 +1,20 @@
+;			ui512md_X
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;
+;			File:			ui512md_X.asm
+;			Author:			John G. Lynch
+;			Legal:			Copyright @2024, per MIT License below
+;			Date:			October 18, 2026
+;
+;			ui512md built for SIMD/SSE (128 bit registers), routine names suffixed _X (see ui512mdVariants.inc)
+;
+
+__UseZ			EQU				0
+__UseY			EQU				0
+__UseX			EQU				1
+__UseQ			EQU				0
+__VariantSuffix	TEXTEQU			<X>
+
+				INCLUDE			ui512mdVariants.inc
+				INCLUDE			ui512md.asm
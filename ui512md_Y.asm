@@ -0,0 +1,20 @@
+;			ui512md_Y
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;
+;			File:			ui512md_Y.asm
+;			Author:			John G. Lynch
+;			Legal:			Copyright @2024, per MIT License below
+;			Date:			October 18, 2026
+;
+;			ui512md built for AVX2 (256 bit registers), routine names suffixed _Y (see ui512mdVariants.inc)
+;
+
+__UseZ			EQU				0
+__UseY			EQU				1
+__UseX			EQU				0
+__UseQ			EQU				0
+__VariantSuffix	TEXTEQU			<Y>
+
+				INCLUDE			ui512mdVariants.inc
+				INCLUDE			ui512md.asm
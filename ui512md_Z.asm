@@ -0,0 +1,20 @@
+;			ui512md_Z
+;
+;--------------------------------------------------------------------------------------------------------------------------------------------------------------
+;
+;			File:			ui512md_Z.asm
+;			Author:			John G. Lynch
+;			Legal:			Copyright @2024, per MIT License below
+;			Date:			October 18, 2026
+;
+;			ui512md built for AVX4 (512 bit registers), routine names suffixed _Z (see ui512mdVariants.inc)
+;
+
+__UseZ			EQU				1
+__UseY			EQU				0
+__UseX			EQU				0
+__UseQ			EQU				0
+__VariantSuffix	TEXTEQU			<Z>
+
+				INCLUDE			ui512mdVariants.inc
+				INCLUDE			ui512md.asm